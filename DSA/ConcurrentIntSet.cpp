@@ -0,0 +1,287 @@
+// FILE: ConcurrentIntSet.cpp
+// CLASS IMPLEMENTED: ConcurrentIntSet (see ConcurrentIntSet.h for
+//                    documentation)
+// INVARIANT for the ConcurrentIntSet class:
+//   1. current points at a table of capacity slots (a power of 2, at
+//      least MIN_CAPACITY). A slot is EMPTY (0), or holds a key in its
+//      low 32 bits and LIVE (a member) or DEAD (removed) above them.
+//   2. Within one table a slot never goes back to EMPTY, and a key has
+//      at most one slot, which is on the probe run from its home slot
+//      before the first EMPTY slot. So a search can stop at the first
+//      EMPTY slot or the first slot with its key.
+//   3. A slot holding key k changes only under the lock of k's stripe.
+//      An EMPTY slot is claimed by compare-and-swap, since writers of
+//      other stripes may go for it too.
+//   4. claimed is the number of non-EMPTY slots in *current (plus
+//      claims in progress), and never more than 3/4 of capacity.
+//      stripes[s].members is the number of LIVE keys of stripe s.
+//   5. current is replaced only while every stripe lock is held. The
+//      old table goes to epoch_retire, and readers (contains,
+//      toIntSet) only touch a table while pinned by an epoch_guard.
+
+#include "ConcurrentIntSet.h"
+#include "epoch.h"
+
+using CS3358_FA2023::epoch_guard;
+using CS3358_FA2023::epoch_retire;
+using CS3358_FA2023::epoch_collect;
+
+// Slot states (the bits above the key).
+static const uint64_t EMPTY = 0;
+static const uint64_t LIVE = uint64_t(1) << 32;
+static const uint64_t DEAD = uint64_t(2) << 32;
+
+// Big enough that writers racing past the 3/4 check (at most one per
+// stripe) can never fill the table.
+static const std::size_t MIN_CAPACITY = 4 * ConcurrentIntSet::STRIPES;
+
+static uint64_t make_slot(uint64_t state, int anInt)
+{
+   return state | uint64_t(uint32_t(anInt));
+}
+
+static int slot_key(uint64_t s)
+{
+   return int(uint32_t(s));
+}
+
+static uint64_t slot_state(uint64_t s)
+{
+   return s & ~uint64_t(0xFFFFFFFFu);
+}
+
+// Fibonacci hashing as in IntSet: the folded low bits pick the home
+// slot, the top bits pick the stripe.
+static unsigned hash_of(int anInt)
+{
+   return unsigned(anInt) * 2654435769u;
+}
+
+static std::size_t home_slot(unsigned h, std::size_t capacity)
+{
+   return std::size_t(h ^ (h >> 16)) & (capacity - 1);
+}
+
+static int stripe_of(unsigned h)
+{
+   return int(h >> 26) & (ConcurrentIntSet::STRIPES - 1);
+}
+
+// Smallest table that holds members keys at most half full.
+static std::size_t capacity_for(std::size_t members)
+{
+   std::size_t capacity = MIN_CAPACITY;
+   while (capacity < 2 * members)
+      capacity *= 2;
+   return capacity;
+}
+
+ConcurrentIntSet::table* ConcurrentIntSet::new_table(std::size_t capacity)
+{
+   std::atomic<uint64_t>* slots = new std::atomic<uint64_t>[capacity];
+   table* t;
+   try
+   {
+      t = new table;
+   }
+   catch (...)
+   {
+      delete [] slots;
+      throw;
+   }
+   t->capacity = capacity;
+   t->slots = slots;
+   for (std::size_t i = 0; i < capacity; ++i)
+      t->slots[i].store(EMPTY, std::memory_order_relaxed);
+   return t;
+}
+
+void ConcurrentIntSet::destroy_table(void* t)
+{
+   table* doomed = static_cast<table*>(t);
+   delete [] doomed->slots;
+   delete doomed;
+}
+
+ConcurrentIntSet::ConcurrentIntSet(int expected_members) : claimed(0)
+{
+   for (int s = 0; s < STRIPES; ++s)
+      stripes[s].members.store(0, std::memory_order_relaxed);
+   std::size_t wanted = (expected_members > 0) ? std::size_t(expected_members) : 0;
+   current.store(new_table(capacity_for(wanted)), std::memory_order_release);
+}
+
+ConcurrentIntSet::~ConcurrentIntSet()
+{
+   destroy_table(current.load(std::memory_order_relaxed));
+}
+
+// Lock-free: pin, then probe whichever table is current.
+bool ConcurrentIntSet::contains(int anInt) const
+{
+   epoch_guard pin;
+   const table* t = current.load(std::memory_order_acquire);
+
+   unsigned h = hash_of(anInt);
+   std::size_t mask = t->capacity - 1;
+   for (std::size_t i = home_slot(h, t->capacity); ; i = (i + 1) & mask)
+   {
+      uint64_t s = t->slots[i].load(std::memory_order_acquire);
+      if (s == EMPTY) return false;
+      if (slot_key(s) == anInt) return slot_state(s) == LIVE;
+   }
+}
+
+bool ConcurrentIntSet::add(int anInt)
+{
+   unsigned h = hash_of(anInt);
+   stripe& st = stripes[stripe_of(h)];
+
+   for (;;)
+   {
+      std::unique_lock<std::mutex> hold(st.lock);
+      table* t = current.load(std::memory_order_acquire);
+      std::size_t mask = t->capacity - 1;
+      bool reserved = false;
+      std::size_t i = home_slot(h, t->capacity);
+
+      for (;;)
+      {
+         uint64_t s = t->slots[i].load(std::memory_order_acquire);
+         if (s == EMPTY)
+         {
+            // reserve room for one more slot, or make room first
+            if (!reserved)
+            {
+               if ((claimed.fetch_add(1) + 1) * 4 > t->capacity * 3)
+               {
+                  claimed.fetch_sub(1);
+                  break;
+               }
+               reserved = true;
+            }
+            if (t->slots[i].compare_exchange_strong(s, make_slot(LIVE, anInt),
+                                                    std::memory_order_release,
+                                                    std::memory_order_acquire))
+            {
+               st.members.fetch_add(1, std::memory_order_relaxed);
+               return true;
+            }
+            // another stripe's key got there first; s now holds it
+         }
+         if (slot_key(s) == anInt)
+         {
+            if (reserved) claimed.fetch_sub(1);
+            if (s == make_slot(LIVE, anInt)) return false;
+            t->slots[i].store(make_slot(LIVE, anInt), std::memory_order_release);
+            st.members.fetch_add(1, std::memory_order_relaxed);
+            return true;
+         }
+         i = (i + 1) & mask;
+      }
+
+      hold.unlock();
+      grow(t);
+   }
+}
+
+bool ConcurrentIntSet::remove(int anInt)
+{
+   unsigned h = hash_of(anInt);
+   stripe& st = stripes[stripe_of(h)];
+   std::lock_guard<std::mutex> hold(st.lock);
+
+   table* t = current.load(std::memory_order_acquire);
+   std::size_t mask = t->capacity - 1;
+   for (std::size_t i = home_slot(h, t->capacity); ; i = (i + 1) & mask)
+   {
+      uint64_t s = t->slots[i].load(std::memory_order_acquire);
+      if (s == EMPTY) return false;
+      if (slot_key(s) == anInt)
+      {
+         if (s != make_slot(LIVE, anInt)) return false;
+         t->slots[i].store(make_slot(DEAD, anInt), std::memory_order_release);
+         st.members.fetch_sub(1, std::memory_order_relaxed);
+         return true;
+      }
+   }
+}
+
+int ConcurrentIntSet::size() const
+{
+   int total = 0;
+   for (int s = 0; s < STRIPES; ++s)
+      total += stripes[s].members.load(std::memory_order_relaxed);
+   return total;
+}
+
+bool ConcurrentIntSet::isEmpty() const
+{
+   return size() == 0;
+}
+
+IntSet ConcurrentIntSet::toIntSet() const
+{
+   epoch_guard pin;
+   const table* t = current.load(std::memory_order_acquire);
+
+   IntSet result(size());
+   for (std::size_t i = 0; i < t->capacity; ++i)
+   {
+      uint64_t s = t->slots[i].load(std::memory_order_acquire);
+      if (slot_state(s) == LIVE)
+         result.add(slot_key(s));
+   }
+   return result;
+}
+
+// Stop all writers, rehash the LIVE keys into a fresh table (dropping
+// the DEAD ones), publish it, and retire the old one. Nothing to do if
+// another writer already replaced seen. The stripe locks are held by a
+// guard, so if new_table throws bad_alloc they are all released and
+// the set is left as it was.
+void ConcurrentIntSet::grow(const table* seen)
+{
+   // Every stripe lock, taken in order and released in reverse.
+   struct all_stripes_lock
+   {
+      stripe* held;
+      explicit all_stripes_lock(stripe* stripes) : held(stripes)
+      {
+         for (int s = 0; s < STRIPES; ++s)
+            held[s].lock.lock();
+      }
+      ~all_stripes_lock()
+      {
+         for (int s = STRIPES - 1; s >= 0; --s)
+            held[s].lock.unlock();
+      }
+   };
+
+   table* old;
+   {
+      all_stripes_lock hold(stripes);
+      old = current.load(std::memory_order_relaxed);
+      if (old != seen) return;
+
+      table* fresh = new_table(capacity_for(std::size_t(size()) + 1));
+      std::size_t mask = fresh->capacity - 1;
+      std::size_t live = 0;
+      for (std::size_t i = 0; i < old->capacity; ++i)
+      {
+         uint64_t s = old->slots[i].load(std::memory_order_relaxed);
+         if (slot_state(s) != LIVE) continue;
+
+         std::size_t j = home_slot(hash_of(slot_key(s)), fresh->capacity);
+         while (fresh->slots[j].load(std::memory_order_relaxed) != EMPTY)
+            j = (j + 1) & mask;
+         fresh->slots[j].store(s, std::memory_order_relaxed);
+         ++live;
+      }
+      claimed.store(live);
+      current.store(fresh, std::memory_order_release);
+   }
+
+   epoch_retire(old, &ConcurrentIntSet::destroy_table);
+   epoch_collect();
+}
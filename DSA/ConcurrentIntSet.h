@@ -0,0 +1,120 @@
+// FILE: ConcurrentIntSet.h
+// CLASS PROVIDED: ConcurrentIntSet (a set of ints that many threads may
+//                 read and change at the same time, without an outside
+//                 lock)
+//
+// STORAGE:
+//   An open-addressing hash table of 64-bit slots, each holding a key and
+//   its state (empty, member, or removed), so a slot is read and written
+//   in one atomic step.
+//   - contains() takes no lock. It pins the thread (see epoch.h), loads
+//     the current table and probes it, so it is lock-free and never
+//     waits for a writer.
+//   - add() and remove() lock one of STRIPES mutexes, picked by the
+//     key's hash, so writers of different keys rarely meet. A new key
+//     claims an empty slot with a compare-and-swap (writers in other
+//     stripes may race for the same slot). A removed key leaves its
+//     slot marked removed, and adding it again revives that slot, so a
+//     key has at most one slot in a table.
+//   - When claimed slots would pass 3/4 of the table, one writer locks
+//     every stripe and rehashes the members into a new table (twice the
+//     size, or the same size if mostly removed slots are being cleared
+//     out). It publishes the table with one atomic store and retires
+//     the old one with epoch_retire, so readers still probing the old
+//     table are never left with freed memory.
+//
+//   Unlike IntSet, membership order is NOT kept.
+//
+// CONSTRUCTOR for the ConcurrentIntSet class:
+//   explicit ConcurrentIntSet(int expected_members = 0)
+//     Pre:  (none)
+//     Post: The set is empty, with a table big enough for
+//           expected_members keys without a resize.
+//
+// MODIFICATION MEMBER FUNCTIONS for the ConcurrentIntSet class
+// (safe to call from any number of threads at once):
+//   bool add(int anInt)
+//     Post: If anInt was not a member, it has been added and true has
+//           been returned; otherwise false has been returned.
+//   bool remove(int anInt)
+//     Post: If anInt was a member, it has been removed and true has
+//           been returned; otherwise false has been returned.
+//
+// CONSTANT MEMBER FUNCTIONS for the ConcurrentIntSet class
+// (safe to call from any number of threads at once):
+//   bool contains(int anInt) const
+//     Post: true has been returned if anInt is a member. Every add or
+//           remove that finished before the call began is seen.
+//   int size() const
+//     Post: The number of members has been returned (while writers are
+//           running, it's a number the set had at some recent moment).
+//   bool isEmpty() const
+//     Post: true has been returned if size() is 0.
+//   IntSet toIntSet() const
+//     Post: An IntSet holding the members has been returned. While
+//           writers are running, keys added or removed during the call
+//           may or may not be in it.
+//
+// VALUE SEMANTICS for the ConcurrentIntSet class:
+//   A ConcurrentIntSet can't be copied or assigned (copy it with
+//   toIntSet() instead). The destructor must not run while another
+//   thread is still using the set.
+//
+// DYNAMIC MEMORY USAGE by the ConcurrentIntSet class:
+//   If there is insufficient dynamic memory, the constructor, add and
+//   toIntSet throw bad_alloc. An add that throws leaves the set as it
+//   was, with every writer lock released. An old table is freed once no reader can
+//   still be in it, normally by the next add that needs a resize.
+
+#ifndef CONCURRENT_INT_SET_H
+#define CONCURRENT_INT_SET_H
+
+#include <atomic>    // provides atomic
+#include <cstdlib>   // provides size_t
+#include <mutex>     // provides mutex
+#include <stdint.h>  // provides uint64_t
+#include "IntSet.h"
+
+class ConcurrentIntSet
+{
+public:
+   static const int STRIPES = 64;
+
+   explicit ConcurrentIntSet(int expected_members = 0);
+   ~ConcurrentIntSet();
+   bool add(int anInt);
+   bool remove(int anInt);
+   bool contains(int anInt) const;
+   int size() const;
+   bool isEmpty() const;
+   IntSet toIntSet() const;
+
+private:
+   struct table
+   {
+      std::size_t capacity;             // a power of 2
+      std::atomic<uint64_t>* slots;
+   };
+
+   // A writer lock and the number of members whose keys hash to it;
+   // padded so that neighbouring stripes don't share a cache line.
+   struct stripe
+   {
+      std::mutex lock;
+      std::atomic<int> members;
+      char pad[64];
+   };
+
+   std::atomic<table*> current;
+   std::atomic<std::size_t> claimed;    // non-empty slots in *current
+   stripe stripes[STRIPES];
+
+   ConcurrentIntSet(const ConcurrentIntSet&) = delete;
+   ConcurrentIntSet& operator=(const ConcurrentIntSet&) = delete;
+
+   static table* new_table(std::size_t capacity);
+   static void destroy_table(void* t);
+   void grow(const table* seen);
+};
+
+#endif
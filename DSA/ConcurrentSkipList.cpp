@@ -0,0 +1,340 @@
+// FILE: ConcurrentSkipList.cpp
+// CLASS IMPLEMENTED: ConcurrentSkipList (see ConcurrentSkipList.h for
+//                    documentation)
+// INVARIANT for the ConcurrentSkipList class:
+//   1. head is a node with top MAX_LEVEL - 1 whose key is never read.
+//      On each level the nodes after head are in strictly increasing
+//      key order and end with NULL; a node is on levels 0 .. top once
+//      it is fully_linked.
+//   2. A node's links (and its marked flag) change only while the node
+//      is locked: a writer locks every node whose next it stores into
+//      and, for remove, the victim.
+//   3. The members are the nodes that are fully_linked and not marked;
+//      members counts them. A marked node stays on its levels until the
+//      remover that marked it unlinks it, and is then given to
+//      epoch_retire. No writer links a new node after a marked one
+//      (add checks under the locks), so once unlinked, a node can only
+//      be reached by threads that were already pinned.
+//   4. Every operation touches nodes only while pinned by an
+//      epoch_guard.
+
+#include "ConcurrentSkipList.h"
+#include "epoch.h"
+#include <new>       // provides operator new, placement new
+#include <stdint.h>  // provides uint64_t
+#include <thread>    // provides this_thread::yield
+
+using CS3358_FA2023::epoch_guard;
+using CS3358_FA2023::epoch_retire;
+
+typedef ConcurrentSkipList::node node;
+
+const int ConcurrentSkipList::MAX_LEVEL;
+
+// ===== nodes =====
+
+// One block: the node, then its top + 1 links.
+static node* new_node(int key, int top)
+{
+   void* block = ::operator new(sizeof(node) + (top + 1) * sizeof(std::atomic<node*>));
+   node* n = new (block) node;
+   n->key = key;
+   n->top = top;
+   n->marked.store(false, std::memory_order_relaxed);
+   n->fully_linked.store(false, std::memory_order_relaxed);
+   n->locked.store(false, std::memory_order_relaxed);
+   n->next = reinterpret_cast<std::atomic<node*>*>(n + 1);
+   for (int level = 0; level <= top; ++level)
+      new (&n->next[level]) std::atomic<node*>(0);
+   return n;
+}
+
+static void destroy_node(void* p)
+{
+   ::operator delete(p);
+}
+
+// Node locks are held for a few stores, so a spin lock that yields
+// beats a mutex (and adds 1 byte to the node, not 40).
+static void lock(node* n)
+{
+   while (n->locked.exchange(true, std::memory_order_acquire))
+      std::this_thread::yield();
+}
+
+static void unlock(node* n)
+{
+   n->locked.store(false, std::memory_order_release);
+}
+
+// The same node may be the predecessor on several neighbouring levels;
+// it is locked (and unlocked) once.
+static void unlock_preds(node** preds, int highest)
+{
+   node* previous = 0;
+   for (int level = 0; level <= highest; ++level)
+   {
+      if (preds[level] != previous)
+         unlock(preds[level]);
+      previous = preds[level];
+   }
+}
+
+static bool is_member(const node* n)
+{
+   return n->fully_linked.load(std::memory_order_acquire) &&
+          !n->marked.load(std::memory_order_acquire);
+}
+
+// Level for a new node: each level above 0 with probability 1/4, from a
+// per-thread xorshift generator.
+static int random_top()
+{
+   static thread_local uint64_t state = 0;
+   if (state == 0)
+      state = uint64_t(reinterpret_cast<uintptr_t>(&state)) * 0x9E3779B97F4A7C15ull | 1;
+   state ^= state << 13;
+   state ^= state >> 7;
+   state ^= state << 17;
+   uint64_t bits = state;
+   int top = 0;
+   while (top < ConcurrentSkipList::MAX_LEVEL - 1 && (bits & 3) == 0)
+   {
+      ++top;
+      bits >>= 2;
+   }
+   return top;
+}
+
+// ===== ConcurrentSkipList =====
+
+ConcurrentSkipList::ConcurrentSkipList() : head(new_node(0, MAX_LEVEL - 1)), members(0)
+{
+}
+
+ConcurrentSkipList::~ConcurrentSkipList()
+{
+   node* n = head;
+   while (n != 0)
+   {
+      node* next = n->next[0].load(std::memory_order_relaxed);
+      destroy_node(n);
+      n = next;
+   }
+}
+
+// Fills preds[level] with the last node before anInt on each level and
+// succs[level] with the one after it (NULL at the end); returns the
+// highest level where succs[level] has key anInt, or -1.
+int ConcurrentSkipList::find(int anInt, node** preds, node** succs) const
+{
+   int found = -1;
+   node* pred = head;
+   for (int level = MAX_LEVEL - 1; level >= 0; --level)
+   {
+      node* curr = pred->next[level].load(std::memory_order_acquire);
+      while (curr != 0 && curr->key < anInt)
+      {
+         pred = curr;
+         curr = pred->next[level].load(std::memory_order_acquire);
+      }
+      if (found == -1 && curr != 0 && curr->key == anInt)
+         found = level;
+      preds[level] = pred;
+      succs[level] = curr;
+   }
+   return found;
+}
+
+bool ConcurrentSkipList::add(int anInt)
+{
+   node* preds[MAX_LEVEL];
+   node* succs[MAX_LEVEL];
+   int top = random_top();
+   // allocated up front so no lock is ever held across new
+   node* fresh = new_node(anInt, top);
+
+   epoch_guard guard;
+   for (;;)
+   {
+      int found = find(anInt, preds, succs);
+      if (found != -1)
+      {
+         node* existing = succs[found];
+         if (!existing->marked.load(std::memory_order_acquire))
+         {
+            // a member, or about to be one
+            while (!existing->fully_linked.load(std::memory_order_acquire))
+               std::this_thread::yield();
+            destroy_node(fresh);
+            return false;
+         }
+         // being removed: give its remover the core to unlink it
+         std::this_thread::yield();
+         continue;
+      }
+
+      // lock the predecessors bottom up and check that each still
+      // links straight to its successor and neither is being removed
+      int highest = -1;
+      bool valid = true;
+      node* previous = 0;
+      for (int level = 0; valid && level <= top; ++level)
+      {
+         node* pred = preds[level];
+         node* succ = succs[level];
+         if (pred != previous)
+            lock(pred);
+         highest = level;
+         previous = pred;
+         valid = !pred->marked.load(std::memory_order_acquire) &&
+                 (succ == 0 || !succ->marked.load(std::memory_order_acquire)) &&
+                 pred->next[level].load(std::memory_order_acquire) == succ;
+      }
+      if (!valid)
+      {
+         // another writer changed these links; let it finish before
+         // searching again
+         unlock_preds(preds, highest);
+         std::this_thread::yield();
+         continue;
+      }
+
+      for (int level = 0; level <= top; ++level)
+         fresh->next[level].store(succs[level], std::memory_order_relaxed);
+      for (int level = 0; level <= top; ++level)
+         preds[level]->next[level].store(fresh, std::memory_order_release);
+      fresh->fully_linked.store(true, std::memory_order_release);
+      unlock_preds(preds, highest);
+      members.fetch_add(1, std::memory_order_relaxed);
+      return true;
+   }
+}
+
+bool ConcurrentSkipList::remove(int anInt)
+{
+   node* preds[MAX_LEVEL];
+   node* succs[MAX_LEVEL];
+   node* victim = 0;
+
+   epoch_guard guard;
+   for (;;)
+   {
+      int found = find(anInt, preds, succs);
+      if (victim == 0)
+      {
+         // only a member found on its own top level is removable (a
+         // node still being linked isn't a member yet)
+         if (found == -1) return false;
+         node* candidate = succs[found];
+         if (!candidate->fully_linked.load(std::memory_order_acquire) ||
+             candidate->top != found ||
+             candidate->marked.load(std::memory_order_acquire))
+            return false;
+         lock(candidate);
+         if (candidate->marked.load(std::memory_order_relaxed))
+         {
+            unlock(candidate);
+            return false;
+         }
+         candidate->marked.store(true, std::memory_order_release);
+         victim = candidate;   // kept locked until it is unlinked
+      }
+
+      int top = victim->top;
+      int highest = -1;
+      bool valid = true;
+      node* previous = 0;
+      for (int level = 0; valid && level <= top; ++level)
+      {
+         node* pred = preds[level];
+         if (pred != previous)
+            lock(pred);
+         highest = level;
+         previous = pred;
+         valid = !pred->marked.load(std::memory_order_acquire) &&
+                 pred->next[level].load(std::memory_order_acquire) == victim;
+      }
+      if (!valid)
+      {
+         unlock_preds(preds, highest);
+         std::this_thread::yield();
+         continue;
+      }
+
+      for (int level = top; level >= 0; --level)
+         preds[level]->next[level].store(victim->next[level].load(std::memory_order_relaxed),
+                                         std::memory_order_release);
+      unlock(victim);
+      unlock_preds(preds, highest);
+      members.fetch_sub(1, std::memory_order_relaxed);
+      epoch_retire(victim, destroy_node);
+      return true;
+   }
+}
+
+// Goes right on the upper levels only onto members, then scans the
+// rest of level 0 for the last member; if another thread removes that
+// key first, looks again.
+bool ConcurrentSkipList::remove_max(int& removed)
+{
+   for (;;)
+   {
+      int key;
+      {
+         epoch_guard guard;
+         node* pred = head;
+         for (int level = MAX_LEVEL - 1; level >= 1; --level)
+         {
+            node* next = pred->next[level].load(std::memory_order_acquire);
+            while (next != 0 && is_member(next))
+            {
+               pred = next;
+               next = pred->next[level].load(std::memory_order_acquire);
+            }
+         }
+         node* last = (pred != head && is_member(pred)) ? pred : 0;
+         for (node* n = pred->next[0].load(std::memory_order_acquire); n != 0;
+              n = n->next[0].load(std::memory_order_acquire))
+            if (is_member(n))
+               last = n;
+         if (last == 0) return false;
+         key = last->key;
+      }
+      if (remove(key))
+      {
+         removed = key;
+         return true;
+      }
+   }
+}
+
+bool ConcurrentSkipList::contains(int anInt) const
+{
+   node* preds[MAX_LEVEL];
+   node* succs[MAX_LEVEL];
+   epoch_guard guard;
+   int found = find(anInt, preds, succs);
+   return found != -1 && is_member(succs[found]);
+}
+
+int ConcurrentSkipList::size() const
+{
+   return members.load(std::memory_order_relaxed);
+}
+
+bool ConcurrentSkipList::isEmpty() const
+{
+   return size() == 0;
+}
+
+void ConcurrentSkipList::snapshot(std::vector<int>& keys) const
+{
+   keys.clear();
+   keys.reserve(std::size_t(size() > 0 ? size() : 0));
+   epoch_guard guard;
+   for (node* n = head->next[0].load(std::memory_order_acquire); n != 0;
+        n = n->next[0].load(std::memory_order_acquire))
+      if (is_member(n))
+         keys.push_back(n->key);
+}
@@ -0,0 +1,112 @@
+// FILE: ConcurrentSkipList.h
+// CLASS PROVIDED: ConcurrentSkipList (an ordered set of ints that many
+//                 threads may read and change at the same time; the
+//                 shared replacement for a btNode tree)
+//
+// STORAGE:
+//   A lazy skip list. Every member has a node on level 0, and each node
+//   is also linked on levels 1 .. top with probability 1/4 per level,
+//   so a search skips ahead on the sparse upper levels and finds a key
+//   in O(log n) expected steps.
+//   - contains() takes no lock: it pins the thread (see epoch.h) and
+//     walks down the levels. A node counts as a member once it is
+//     linked on all its levels and until it is marked removed.
+//   - add() and remove() search the same way without locks, then lock
+//     only the nodes whose links they change (the predecessors on each
+//     level, and the victim for remove), check that nothing changed
+//     between the search and the locks, and retry if something did,
+//     first yielding the core to the writer that got in the way.
+//     Writers of keys far apart never touch the same locks.
+//   - remove() marks the victim first (that is when it stops being a
+//     member), then unlinks it on every level and hands it to
+//     epoch_retire, so readers still on it are never left with freed
+//     memory.
+//
+// CONSTRUCTOR for the ConcurrentSkipList class:
+//   ConcurrentSkipList()
+//     Post: The set is empty.
+//
+// MODIFICATION MEMBER FUNCTIONS for the ConcurrentSkipList class
+// (safe to call from any number of threads at once):
+//   bool add(int anInt)
+//     Post: If anInt was not a member, it has been added and true has
+//           been returned; otherwise false has been returned.
+//   bool remove(int anInt)
+//     Post: If anInt was a member, it has been removed and true has
+//           been returned; otherwise false has been returned.
+//   bool remove_max(int& removed)
+//     Post: If the set was not empty, a key that was the largest member
+//           at some moment during the call has been removed, put in
+//           removed, and true has been returned; otherwise false has
+//           been returned and removed is unchanged.
+//
+// CONSTANT MEMBER FUNCTIONS for the ConcurrentSkipList class
+// (safe to call from any number of threads at once):
+//   bool contains(int anInt) const
+//     Post: true has been returned if anInt is a member. Every add or
+//           remove that finished before the call began is seen.
+//   int size() const
+//     Post: The number of members has been returned (while writers are
+//           running, a number the set had at some recent moment).
+//   bool isEmpty() const
+//     Post: true has been returned if size() is 0.
+//   void snapshot(std::vector<int>& keys) const
+//     Post: keys holds members in increasing order: every key that was
+//           a member for the whole call, and none that was a member at
+//           no point during it (keys added or removed during the call
+//           may or may not be there).
+//
+// VALUE SEMANTICS for the ConcurrentSkipList class:
+//   A ConcurrentSkipList can't be copied or assigned (copy it with
+//   snapshot() instead). The destructor must not run while another
+//   thread is still using the list.
+//
+// DYNAMIC MEMORY USAGE by the ConcurrentSkipList class:
+//   If there is insufficient dynamic memory, the constructor, add and
+//   snapshot throw bad_alloc. A removed node is freed once no reader
+//   can still be on it.
+
+#ifndef CONCURRENT_SKIP_LIST_H
+#define CONCURRENT_SKIP_LIST_H
+
+#include <atomic>    // provides atomic
+#include <vector>    // provides vector
+
+class ConcurrentSkipList
+{
+public:
+   static const int MAX_LEVEL = 16;   // levels 0 .. MAX_LEVEL - 1
+
+   ConcurrentSkipList();
+   ~ConcurrentSkipList();
+   bool add(int anInt);
+   bool remove(int anInt);
+   bool remove_max(int& removed);
+   bool contains(int anInt) const;
+   int size() const;
+   bool isEmpty() const;
+   void snapshot(std::vector<int>& keys) const;
+
+   // The node layout; public only so that the helper functions in
+   // ConcurrentSkipList.cpp can take it.
+   struct node
+   {
+      int key;
+      int top;                               // highest level linked on
+      std::atomic<bool> marked;              // removed (or being removed)
+      std::atomic<bool> fully_linked;        // linked on every level
+      std::atomic<bool> locked;
+      std::atomic<node*>* next;              // top + 1 links, stored
+                                             // right after the node
+   };
+
+private:
+   node* head;                               // sentinel below every key
+   std::atomic<int> members;
+
+   int find(int anInt, node** preds, node** succs) const;
+   ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+   ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+};
+
+#endif
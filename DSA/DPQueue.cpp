@@ -25,34 +25,50 @@
 #include <iomanip>   // provides setw
 #include <cmath>     // provides log2
 #include "DPQueue.h"
+#include "growthPolicy.h"
 
 using namespace std;
+using CS3358_FA2023::growth_policy;
+using CS3358_FA2023::geometric_growth;
+using CS3358_FA2023::growth_stats;
+using CS3358_FA2023::allocate_items;
+using CS3358_FA2023::deallocate_items;
 
 namespace CS3358_FA2023_A7
 {
+   // The growth used when no policy is given (the original 1.25x + 1).
+   static growth_policy* default_p_queue_growth()
+   {
+      static geometric_growth policy(1.25, 1);
+      return &policy;
+   }
+
    // CONSTRUCTORS AND DESTRUCTOR
 
    // Constructor init priority q with i_c
    // If the i_c is less than 1, it sets it to the d_c
-   p_queue::p_queue(size_type initial_capacity):capacity(initial_capacity), used(0)
+   p_queue::p_queue(size_type initial_capacity, growth_policy* policy):capacity(initial_capacity), used(0), policy(policy)
    {
       if(initial_capacity < 1){capacity = DEFAULT_CAPACITY;}
-      heap = new ItemType[capacity];
+      if(policy == 0){this->policy = default_p_queue_growth();}
+      heap = allocate_items<ItemType>(*this->policy, capacity);
+      stats.record_allocation(capacity);
    }
 
    // Copy constructor creates new priority q, deep copy of source
-   p_queue::p_queue(const p_queue& src):capacity(src.capacity), used(src.used)
+   p_queue::p_queue(const p_queue& src):capacity(src.capacity), used(src.used), policy(src.policy)
    {
-      heap = new ItemType[capacity];
+      heap = allocate_items<ItemType>(*policy, capacity);
+      stats.record_allocation(capacity);
       // DC of the elements from the source
-      for(size_type index = 0; index < capacity; ++index)
+      for(size_type index = 0; index < used; ++index)
          heap[index] = src.heap[index];
    }
 
    // Destructor to free memory used by priority q
    p_queue::~p_queue()
    {
-      delete [] heap;
+      deallocate_items(*policy, heap, capacity);
       heap = 0;
    }
 
@@ -65,13 +81,14 @@ namespace CS3358_FA2023_A7
          return *this;
       
       // temp heap, copy elements from the rhs q
-      ItemType *temp_heap = new ItemType[rhs.capacity];
+      ItemType *temp_heap = allocate_items<ItemType>(*policy, rhs.capacity);
       for (size_type index = 0; index < rhs.used; ++index){
          temp_heap[index] = rhs.heap[index];
       }
 
       // Free old heap update heap, capacity, and used lhs queue
-      delete [] heap;
+      deallocate_items(*policy, heap, capacity);
+      stats.record_reallocation(rhs.capacity);
       heap = temp_heap;
       capacity = rhs.capacity;
       used = rhs.used;
@@ -81,7 +98,7 @@ namespace CS3358_FA2023_A7
    // Push new element with priority into the priority q
    void p_queue::push(const value_type& entry, size_type priority)
    {
-      if(used == capacity){resize(size_type(1.25 * capacity)+1);}
+      if(used == capacity){resize(policy->next_capacity(capacity, used + 1, sizeof(ItemType)));}
 
       size_type index = used;
 
@@ -138,6 +155,12 @@ namespace CS3358_FA2023_A7
       return heap[0].data;
    }
 
+   // reallocation count and peak capacity so far
+   const growth_stats& p_queue::growth() const
+   {
+      return stats;
+   }
+
    // PRIVATE HELPER FUNCTIONS
    void p_queue::resize(size_type new_capacity)
    // Pre:  (none)
@@ -152,14 +175,15 @@ namespace CS3358_FA2023_A7
    {
       if(new_capacity < used){new_capacity = used;}
 
-      ItemType* temp_heap = new ItemType[new_capacity];
+      ItemType* temp_heap = allocate_items<ItemType>(*policy, new_capacity);
 
       for(size_type index = 0; index < used; ++index){
          temp_heap[index] = heap[index];
       } 
-      delete [] heap;
+      deallocate_items(*policy, heap, capacity);
       heap = temp_heap;
       capacity = new_capacity;
+      stats.record_reallocation(capacity);
    }
 
    bool p_queue::is_leaf(size_type i) const
@@ -210,13 +234,6 @@ namespace CS3358_FA2023_A7
       size_type iLHSC = (i * 2) + 1; /// Index of LHS child.
       size_type iRHSC = (i * 2) + 2; /// Index of RHS child.
 
-      if(i == 0){
-         if(heap[1].priority >= heap[2].priority){
-            return 1;
-         } else {
-            return 2;
-         }
-      }
       if (iRHSC < used && heap[iRHSC].priority > heap[iLHSC].priority){
          return iRHSC;  /// 2child
       } else {
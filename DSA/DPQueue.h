@@ -0,0 +1,127 @@
+// FILE: DPQueue.h (part of the namespace CS3358_FA2023_A7)
+// CLASS PROVIDED: p_queue (a priority queue of items, kept as a heap in
+//                 a dynamic array)
+//
+// TYPEDEFS and MEMBER CONSTANTS for the p_queue class:
+//   typedef ____ value_type
+//     p_queue::value_type is the data type of the items in the
+//     p_queue. It may be any of the C++ built-in types (int, char,
+//     etc.), or a class with a default constructor, a copy
+//     constructor, an assignment operator, and an output operator.
+//   typedef ____ size_type
+//     p_queue::size_type is the data type of any variable that keeps
+//     track of how many items are in a p_queue (and of priorities).
+//   static const size_type DEFAULT_CAPACITY = _____
+//     p_queue::DEFAULT_CAPACITY is the initial capacity of a p_queue
+//     that is created by the default constructor.
+//
+// CONSTRUCTOR for the p_queue class:
+//   p_queue(size_type initial_capacity = DEFAULT_CAPACITY,
+//           CS3358_FA2023::growth_policy* policy = 0)
+//     Pre:  policy is NULL or outlives the p_queue (it is not owned).
+//     Post: The p_queue has been initialized as an empty p_queue with
+//           room for initial_capacity items (DEFAULT_CAPACITY if
+//           initial_capacity is 0). The heap array, and every later
+//           one, is obtained from and sized by policy (see
+//           growthPolicy.h); a NULL policy means geometric_growth(1.25,
+//           1), which grows a full array to 1.25 * capacity + 1.
+//
+// MODIFICATION MEMBER FUNCTIONS for the p_queue class:
+//   void push(const value_type& entry, size_type priority)
+//     Pre:  (none)
+//     Post: A new copy of entry has been inserted with the specified
+//           priority.
+//   void pop()
+//     Pre:  size() > 0.
+//     Post: The highest priority item has been removed from the
+//           p_queue. (If several items have the equal priority, then
+//           there is no guarantee about which one will come out
+//           first!)
+//
+// CONSTANT MEMBER FUNCTIONS for the p_queue class:
+//   size_type size() const
+//     Pre:  (none)
+//     Post: Return value is the total number of items in the p_queue.
+//   bool empty() const
+//     Pre:  (none)
+//     Post: Return value is true if the p_queue is empty, otherwise
+//           false.
+//   value_type front() const
+//     Pre:  size() > 0.
+//     Post: The return value is the data of the highest priority item
+//           in the p_queue, but the p_queue is unchanged. (If several
+//           items have the equal priority, then there is no guarantee
+//           about which one will be returned!)
+//   const CS3358_FA2023::growth_stats& growth() const
+//     Pre:  (none)
+//     Post: The return value holds the number of reallocations and the
+//           peak capacity of this p_queue.
+//   void print_tree(const char message[] = "", size_type i = 0) const
+//   void print_array(const char message[] = "") const
+//     Debugging aids; see DPQueue.cpp.
+//
+// VALUE SEMANTICS for the p_queue class:
+//   Assignments and the copy constructor may be used with p_queue
+//   objects. A copy uses the source's policy; assignment keeps its own.
+//
+// DYNAMIC MEMORY USAGE by the p_queue class:
+//   If there is insufficient dynamic memory, the following functions
+//   throw bad_alloc: the constructors, push, and the assignment
+//   operator.
+
+#ifndef DPQUEUE_H
+#define DPQUEUE_H
+
+#include <cstdlib>  // provides size_t
+#include "growthPolicy.h"
+
+namespace CS3358_FA2023_A7
+{
+   class p_queue
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef int value_type;
+      typedef std::size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 1;
+      struct ItemType
+      {
+         value_type data;
+         size_type priority;
+      };
+      // CONSTRUCTORS and DESTRUCTOR
+      p_queue(size_type initial_capacity = DEFAULT_CAPACITY,
+              CS3358_FA2023::growth_policy* policy = 0);
+      p_queue(const p_queue& src);
+      ~p_queue();
+      // MODIFICATION MEMBER FUNCTIONS
+      p_queue& operator=(const p_queue& rhs);
+      void push(const value_type& entry, size_type priority);
+      void pop();
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool empty() const;
+      value_type front() const;
+      const CS3358_FA2023::growth_stats& growth() const;
+      // EXTRA MEMBER FUNCTIONS FOR DEBUG PRINTING
+      void print_tree(const char message[] = "", size_type i = 0) const;
+      void print_array(const char message[] = "") const;
+
+   private:
+      ItemType* heap;
+      size_type capacity;
+      size_type used;
+      CS3358_FA2023::growth_policy* policy;
+      CS3358_FA2023::growth_stats stats;
+      // PRIVATE HELPER FUNCTIONS (see DPQueue.cpp for documentation)
+      void resize(size_type new_capacity);
+      bool is_leaf(size_type i) const;
+      size_type parent_index(size_type i) const;
+      size_type parent_priority(size_type i) const;
+      size_type big_child_index(size_type i) const;
+      size_type big_child_priority(size_type i) const;
+      void swap_with_parent(size_type i);
+   };
+}
+
+#endif
@@ -0,0 +1,213 @@
+// FILE: GapSequence.cpp
+// CLASS IMPLEMENTED: gap_sequence (see GapSequence.h for documentation)
+// INVARIANT for the gap_sequence ADT:
+//   1. The items of the sequence are stored in a dynamic array, pointed
+//      to by the member variable data, whose size is in the member
+//      variable capacity.
+//   2. The items BEFORE the current item are stored, in order, in
+//      data[0] through data[gap_begin - 1].
+//   3. The current item and the items after it are stored, in order,
+//      in data[gap_end] through data[capacity - 1].
+//   4. data[gap_begin] through data[gap_end - 1] is the "gap"; we don't
+//      care what is stored there. The number of items in the sequence
+//      is therefore capacity - (gap_end - gap_begin).
+//   5. There is a current item if and only if gap_end < capacity, in
+//      which case it is data[gap_end].
+//      NOTE: This mirrors the "current_index == used means no current
+//            item" rule of sequence: the gap sitting at the very end
+//            of the array means the cursor is just past the last item.
+//   6. The array was obtained from the member variable policy, which
+//      also decides how far it grows; stats counts the reallocations.
+
+#include <cassert>
+#include "GapSequence.h"
+#include <cstdlib>
+using namespace std;
+
+namespace CS3358_FA2023
+{
+   // The growth used when no policy is given (the original 1.5x + 1).
+   static growth_policy* default_gap_growth()
+   {
+      static geometric_growth policy(1.5, 1);
+      return &policy;
+   }
+
+   // === CONSTRUCTORS and DESTRUCTOR ===
+
+   // Constructor with given capacity. The whole array starts out as gap.
+   gap_sequence::gap_sequence(size_type initial_capacity, growth_policy* policy)
+      : gap_begin(0), gap_end(initial_capacity), capacity(initial_capacity), policy(policy)
+   {
+      if(initial_capacity < 1){
+         capacity = gap_end = 1;}
+      if(policy == NULL){
+         this->policy = default_gap_growth();}
+
+      data = allocate_items<value_type>(*this->policy, capacity);
+      stats.record_allocation(capacity);
+   }
+
+   // Copy constructor. Items keep the same positions, so the gap (and
+   // therefore the cursor) is where it was in source.
+   gap_sequence::gap_sequence(const gap_sequence& source)
+      : gap_begin(source.gap_begin), gap_end(source.gap_end), capacity(source.capacity),
+        policy(source.policy)
+   {
+      data = allocate_items<value_type>(*policy, capacity);
+      stats.record_allocation(capacity);
+
+      for (size_type i = 0; i < gap_begin; ++i) {
+         data[i] = source.data[i];
+      }
+      for (size_type i = gap_end; i < capacity; ++i) {
+         data[i] = source.data[i];
+      }
+   }
+
+   gap_sequence::~gap_sequence()
+   {
+      deallocate_items(*policy, data, capacity);
+      data = NULL;
+   }
+
+
+   // MODIFICATION MEMBER FUNCTIONS
+
+   // Reallocate, keeping the prefix at the front and the suffix at the
+   // back so the gap stays at the cursor.
+   void gap_sequence::resize(size_type new_capacity)
+   {
+      size_type suffix = capacity - gap_end;
+      size_type used = gap_begin + suffix;
+
+      if(new_capacity < used) {
+         new_capacity = used;}
+      if(new_capacity < 1) {
+         new_capacity = 1;}
+
+      value_type *temp_data = allocate_items<value_type>(*policy, new_capacity);
+      for (size_type i = 0; i < gap_begin; ++i) {
+         temp_data[i] = data[i];
+      }
+      for (size_type i = 0; i < suffix; ++i) {
+         temp_data[new_capacity - suffix + i] = data[gap_end + i];
+      }
+
+      deallocate_items(*policy, data, capacity);
+      data = temp_data;
+      capacity = new_capacity;
+      gap_end = capacity - suffix;
+      stats.record_reallocation(capacity);
+   }
+
+   // Sets the current item to the first item by moving the gap to the front.
+   void gap_sequence::start()
+   {
+      move_gap_to_front();
+   }
+
+   // Advances to the next item: the current item crosses the gap.
+   void gap_sequence::advance()
+   {
+      assert(is_item());
+      data[gap_begin++] = data[gap_end++];
+   }
+
+   // Inserts a new item before the current item, or at the start if no
+   // current item. The new item is placed at the end of the gap.
+   void gap_sequence::insert(const value_type& entry)
+   {
+      if(!is_item()) {
+         move_gap_to_front();}
+
+      if(gap_begin == gap_end) {
+         resize(policy->next_capacity(capacity, capacity + 1, sizeof(value_type)));}
+
+      data[--gap_end] = entry;
+   }
+
+   // Appends a new item after the current item, or at the end if no
+   // current item. Stepping the current item across the gap leaves the
+   // gap right after it.
+   void gap_sequence::attach(const value_type& entry)
+   {
+      if(gap_begin == gap_end) {
+         resize(policy->next_capacity(capacity, capacity + 1, sizeof(value_type)));}
+
+      if(is_item()) {
+         data[gap_begin++] = data[gap_end++];}
+
+      data[--gap_end] = entry;
+   }
+
+   // Removes the current item by widening the gap over it.
+   void gap_sequence::remove_current()
+   {
+      assert(is_item());
+      ++gap_end;
+   }
+
+   // Assignment operator. Assign gap_sequence to other gap_sequence
+   gap_sequence& gap_sequence::operator=(const gap_sequence& source)
+   {
+      if (this == &source) return *this;
+
+      value_type *temp_data = allocate_items<value_type>(*policy, source.capacity);
+
+      for (size_type i = 0; i < source.gap_begin; ++i) {
+         temp_data[i] = source.data[i];
+      }
+      for (size_type i = source.gap_end; i < source.capacity; ++i) {
+         temp_data[i] = source.data[i];
+      }
+
+      deallocate_items(*policy, data, capacity);
+      stats.record_reallocation(source.capacity);
+
+      data = temp_data;
+      capacity = source.capacity;
+      gap_begin = source.gap_begin;
+      gap_end = source.gap_end;
+
+      return *this;
+   }
+
+
+   // CONSTANT MEMBER FUNCTIONS
+
+   gap_sequence::size_type gap_sequence::size() const
+   {
+      return capacity - (gap_end - gap_begin);
+   }
+
+   bool gap_sequence::is_item() const
+   {
+      return (gap_end != capacity);
+   }
+
+   gap_sequence::value_type gap_sequence::current() const
+   {
+      assert(is_item());
+
+      return data[gap_end];
+   }
+
+   const growth_stats& gap_sequence::growth() const
+   {
+      return stats;
+   }
+
+
+   // PRIVATE HELPER FUNCTIONS
+
+   // Pre:  (none)
+   // Post: Every item is after the gap (gap_begin == 0); the first item
+   //       (if any) is the current item.
+   void gap_sequence::move_gap_to_front()
+   {
+      while (gap_begin > 0) {
+         data[--gap_end] = data[--gap_begin];
+      }
+   }
+}
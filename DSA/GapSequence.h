@@ -0,0 +1,156 @@
+// FILE: GapSequence.h
+// CLASS PROVIDED: gap_sequence (a container class for a list of items,
+//                 where each list may have a designated item called
+//                 the current item; a drop-in alternative to sequence
+//                 (see Sequence.h) whose storage keeps a "gap" of
+//                 unused slots at the cursor)
+//
+// WHY a gap buffer:
+//   sequence::insert and sequence::attach shift every item after the
+//   cursor, so editing near the cursor of a large sequence costs O(n)
+//   per call. gap_sequence keeps the free space of its dynamic array
+//   between the items before the cursor and the items from the cursor
+//   on, so insert, attach and remove_current at the cursor are O(1)
+//   amortized; only moving the cursor moves items (one item per
+//   advance(); start() and inserting with no current item move the
+//   whole prefix once).
+//
+// TYPEDEFS and MEMBER CONSTANTS for the gap_sequence class:
+//   typedef ____ value_type
+//     gap_sequence::value_type is the data type of the items in the
+//     sequence. It may be any of the C++ built-in types (int, char,
+//     etc.), or a class with a default constructor, an assignment
+//     operator, and a copy constructor.
+//   typedef ____ size_type
+//     gap_sequence::size_type is the data type of any variable that
+//     keeps track of how many items are in a sequence.
+//   static const size_type DEFAULT_CAPACITY = _____
+//     gap_sequence::DEFAULT_CAPACITY is the initial capacity of a
+//     gap_sequence that is created by the default constructor.
+//
+// CONSTRUCTOR for the gap_sequence class:
+//   gap_sequence(size_type initial_capacity = DEFAULT_CAPACITY,
+//                growth_policy* policy = 0)
+//     Pre:  policy is NULL or outlives the sequence (it is not owned).
+//     Post: The sequence has been initialized as an empty sequence.
+//           The insert/attach functions will work efficiently (without
+//           allocating new memory) until this capacity is reached.
+//           (An initial_capacity of 0 is treated as 1.) The array, and
+//           every later one, is obtained from and sized by policy (see
+//           growthPolicy.h); a NULL policy means geometric_growth(1.5,
+//           1), as for sequence.
+//
+// MODIFICATION MEMBER FUNCTIONS for the gap_sequence class:
+//   void resize(size_type new_capacity)
+//     Pre:  (none)
+//     Post: The sequence's current capacity is changed to new_capacity
+//           (but not less than the number of items already on the
+//           sequence). The gap is kept at the cursor.
+//   void start()
+//     Pre:  (none)
+//     Post: The first item on the sequence becomes the current item
+//           (but if the sequence is empty, then there is no current item).
+//           Cost: O(number of items before the cursor).
+//   void advance()
+//     Pre:  is_item() returns true.
+//     Post: If the current item was the last item in the sequence, then
+//           there is no longer any current item. Otherwise, the new current
+//           item is the item immediately after the original current item.
+//           Cost: O(1) (one item is moved across the gap).
+//   void insert(const value_type& entry)
+//     Pre:  (none)
+//     Post: A new copy of entry has been inserted in the sequence
+//           before the current item. If there was no current item, then
+//           the new entry has been inserted at the front of the sequence.
+//           In either case, the newly inserted item is now the
+//           current item of the sequence.
+//           Cost: O(1) amortized when there is a current item.
+//   void attach(const value_type& entry)
+//     Pre:  (none)
+//     Post: A new copy of entry has been inserted in the sequence after
+//           the current item. If there was no current item, then the new
+//           entry has been attached to the end of the sequence. In either
+//           case, the newly inserted item is now the current item of the
+//           sequence.
+//           Cost: O(1) amortized.
+//   void remove_current()
+//     Pre:  is_item() returns true.
+//     Post: The current item has been removed from the sequence, and
+//           the item after this (if there is one) is now the new current
+//           item.
+//           Cost: O(1).
+//
+// CONSTANT MEMBER FUNCTIONS for the gap_sequence class:
+//   size_type size() const
+//     Pre:  (none)
+//     Post: The return value is the number of items in the sequence.
+//   bool is_item() const
+//     Pre:  (none)
+//     Post: A true return value indicates that there is a valid
+//           "current" item that may be retrieved by activating the current
+//           member function (listed below). A false return value indicates
+//           that there is no valid current item.
+//   value_type current() const
+//     Pre:  is_item() returns true.
+//     Post: The item returned is the current item in the sequence.
+//   const growth_stats& growth() const
+//     Pre:  (none)
+//     Post: The return value holds the number of reallocations and the
+//           peak capacity of this sequence.
+//
+// VALUE SEMANTICS for the gap_sequence class:
+//    Assignments and the copy constructor may be used with gap_sequence
+//    objects. A copy uses the source's policy; assignment keeps the
+//    invoking sequence's policy.
+//
+// DYNAMIC MEMORY USAGE by the gap_sequence class:
+//   If there is insufficient dynamic memory, the following functions
+//   throw bad_alloc: the constructors, resize, insert, attach, and the
+//   assignment operator.
+
+#ifndef GAP_SEQUENCE_H
+#define GAP_SEQUENCE_H
+
+#include <cstdlib>  // provides size_t
+#include "growthPolicy.h"
+
+namespace CS3358_FA2023
+{
+   class gap_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 30;
+      // CONSTRUCTORS and DESTRUCTOR
+      gap_sequence(size_type initial_capacity = DEFAULT_CAPACITY,
+                   growth_policy* policy = 0);
+      gap_sequence(const gap_sequence& source);
+      ~gap_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void resize(size_type new_capacity);
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      gap_sequence& operator=(const gap_sequence& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+      const growth_stats& growth() const;
+
+   private:
+      value_type* data;
+      size_type gap_begin;
+      size_type gap_end;
+      size_type capacity;
+      growth_policy* policy;
+      growth_stats stats;
+      void move_gap_to_front();
+   };
+}
+
+#endif
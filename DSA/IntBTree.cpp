@@ -0,0 +1,575 @@
+// FILE: IntBTree.cpp
+//       Implementation file for the IntBTree class
+//       (See IntBTree.h for documentation.)
+// INVARIANT for the IntBTree class:
+// (1) root is NULL (and levels, used, leaf_nodes and inner_nodes are 0)
+//     when the tree is empty. Otherwise levels is the number of levels:
+//     nodes on level 1 are leaf_nodes, those above are inner_nodes, and
+//     root is the single node on level levels.
+// (2) A leaf holds count keys (1 .. LEAF_MAX) in increasing order; the
+//     leaves, read left to right through next, hold all used keys in
+//     increasing order (the last leaf's next is NULL).
+// (3) An inner node holds count children (2 .. INNER_MAX) and count - 1
+//     keys: every key under kids[i] is < keys[i] <= every key under
+//     kids[i + 1].
+// (4) Every node other than the root is at least half full: a leaf
+//     has >= LEAF_MAX / 2 keys, an inner node >= INNER_MAX / 2
+//     children.
+// (5) leaf_nodes and inner_nodes count the nodes of each kind.
+
+#include "IntBTree.h"
+#include <vector>   // provides vector
+using namespace std;
+
+typedef IntBTree::leaf_node leaf_node;
+typedef IntBTree::inner_node inner_node;
+
+const int IntBTree::LEAF_MAX;
+const int IntBTree::INNER_MAX;
+
+static const int LEAF_MIN = IntBTree::LEAF_MAX / 2;
+static const int INNER_MIN = IntBTree::INNER_MAX / 2;
+
+// ===== searching within a node =====
+// Both count rather than branch, so the loop has no data-dependent
+// exits and compiles to SIMD compares.
+
+// Number of keys in the leaf that are < key (where key would go).
+static int leaf_position(const leaf_node* leaf, int key)
+{
+   int below = 0;
+   for (int i = 0; i < leaf->count; ++i)
+      below += (leaf->keys[i] < key) ? 1 : 0;
+   return below;
+}
+
+// Index of the child whose range holds key.
+static int child_position(const inner_node* inner, int key)
+{
+   int at_or_below = 0;
+   for (int i = 0; i < inner->count - 1; ++i)
+      at_or_below += (inner->keys[i] <= key) ? 1 : 0;
+   return at_or_below;
+}
+
+// The leaf whose range holds key (root is not NULL).
+static const leaf_node* find_leaf(const void* root, int levels, int key)
+{
+   const void* node = root;
+   for (int level = levels; level > 1; --level)
+   {
+      const inner_node* inner = static_cast<const inner_node*>(node);
+      node = inner->kids[child_position(inner, key)];
+   }
+   return static_cast<const leaf_node*>(node);
+}
+
+// ===== node helpers =====
+
+static leaf_node* new_leaf(size_t& leaf_nodes)
+{
+   leaf_node* leaf = new leaf_node;
+   leaf->count = 0;
+   leaf->next = NULL;
+   ++leaf_nodes;
+   return leaf;
+}
+
+static inner_node* new_inner(size_t& inner_nodes)
+{
+   inner_node* inner = new inner_node;
+   inner->count = 0;
+   ++inner_nodes;
+   return inner;
+}
+
+static void delete_subtree(void* node, int level)
+{
+   if (level > 1)
+   {
+      inner_node* inner = static_cast<inner_node*>(node);
+      for (int i = 0; i < inner->count; ++i)
+         delete_subtree(inner->kids[i], level - 1);
+      delete inner;
+   }
+   else
+      delete static_cast<leaf_node*>(node);
+}
+
+// ===== insert =====
+
+// Inserts key under node (on the given level). If node had to split,
+// its new right half is put in right and the key that separates them
+// in separator; otherwise right is set to NULL.
+static bool insert_into(void* node, int level, int key, void*& right, int& separator,
+                        size_t& leaf_nodes, size_t& inner_nodes)
+{
+   right = NULL;
+
+   if (level == 1)
+   {
+      leaf_node* leaf = static_cast<leaf_node*>(node);
+      int pos = leaf_position(leaf, key);
+      if (pos < leaf->count && leaf->keys[pos] == key) return false;
+
+      if (leaf->count == IntBTree::LEAF_MAX)
+      {
+         // split in half, then insert into whichever half key belongs to
+         leaf_node* sibling = new_leaf(leaf_nodes);
+         int half = IntBTree::LEAF_MAX / 2;
+         for (int i = half; i < leaf->count; ++i)
+            sibling->keys[i - half] = leaf->keys[i];
+         sibling->count = leaf->count - half;
+         leaf->count = half;
+         sibling->next = leaf->next;
+         leaf->next = sibling;
+         right = sibling;
+
+         if (pos > half)
+         {
+            leaf = sibling;
+            pos -= half;
+         }
+      }
+
+      for (int i = leaf->count; i > pos; --i)
+         leaf->keys[i] = leaf->keys[i - 1];
+      leaf->keys[pos] = key;
+      ++leaf->count;
+      if (right != NULL)
+         separator = static_cast<leaf_node*>(right)->keys[0];
+      return true;
+   }
+
+   inner_node* inner = static_cast<inner_node*>(node);
+   int c = child_position(inner, key);
+   void* child_right;
+   int child_separator;
+   if (!insert_into(inner->kids[c], level - 1, key, child_right, child_separator,
+                    leaf_nodes, inner_nodes))
+      return false;
+   if (child_right == NULL) return true;
+
+   // link the child's new sibling in after it: key c, child c + 1
+   if (inner->count < IntBTree::INNER_MAX)
+   {
+      for (int i = inner->count - 1; i > c; --i)
+      {
+         inner->keys[i] = inner->keys[i - 1];
+         inner->kids[i + 1] = inner->kids[i];
+      }
+      inner->keys[c] = child_separator;
+      inner->kids[c + 1] = child_right;
+      ++inner->count;
+      return true;
+   }
+
+   // full: lay out all INNER_MAX + 1 children, then split them between
+   // inner and a new sibling, moving the middle key up
+   int keys[IntBTree::INNER_MAX];
+   void* kids[IntBTree::INNER_MAX + 1];
+   for (int i = 0, k = 0; i < inner->count; ++i)
+   {
+      kids[k] = inner->kids[i];
+      if (i < inner->count - 1)
+         keys[k] = inner->keys[i];
+      ++k;
+      if (i == c)
+      {
+         keys[k - 1] = child_separator;
+         if (i < inner->count - 1)
+            keys[k] = inner->keys[i];
+         kids[k] = child_right;
+         ++k;
+      }
+   }
+
+   int total = IntBTree::INNER_MAX + 1;
+   int left_count = total / 2;
+   inner_node* sibling = new_inner(inner_nodes);
+   inner->count = left_count;
+   for (int i = 0; i < left_count; ++i)
+      inner->kids[i] = kids[i];
+   for (int i = 0; i < left_count - 1; ++i)
+      inner->keys[i] = keys[i];
+   separator = keys[left_count - 1];
+   sibling->count = total - left_count;
+   for (int i = 0; i < sibling->count; ++i)
+      sibling->kids[i] = kids[left_count + i];
+   for (int i = 0; i < sibling->count - 1; ++i)
+      sibling->keys[i] = keys[left_count + i];
+   right = sibling;
+   return true;
+}
+
+// ===== remove =====
+
+// kids[i] and kids[i + 1] of parent are the two nodes below; these
+// move one key or child across, or merge the right node into the left.
+
+static void leaf_shift_right(inner_node* parent, int i)
+{
+   leaf_node* l = static_cast<leaf_node*>(parent->kids[i]);
+   leaf_node* r = static_cast<leaf_node*>(parent->kids[i + 1]);
+   for (int k = r->count; k > 0; --k)
+      r->keys[k] = r->keys[k - 1];
+   r->keys[0] = l->keys[--l->count];
+   ++r->count;
+   parent->keys[i] = r->keys[0];
+}
+
+static void leaf_shift_left(inner_node* parent, int i)
+{
+   leaf_node* l = static_cast<leaf_node*>(parent->kids[i]);
+   leaf_node* r = static_cast<leaf_node*>(parent->kids[i + 1]);
+   l->keys[l->count++] = r->keys[0];
+   --r->count;
+   for (int k = 0; k < r->count; ++k)
+      r->keys[k] = r->keys[k + 1];
+   parent->keys[i] = r->keys[0];
+}
+
+static void inner_shift_right(inner_node* parent, int i)
+{
+   inner_node* l = static_cast<inner_node*>(parent->kids[i]);
+   inner_node* r = static_cast<inner_node*>(parent->kids[i + 1]);
+   for (int k = r->count; k > 0; --k)
+      r->kids[k] = r->kids[k - 1];
+   for (int k = r->count - 1; k > 0; --k)
+      r->keys[k] = r->keys[k - 1];
+   r->kids[0] = l->kids[l->count - 1];
+   r->keys[0] = parent->keys[i];
+   ++r->count;
+   parent->keys[i] = l->keys[l->count - 2];
+   --l->count;
+}
+
+static void inner_shift_left(inner_node* parent, int i)
+{
+   inner_node* l = static_cast<inner_node*>(parent->kids[i]);
+   inner_node* r = static_cast<inner_node*>(parent->kids[i + 1]);
+   l->keys[l->count - 1] = parent->keys[i];
+   l->kids[l->count] = r->kids[0];
+   ++l->count;
+   parent->keys[i] = r->keys[0];
+   for (int k = 0; k < r->count - 1; ++k)
+      r->kids[k] = r->kids[k + 1];
+   for (int k = 0; k < r->count - 2; ++k)
+      r->keys[k] = r->keys[k + 1];
+   --r->count;
+}
+
+// Merges kids[i + 1] into kids[i] and drops it (and keys[i]) from parent.
+static void merge_children(inner_node* parent, int i, int child_level,
+                           size_t& leaf_nodes, size_t& inner_nodes)
+{
+   if (child_level == 1)
+   {
+      leaf_node* l = static_cast<leaf_node*>(parent->kids[i]);
+      leaf_node* r = static_cast<leaf_node*>(parent->kids[i + 1]);
+      for (int k = 0; k < r->count; ++k)
+         l->keys[l->count + k] = r->keys[k];
+      l->count += r->count;
+      l->next = r->next;
+      delete r;
+      --leaf_nodes;
+   }
+   else
+   {
+      inner_node* l = static_cast<inner_node*>(parent->kids[i]);
+      inner_node* r = static_cast<inner_node*>(parent->kids[i + 1]);
+      l->keys[l->count - 1] = parent->keys[i];
+      for (int k = 0; k < r->count; ++k)
+         l->kids[l->count + k] = r->kids[k];
+      for (int k = 0; k < r->count - 1; ++k)
+         l->keys[l->count + k] = r->keys[k];
+      l->count += r->count;
+      delete r;
+      --inner_nodes;
+   }
+
+   for (int k = i; k < parent->count - 2; ++k)
+      parent->keys[k] = parent->keys[k + 1];
+   for (int k = i + 1; k < parent->count - 1; ++k)
+      parent->kids[k] = parent->kids[k + 1];
+   --parent->count;
+}
+
+static int node_count(const void* node, int level)
+{
+   return (level == 1) ? static_cast<const leaf_node*>(node)->count
+                       : static_cast<const inner_node*>(node)->count;
+}
+
+// Brings kids[c] of parent (just shrunk) back to at least half full by
+// borrowing from a neighbour or merging with it.
+static void fix_child(inner_node* parent, int c, int child_level,
+                      size_t& leaf_nodes, size_t& inner_nodes)
+{
+   int least = (child_level == 1) ? LEAF_MIN : INNER_MIN;
+   if (node_count(parent->kids[c], child_level) >= least) return;
+
+   if (c > 0)
+   {
+      // borrow from or merge with the left neighbour
+      if (node_count(parent->kids[c - 1], child_level) > least)
+      {
+         if (child_level == 1) leaf_shift_right(parent, c - 1);
+         else inner_shift_right(parent, c - 1);
+      }
+      else
+         merge_children(parent, c - 1, child_level, leaf_nodes, inner_nodes);
+   }
+   else
+   {
+      if (node_count(parent->kids[1], child_level) > least)
+      {
+         if (child_level == 1) leaf_shift_left(parent, 0);
+         else inner_shift_left(parent, 0);
+      }
+      else
+         merge_children(parent, 0, child_level, leaf_nodes, inner_nodes);
+   }
+}
+
+static bool remove_from(void* node, int level, int key,
+                        size_t& leaf_nodes, size_t& inner_nodes)
+{
+   if (level == 1)
+   {
+      leaf_node* leaf = static_cast<leaf_node*>(node);
+      int pos = leaf_position(leaf, key);
+      if (pos == leaf->count || leaf->keys[pos] != key) return false;
+      --leaf->count;
+      for (int i = pos; i < leaf->count; ++i)
+         leaf->keys[i] = leaf->keys[i + 1];
+      return true;
+   }
+
+   inner_node* inner = static_cast<inner_node*>(node);
+   int c = child_position(inner, key);
+   if (!remove_from(inner->kids[c], level - 1, key, leaf_nodes, inner_nodes))
+      return false;
+   fix_child(inner, c, level - 1, leaf_nodes, inner_nodes);
+   return true;
+}
+
+// ===== IntBTree =====
+
+IntBTree::IntBTree() : root(NULL), levels(0), used(0), leaf_nodes(0), inner_nodes(0)
+{
+}
+
+IntBTree::IntBTree(const IntBTree& src)
+   : root(NULL), levels(0), used(0), leaf_nodes(0), inner_nodes(0)
+{
+   if (src.used == 0) return;
+   vector<int> keys(src.used);
+   src.toArray(&keys[0]);
+   build_from_sorted(&keys[0], src.used);
+}
+
+IntBTree::~IntBTree()
+{
+   clear();
+}
+
+IntBTree& IntBTree::operator=(const IntBTree& rhs)
+{
+   if (this == &rhs) return *this;
+   IntBTree copy(rhs);
+   clear();
+   root = copy.root;
+   levels = copy.levels;
+   used = copy.used;
+   leaf_nodes = copy.leaf_nodes;
+   inner_nodes = copy.inner_nodes;
+   copy.root = NULL;
+   copy.levels = 0;
+   return *this;
+}
+
+bool IntBTree::insert(int key)
+{
+   if (root == NULL)
+   {
+      leaf_node* leaf = new_leaf(leaf_nodes);
+      leaf->keys[0] = key;
+      leaf->count = 1;
+      root = leaf;
+      levels = 1;
+      used = 1;
+      return true;
+   }
+
+   void* right;
+   int separator;
+   if (!insert_into(root, levels, key, right, separator, leaf_nodes, inner_nodes))
+      return false;
+   ++used;
+
+   if (right != NULL)
+   {
+      // the root split: grow a level
+      inner_node* top = new_inner(inner_nodes);
+      top->count = 2;
+      top->kids[0] = root;
+      top->kids[1] = right;
+      top->keys[0] = separator;
+      root = top;
+      ++levels;
+   }
+   return true;
+}
+
+bool IntBTree::remove(int key)
+{
+   if (root == NULL) return false;
+   if (!remove_from(root, levels, key, leaf_nodes, inner_nodes)) return false;
+   --used;
+
+   // shrink from the top: an inner root with one child, or an empty leaf
+   if (levels > 1 && static_cast<inner_node*>(root)->count == 1)
+   {
+      inner_node* old = static_cast<inner_node*>(root);
+      root = old->kids[0];
+      delete old;
+      --inner_nodes;
+      --levels;
+   }
+   else if (levels == 1 && used == 0)
+      clear();
+   return true;
+}
+
+// Bottom-up: spread the keys evenly over as few leaves as possible,
+// then group those under as few inner nodes as possible, and so on.
+// Even spreading keeps every node at least half full.
+void IntBTree::build_from_sorted(const int* keys, int n)
+{
+   clear();
+   if (n <= 0) return;
+
+   vector<void*> nodes;
+   vector<int> lowest;           // smallest key under each node
+   size_t leaf_total = (size_t(n) + LEAF_MAX - 1) / LEAF_MAX;
+   nodes.reserve(leaf_total);
+   lowest.reserve(leaf_total);
+
+   leaf_node* previous = NULL;
+   size_t next_key = 0;
+   for (size_t j = 0; j < leaf_total; ++j)
+   {
+      size_t take = n / leaf_total + ((j < n % leaf_total) ? 1 : 0);
+      leaf_node* leaf = new_leaf(leaf_nodes);
+      for (size_t k = 0; k < take; ++k)
+         leaf->keys[k] = keys[next_key + k];
+      leaf->count = int(take);
+      next_key += take;
+      if (previous != NULL) previous->next = leaf;
+      previous = leaf;
+      nodes.push_back(leaf);
+      lowest.push_back(leaf->keys[0]);
+   }
+   levels = 1;
+
+   while (nodes.size() > 1)
+   {
+      size_t group_total = (nodes.size() + INNER_MAX - 1) / INNER_MAX;
+      vector<void*> parents;
+      vector<int> parent_lowest;
+      parents.reserve(group_total);
+      parent_lowest.reserve(group_total);
+
+      size_t next_child = 0;
+      for (size_t j = 0; j < group_total; ++j)
+      {
+         size_t take = nodes.size() / group_total +
+                       ((j < nodes.size() % group_total) ? 1 : 0);
+         inner_node* inner = new_inner(inner_nodes);
+         for (size_t k = 0; k < take; ++k)
+         {
+            inner->kids[k] = nodes[next_child + k];
+            if (k > 0)
+               inner->keys[k - 1] = lowest[next_child + k];
+         }
+         inner->count = int(take);
+         parents.push_back(inner);
+         parent_lowest.push_back(lowest[next_child]);
+         next_child += take;
+      }
+      nodes.swap(parents);
+      lowest.swap(parent_lowest);
+      ++levels;
+   }
+
+   root = nodes[0];
+   used = n;
+}
+
+void IntBTree::clear()
+{
+   if (root != NULL)
+      delete_subtree(root, levels);
+   root = NULL;
+   levels = 0;
+   used = 0;
+   leaf_nodes = 0;
+   inner_nodes = 0;
+}
+
+int IntBTree::size() const
+{
+   return used;
+}
+
+bool IntBTree::contains(int key) const
+{
+   if (root == NULL) return false;
+   const leaf_node* leaf = find_leaf(root, levels, key);
+   int pos = leaf_position(leaf, key);
+   return pos < leaf->count && leaf->keys[pos] == key;
+}
+
+// If every key in key's leaf is smaller, the answer is the first key
+// of the next leaf.
+bool IntBTree::lower_bound(int key, int& found) const
+{
+   if (root == NULL) return false;
+   const leaf_node* leaf = find_leaf(root, levels, key);
+   int pos = leaf_position(leaf, key);
+   if (pos == leaf->count)
+   {
+      leaf = leaf->next;
+      if (leaf == NULL) return false;
+      pos = 0;
+   }
+   found = leaf->keys[pos];
+   return true;
+}
+
+void IntBTree::toArray(int* out) const
+{
+   if (root == NULL) return;
+   const void* node = root;
+   for (int level = levels; level > 1; --level)
+      node = static_cast<const inner_node*>(node)->kids[0];
+
+   for (const leaf_node* leaf = static_cast<const leaf_node*>(node);
+        leaf != NULL; leaf = leaf->next)
+   {
+      for (int i = 0; i < leaf->count; ++i)
+         *out++ = leaf->keys[i];
+   }
+}
+
+int IntBTree::height() const
+{
+   return levels;
+}
+
+size_t IntBTree::bytes_used() const
+{
+   return sizeof(IntBTree) + leaf_nodes * sizeof(leaf_node) +
+          inner_nodes * sizeof(inner_node);
+}
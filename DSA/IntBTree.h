@@ -0,0 +1,119 @@
+// FILE: IntBTree.h
+// CLASS PROVIDED: IntBTree (an ordered set of ints kept in a B+ tree; a
+//                 cache-friendly alternative to the btNode BST)
+//
+// STORAGE:
+//   A btNode holds one key and two pointers, so a lookup in a tree of n
+//   keys visits about log2(n) separately allocated nodes, nearly every
+//   one a cache miss once the tree outgrows the cache. An IntBTree node
+//   holds many keys side by side instead:
+//     leaf  - up to LEAF_MAX keys in increasing order (256 bytes of
+//             keys), plus a link to the next leaf
+//     inner - up to INNER_MAX children and the INNER_MAX - 1 separator
+//             keys between them
+//   so a lookup visits about log_32(n) nodes (4 for 1M keys, 6 for
+//   100M), each a few adjacent cache lines that the hardware
+//   prefetcher streams in, and the search within a node is a plain
+//   loop over a small array that the compiler vectorizes.
+//
+// CONSTRUCTORS for the IntBTree class:
+//   IntBTree()
+//     Post: The tree is empty.
+//   IntBTree(const IntBTree& src)
+//     Post: The tree holds the keys of src (rebuilt packed, as by
+//           build_from_sorted).
+//
+// MODIFICATION MEMBER FUNCTIONS for the IntBTree class:
+//   bool insert(int key)
+//     Post: If key was not in the tree, it has been inserted and true
+//           has been returned; otherwise false has been returned.
+//   bool remove(int key)
+//     Post: If key was in the tree, it has been removed and true has
+//           been returned; otherwise false has been returned.
+//   void build_from_sorted(const int* keys, int n)
+//     Pre:  keys[0 .. n-1] are in strictly increasing order (as from
+//           portToArrayInOrder).
+//     Post: The tree holds exactly those keys, built bottom-up in O(n)
+//           on as few nodes as possible, the keys spread evenly over
+//           them (the best layout for lookups; the first inserts
+//           afterwards split nodes).
+//   void clear()
+//     Post: The tree is empty.
+//
+// CONSTANT MEMBER FUNCTIONS for the IntBTree class:
+//   int size() const
+//     Post: The number of keys has been returned.
+//   bool contains(int key) const
+//     Post: true has been returned if key is in the tree.
+//   bool lower_bound(int key, int& found) const
+//     Post: If some key in the tree is >= key, the smallest such key
+//           has been put in found and true has been returned; otherwise
+//           false has been returned and found is unchanged.
+//   void toArray(int* out) const
+//     Pre:  out has room for size() ints.
+//     Post: The keys have been written to out in increasing order.
+//   int height() const
+//     Post: The number of levels (0 when empty, 1 when the root is a
+//           leaf) has been returned.
+//   std::size_t bytes_used() const
+//     Post: The bytes held by the tree's nodes have been returned.
+//
+// VALUE SEMANTICS for the IntBTree class:
+//   Assignments and the copy constructor may be used with IntBTree
+//   objects.
+//
+// DYNAMIC MEMORY USAGE by the IntBTree class:
+//   If there is insufficient dynamic memory, the copy constructor,
+//   insert, build_from_sorted and the assignment operator throw
+//   bad_alloc.
+
+#ifndef INT_B_TREE_H
+#define INT_B_TREE_H
+
+#include <cstdlib>   // provides size_t
+
+class IntBTree
+{
+public:
+   static const int LEAF_MAX = 64;
+   static const int INNER_MAX = 32;
+
+   IntBTree();
+   IntBTree(const IntBTree& src);
+   ~IntBTree();
+   IntBTree& operator=(const IntBTree& rhs);
+   bool insert(int key);
+   bool remove(int key);
+   void build_from_sorted(const int* keys, int n);
+   void clear();
+   int size() const;
+   bool contains(int key) const;
+   bool lower_bound(int key, int& found) const;
+   void toArray(int* out) const;
+   int height() const;
+   std::size_t bytes_used() const;
+
+   // Node layouts; public only so that the helper functions in
+   // IntBTree.cpp can take them.
+   struct leaf_node
+   {
+      int count;
+      int keys[LEAF_MAX];
+      leaf_node* next;                // the leaf to the right, or NULL
+   };
+   struct inner_node
+   {
+      int count;                      // children (keys: count - 1)
+      int keys[INNER_MAX - 1];        // keys[i] <= every key of kids[i + 1]
+      void* kids[INNER_MAX];          // inner_node* or leaf_node*
+   };
+
+private:
+   void* root;                        // NULL, a leaf, or an inner node
+   int levels;                        // 0 when empty; 1 if root is a leaf
+   int used;
+   std::size_t leaf_nodes;
+   std::size_t inner_nodes;
+};
+
+#endif
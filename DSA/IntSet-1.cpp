@@ -18,13 +18,15 @@
 //           existing member (such as through the add operation)
 //           has no effect on the "membership timing" of that int
 //           value.
-// (4) The # of distinct int values the IntSet currently contains
-//     is stored in the member variable used.
+// (4) The # of elements of data in use (starting from data[0]) is
+//     stored in the member variable used; holes of them are holes
+//     left by remove (see (8)), so the IntSet currently contains
+//     used - holes distinct int values.
 // (5) Except when the IntSet is empty (used == 0), ALL elements
 //     of data from data[0] until data[used - 1] contain relevant
-//     distinct int values; i.e., all relevant distinct int values
-//     appear together (no "holes" among them) starting from the
-//     beginning of the data array.
+//     distinct int values or holes; when holes == 0 all relevant
+//     distinct int values appear together (no "holes" among them)
+//     starting from the beginning of the data array.
 // (6) We DON'T care what is stored in any of the array elements
 //     from data[used] through data[capacity - 1].
 //     Note: This applies also when the IntSet is empry (used == 0)
@@ -40,6 +42,33 @@
 //           the data array and used (if properly initialized and
 //           maintained) should tell which elements of the data
 //           array are actually relevant.
+// (7) Once used has reached INDEX_MIN_ITEMS, the members are also
+//     kept in index, an open-addressing hash table of
+//     index_capacity slots (a power of 2, never more than 3/4 full)
+//     using Robin Hood probing: every member sits at most dist slots
+//     past its home slot, and along any probe run dist never jumps
+//     by more than one, so a lookup can stop at the first slot whose
+//     dist is smaller than its own. Empty slots have dist == -1.
+//     Below INDEX_MIN_ITEMS (and after reset()) index is normally
+//     NULL and index_capacity is 0, since a scan of data is faster
+//     then; reserve_members() may build it early. Whenever index is
+//     not NULL it holds exactly the members. Like data, index is
+//     obtained from and returned to policy.
+//     The index only speeds up membership tests; the order of data
+//     (and so DumpData) is exactly what (2) says. Each slot also
+//     records in pos where its key is in data.
+// (8) remove on an indexed IntSet drops the member from index but
+//     leaves its element of data as it is, a "hole" (unless it was
+//     data[used - 1], which is simply given up); holes counts them.
+//     data[i] is a member exactly when index holds data[i] with
+//     pos == i, which is how compact() tells members from holes.
+//     compact() slides the members down over the holes, keeping
+//     their order and fixing their pos. It runs before data is
+//     grown, rebuilt into a new index or read as a whole, so only
+//     add, remove, contains, contains_many, size and isEmpty ever
+//     see holes != 0. An IntSet without an index has no holes (it
+//     has fewer than INDEX_MIN_ITEMS members, so remove closes the
+//     gap in data right away).
 //
 // DOCUMENTATION for private member (helper) function:
 //   void resize(int new_capacity)
@@ -70,50 +99,448 @@
 //           If reallocation of dynamic array is unsuccessful, an
 //           error message to the effect is displayed and the
 //           program unconditionally terminated.
+//
+// DOCUMENTATION for the private hash-index members:
+//   struct index_slot { int key; int dist; int pos; };
+//   index_slot* index;
+//   int index_capacity;
+//     See invariant (7).
+//   void rebuild_index(int new_index_capacity)
+//     Pre:  new_index_capacity is a power of 2 and more than 4/3 of
+//           the members.
+//     Post: The members have been compacted (see invariant (8)) and
+//           index has been replaced by a table of new_index_capacity
+//           slots holding data[0] through data[used - 1].
+//   bool index_find(int anInt) const
+//     Pre:  index is not NULL.
+//     Post: true has been returned if anInt is in index.
+//   int index_lookup(int anInt) const
+//     Pre:  index is not NULL.
+//     Post: The slot holding anInt has been returned, or -1 if anInt
+//           is not in index.
+//   void index_insert(int anInt, int position)
+//     Pre:  index is not NULL, anInt is not in it and there is room
+//           for one more key (see invariant (7)).
+//     Post: anInt has been added to index with pos position.
+//   void index_erase(int slot)
+//     Pre:  index is not NULL and slot holds a key.
+//     Post: That key has been removed from index (the keys after it
+//           in its probe run have been shifted back one slot, so the
+//           index has no tombstones of its own).
+//   void compact() const
+//     Pre:  (none)
+//     Post: holes == 0; the members are in data[0] .. data[used - 1]
+//           in the same order as before (see invariant (8)). It only
+//           moves members within data and index, so it is allowed on
+//           a const IntSet (used and holes are mutable).
+//   void reserve_members(int n)
+//     Pre:  n >= size().
+//     Post: data has room for n members and, if n >= INDEX_MIN_ITEMS,
+//           index has room for n keys, so up to n - used append_new()
+//           calls need no reallocation.
+//   void append_new(int anInt)
+//     Pre:  anInt is not a member; reserve_members() has made room.
+//     Post: anInt is the newest member.
+//   void refresh_index()
+//     Pre:  data[0] .. data[used - 1] have been changed directly.
+//     Post: index has been rebuilt for the current members (or dropped
+//           if there are fewer than INDEX_MIN_ITEMS).
 
 #include "IntSet.h"
+#include "growthPolicy.h"
 #include <iostream>
 #include <cassert>
+#include <cstdlib>   // provides size_t
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define INTSET_X86_KERNELS 1
+#endif
 using namespace std;
+using CS3358_FA2023::growth_policy;
+using CS3358_FA2023::geometric_growth;
+using CS3358_FA2023::growth_stats;
+using CS3358_FA2023::allocate_items;
+using CS3358_FA2023::deallocate_items;
+
+// Sets with fewer members than this are searched by scanning data.
+static const int INDEX_MIN_ITEMS = 32;
+
+// Home slot of anInt in a table of capacity slots (a power of 2):
+// Fibonacci hashing, with the high bits folded in so that keys that
+// differ only in their high bits still spread out.
+static int index_home(int anInt, int capacity)
+{
+   unsigned h = unsigned(anInt) * 2654435769u;
+   return int((h ^ (h >> 16)) & unsigned(capacity - 1));
+}
+
+// Slots for an index holding n keys (at most 3/4 full, as add keeps it).
+static int index_size_for(int n)
+{
+   int slots = 4 * INDEX_MIN_ITEMS;
+   while (n * 4 > slots * 3)
+      slots *= 2;
+   return slots;
+}
+
+// --- membership scans for sets without an index ---
+// Each kernel comes in a plain version and SSE2 / AVX2 versions, which
+// are compiled for those instruction sets (target attributes) and
+// picked at run time by what the CPU supports, so one binary runs
+// everywhere. scan_* reports whether key is among first[0 .. count);
+// scan_many_* sets out[i] for n keys, comparing a block of keys (one
+// per vector lane) against every member, which needs no early-exit
+// branches and reads the members once per block.
+
+typedef bool (*scan_kernel)(const int* first, int count, int key);
+typedef void (*scan_many_kernel)(const int* first, int count,
+                                 const int* keys, size_t n, bool* out);
+
+static bool scan_plain(const int* first, int count, int key)
+{
+   int i = 0;
+   for (; i + 4 <= count; i += 4)
+   {
+      if ((first[i] == key) | (first[i + 1] == key) |
+          (first[i + 2] == key) | (first[i + 3] == key))
+         return true;
+   }
+   for (; i < count; ++i)
+      if (first[i] == key) return true;
+   return false;
+}
+
+static void scan_many_plain(const int* first, int count,
+                            const int* keys, size_t n, bool* out)
+{
+   for (size_t k = 0; k < n; ++k)
+      out[k] = scan_plain(first, count, keys[k]);
+}
+
+#ifdef INTSET_X86_KERNELS
+__attribute__((target("sse2")))
+static bool scan_sse2(const int* first, int count, int key)
+{
+   __m128i k = _mm_set1_epi32(key);
+   int i = 0;
+   for (; i + 16 <= count; i += 16)
+   {
+      const __m128i* p = reinterpret_cast<const __m128i*>(first + i);
+      __m128i eq = _mm_or_si128(
+         _mm_or_si128(_mm_cmpeq_epi32(_mm_loadu_si128(p), k),
+                      _mm_cmpeq_epi32(_mm_loadu_si128(p + 1), k)),
+         _mm_or_si128(_mm_cmpeq_epi32(_mm_loadu_si128(p + 2), k),
+                      _mm_cmpeq_epi32(_mm_loadu_si128(p + 3), k)));
+      if (_mm_movemask_epi8(eq) != 0) return true;
+   }
+   for (; i + 4 <= count; i += 4)
+   {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(v, k)) != 0) return true;
+   }
+   for (; i < count; ++i)
+      if (first[i] == key) return true;
+   return false;
+}
+
+__attribute__((target("sse2")))
+static void scan_many_sse2(const int* first, int count,
+                           const int* keys, size_t n, bool* out)
+{
+   size_t k = 0;
+   for (; k + 4 <= n; k += 4)
+   {
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + k));
+      __m128i found = _mm_setzero_si128();
+      for (int i = 0; i < count; ++i)
+         found = _mm_or_si128(found, _mm_cmpeq_epi32(block, _mm_set1_epi32(first[i])));
+      int mask = _mm_movemask_ps(_mm_castsi128_ps(found));
+      for (int lane = 0; lane < 4; ++lane)
+         out[k + lane] = ((mask >> lane) & 1) != 0;
+   }
+   for (; k < n; ++k)
+      out[k] = scan_sse2(first, count, keys[k]);
+}
+
+__attribute__((target("avx2")))
+static bool scan_avx2(const int* first, int count, int key)
+{
+   __m256i k = _mm256_set1_epi32(key);
+   int i = 0;
+   for (; i + 32 <= count; i += 32)
+   {
+      const __m256i* p = reinterpret_cast<const __m256i*>(first + i);
+      __m256i eq = _mm256_or_si256(
+         _mm256_or_si256(_mm256_cmpeq_epi32(_mm256_loadu_si256(p), k),
+                         _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 1), k)),
+         _mm256_or_si256(_mm256_cmpeq_epi32(_mm256_loadu_si256(p + 2), k),
+                         _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 3), k)));
+      if (!_mm256_testz_si256(eq, eq)) return true;
+   }
+   for (; i + 8 <= count; i += 8)
+   {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+      __m256i eq = _mm256_cmpeq_epi32(v, k);
+      if (!_mm256_testz_si256(eq, eq)) return true;
+   }
+   for (; i < count; ++i)
+      if (first[i] == key) return true;
+   return false;
+}
+
+__attribute__((target("avx2")))
+static void scan_many_avx2(const int* first, int count,
+                           const int* keys, size_t n, bool* out)
+{
+   size_t k = 0;
+   for (; k + 8 <= n; k += 8)
+   {
+      __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + k));
+      __m256i found = _mm256_setzero_si256();
+      for (int i = 0; i < count; ++i)
+         found = _mm256_or_si256(found,
+                                 _mm256_cmpeq_epi32(block, _mm256_set1_epi32(first[i])));
+      int mask = _mm256_movemask_ps(_mm256_castsi256_ps(found));
+      for (int lane = 0; lane < 8; ++lane)
+         out[k + lane] = ((mask >> lane) & 1) != 0;
+   }
+   for (; k < n; ++k)
+      out[k] = scan_avx2(first, count, keys[k]);
+}
+#endif
+
+// The kernels for this CPU. (__builtin_cpu_init makes the checks safe
+// even when an IntSet is used by another file's static initializers.)
+static scan_kernel pick_scan()
+{
+#ifdef INTSET_X86_KERNELS
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2")) return scan_avx2;
+   if (__builtin_cpu_supports("sse2")) return scan_sse2;
+#endif
+   return scan_plain;
+}
+
+static scan_many_kernel pick_scan_many()
+{
+#ifdef INTSET_X86_KERNELS
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2")) return scan_many_avx2;
+   if (__builtin_cpu_supports("sse2")) return scan_many_sse2;
+#endif
+   return scan_many_plain;
+}
+
+static bool scan_members(const int* first, int count, int key)
+{
+   static const scan_kernel kernel = pick_scan();
+   return kernel(first, count, key);
+}
+
+static void scan_many_members(const int* first, int count,
+                              const int* keys, size_t n, bool* out)
+{
+   static const scan_many_kernel kernel = pick_scan_many();
+   kernel(first, count, keys, n, out);
+}
+
+// How many keys ahead contains_many prefetches index slots.
+static const size_t PREFETCH_AHEAD = 8;
+
+// The growth used when no policy is given (the original 1.5x + 1).
+static growth_policy* default_intset_growth()
+{
+   static geometric_growth policy(1.5, 1);
+   return &policy;
+}
 
 // Resizes the internal data array to the given capacity.
 void IntSet::resize(int new_capacity)
 {
+   compact();
+   int old_capacity = capacity;
    capacity = (new_capacity <= 0) ? DEFAULT_CAPACITY : (new_capacity < used) ? used : new_capacity;
 
-   int* new_data = new int[capacity];
+   int* new_data = allocate_items<int>(*policy, capacity);
 
    for(int index = 0; index < used; ++index) {
       new_data[index] = data[index];
    }
 
-   delete [] data;
+   deallocate_items(*policy, data, old_capacity);
    data = new_data;
+   stats.record_reallocation(capacity);
+}
+
+// Replaces the hash index with an empty table of the given size
+// and re-adds every member.
+void IntSet::rebuild_index(int new_index_capacity)
+{
+   compact();
+   index_slot* new_index = allocate_items<index_slot>(*policy, new_index_capacity);
+   deallocate_items(*policy, index, index_capacity);
+   index = new_index;
+   index_capacity = new_index_capacity;
+   for (int i = 0; i < index_capacity; ++i)
+      index[i].dist = -1;
+   for (int i = 0; i < used; ++i)
+      index_insert(data[i], i);
+}
+
+// Robin Hood lookup: the probe can stop as soon as it reaches a
+// slot whose key is closer to its home than anInt would be.
+bool IntSet::index_find(int anInt) const
+{
+   int mask = index_capacity - 1;
+   int slot = index_home(anInt, index_capacity);
+   for (int dist = 0; index[slot].dist >= dist; ++dist)
+   {
+      if (index[slot].key == anInt) return true;
+      slot = (slot + 1) & mask;
+   }
+   return false;
+}
+
+// Same probe as index_find, but says where the key is.
+int IntSet::index_lookup(int anInt) const
+{
+   int mask = index_capacity - 1;
+   int slot = index_home(anInt, index_capacity);
+   for (int dist = 0; index[slot].dist >= dist; ++dist)
+   {
+      if (index[slot].key == anInt) return slot;
+      slot = (slot + 1) & mask;
+   }
+   return -1;
+}
+
+// Robin Hood insert: a key that is farther from home than the
+// resident of a slot takes that slot, and the resident moves on.
+void IntSet::index_insert(int anInt, int position)
+{
+   int mask = index_capacity - 1;
+   int slot = index_home(anInt, index_capacity);
+   index_slot entry = { anInt, 0, position };
+   while (index[slot].dist >= 0)
+   {
+      if (index[slot].dist < entry.dist)
+      {
+         index_slot resident = index[slot];
+         index[slot] = entry;
+         entry = resident;
+      }
+      slot = (slot + 1) & mask;
+      ++entry.dist;
+   }
+   index[slot] = entry;
+}
+
+// Backward-shift delete: pull the rest of the probe run back one
+// slot so lookups never need tombstones.
+void IntSet::index_erase(int slot)
+{
+   int mask = index_capacity - 1;
+   int next = (slot + 1) & mask;
+   while (index[next].dist > 0)
+   {
+      index[slot] = index[next];
+      --index[slot].dist;
+      slot = next;
+      next = (next + 1) & mask;
+   }
+   index[slot].dist = -1;
+}
+
+// Squeezes out the holes remove left in data: a member is the data
+// element its index slot points back at.
+void IntSet::compact() const
+{
+   if (holes == 0) return;
+
+   int kept = 0;
+   for (int i = 0; i < used; ++i) {
+      int slot = index_lookup(data[i]);
+      if (slot >= 0 && index[slot].pos == i) {
+         data[kept] = data[i];
+         index[slot].pos = kept;
+         ++kept;
+      }
+   }
+   used = kept;
+   holes = 0;
+}
+
+// Grows data and the index once for n members.
+void IntSet::reserve_members(int n)
+{
+   compact();
+   if (n > capacity)
+      resize(int(policy->next_capacity(capacity, n, sizeof(int))));
+   if (n >= INDEX_MIN_ITEMS) {
+      int slots = index_size_for(n);
+      if (slots > index_capacity)
+         rebuild_index(slots);
+   }
+}
+
+// Adds a known non-member into room that has already been made.
+void IntSet::append_new(int anInt)
+{
+   data[used] = anInt;
+   ++used;
+   if (index != NULL) index_insert(anInt, used - 1);
+}
+
+// Matches the index to data after data was rewritten in place.
+void IntSet::refresh_index()
+{
+   if (used >= INDEX_MIN_ITEMS) {
+      rebuild_index(index_size_for(used));
+   } else {
+      deallocate_items(*policy, index, index_capacity);
+      index = NULL;
+      index_capacity = 0;
+   }
 }
 
 // Constructor that initializes the set with a given capacity.
-IntSet::IntSet(int initial_capacity) : capacity(initial_capacity), used(0)
+IntSet::IntSet(int initial_capacity, growth_policy* policy) : capacity(initial_capacity), used(0), holes(0), policy(policy), index(NULL), index_capacity(0)
 { 
    //Capacity is a private int so it needs to be yoinked, hence : capacity in init
    capacity = (initial_capacity <= 0) ? DEFAULT_CAPACITY : capacity;
-   data = new int[capacity];
+   if (policy == NULL) this->policy = default_intset_growth();
+   data = allocate_items<int>(*this->policy, capacity);
+   stats.record_allocation(capacity);
 }
 
 // Copy constructor that creates a new set from an existing one.
-IntSet::IntSet(const IntSet& src) : capacity(src.capacity), used(src.used)
+IntSet::IntSet(const IntSet& src) : capacity(src.capacity), used(0), holes(0), policy(src.policy), index(NULL), index_capacity(0)
 {
-   data = new int[capacity];
+   src.compact();
+   used = src.used;
+   data = allocate_items<int>(*policy, capacity);
+   stats.record_allocation(capacity);
 
-   for(int i = 0; i < capacity; ++i){
+   for(int i = 0; i < used; ++i){
       data[i] = src.data[i];
    }
+
+   if (src.index != NULL) {
+      index = allocate_items<index_slot>(*policy, src.index_capacity);
+      index_capacity = src.index_capacity;
+      for (int i = 0; i < index_capacity; ++i)
+         index[i] = src.index[i];
+   }
 }
 
 // Destructor that deallocates the internal data array.
 IntSet::~IntSet()
 {
-   delete [] data;
+   deallocate_items(*policy, data, capacity);
    data = NULL;
+   deallocate_items(*policy, index, index_capacity);
+   index = NULL;
 }
 
 // Overloaded assignment operator to assign one set to another.
@@ -122,18 +549,35 @@ IntSet::~IntSet()
 IntSet& IntSet::operator=(const IntSet& rhs)
 {
    if (this != &rhs){
-
-      int* temp_data = new int[rhs.capacity];
+      rhs.compact();
+
+      int* temp_data = allocate_items<int>(*policy, rhs.capacity);
+      index_slot* temp_index = NULL;
+      if (rhs.index != NULL) {
+         try {
+            temp_index = allocate_items<index_slot>(*policy, rhs.index_capacity);
+         } catch (...) {
+            deallocate_items(*policy, temp_data, rhs.capacity);
+            throw;
+         }
+         for (int i = 0; i < rhs.index_capacity; ++i)
+            temp_index[i] = rhs.index[i];
+      }
 
       for (int i = 0; i < rhs.used; ++i) {
          temp_data[i] = rhs.data[i];
       }
 
-      delete [] data;
+      deallocate_items(*policy, data, capacity);
+      stats.record_reallocation(rhs.capacity);
+      deallocate_items(*policy, index, index_capacity);
 
       data = temp_data;
       capacity = rhs.capacity;
       used = rhs.used;
+      holes = 0;
+      index = temp_index;
+      index_capacity = rhs.index_capacity;
    }
    return *this;
 }
@@ -141,7 +585,7 @@ IntSet& IntSet::operator=(const IntSet& rhs)
 // Returns the number of elements in the set.
 int IntSet::size() const
 {
-   return used;
+   return used - holes;
 }
 
 // Checks if the set is empty.
@@ -149,16 +593,35 @@ int IntSet::size() const
 
 bool IntSet::isEmpty() const
 {
-   return used == 0;
+   return size() == 0;
 }
 
 // Checks if the set contains a specific integer.
+// O(1) through the hash index once the set is big enough to have one.
 bool IntSet::contains(int anInt) const
 {
-   for(int i = 0; (i < used) && (used > 0); ++i){
-      if(data[i] == anInt) return true;
+   if (index != NULL) return index_find(anInt);
+   return scan_members(data, used, anInt);
+}
+
+// Checks a batch of ints. Without an index, all the keys are compared
+// against the members block by block; with one, the home slot of each
+// key is prefetched a few keys before it is probed, so the cache misses
+// of a big table overlap instead of coming one after another.
+void IntSet::contains_many(const int* keys, size_t n, bool* out) const
+{
+   if (index == NULL) {
+      scan_many_members(data, used, keys, n, out);
+      return;
+   }
+
+   for (size_t i = 0; i < n; ++i) {
+#if defined(__GNUC__) || defined(__clang__)
+      if (i + PREFETCH_AHEAD < n)
+         __builtin_prefetch(&index[index_home(keys[i + PREFETCH_AHEAD], index_capacity)]);
+#endif
+      out[i] = index_find(keys[i]);
    }
-   return false;
 }
 
 // Checks if the current set is a subset of another set.
@@ -178,6 +641,7 @@ bool IntSet::isSubsetOf(const IntSet& otherIntSet) const
       return true;
    } else {
 
+   compact();
    for(int i = 0; i < used; i++){
       if(!otherIntSet.contains(data[i]))
          return false;
@@ -189,6 +653,7 @@ bool IntSet::isSubsetOf(const IntSet& otherIntSet) const
 // Dumps the data of the set to an output stream.
 void IntSet::DumpData(ostream& out) const
 {  // already implemented ... DON'T change anything
+   compact();   // (except this: squeeze out remove's holes first)
    if (used > 0)
    {
       out << data[0];
@@ -198,53 +663,111 @@ void IntSet::DumpData(ostream& out) const
 }
 
 // Returns a new set that is the union of the current set and another set.
+// The result is sized for both sets up front and filled in one pass.
 IntSet IntSet::unionWith(const IntSet& otherIntSet) const
 {
-   IntSet unionIntSet = (*this);
+   compact();
+   otherIntSet.compact();
+   IntSet unionIntSet(used + otherIntSet.used, policy);
+   unionIntSet.reserve_members(used + otherIntSet.used);
 
-   int sizeOtherInt = otherIntSet.size();
-
-   for (int i = 0; i < sizeOtherInt; ++i) {
+   for (int i = 0; i < used; ++i) {
+      unionIntSet.append_new(data[i]);
+   }
+   for (int i = 0; i < otherIntSet.used; ++i) {
       if(!unionIntSet.contains(otherIntSet.data[i]))
-         unionIntSet.add(otherIntSet.data[i]);
+         unionIntSet.append_new(otherIntSet.data[i]);
    }
    return unionIntSet;
 }
 
 // Returns a new set that is the intersection of the current set and another set.
+// Built by keeping the members of this set (in their order) that are
+// also in the other one, so it is O(n) rather than a remove per miss.
 IntSet IntSet::intersect(const IntSet& otherIntSet) const
 {
-   IntSet interSet = (*this);
-
-   int sizeOtherInt = otherIntSet.size();
-
-   for (int i = 0; i < sizeOtherInt; i++) {
-      if(!otherIntSet.contains(data[i])){
-         interSet.remove(data[i]);
+   compact();
+   int most = (used < otherIntSet.used) ? used : otherIntSet.used;
+   IntSet interSet(most, policy);
+   interSet.reserve_members(most);
+
+   for (int i = 0; i < used; i++) {
+      if(otherIntSet.contains(data[i])){
+         interSet.append_new(data[i]);
       }
    }
    return interSet;
 }
 
 // Returns a new set that is the subtraction of another set from the current set.
+// Built by keeping the members of this set (in their order) that are
+// not in the other one.
 IntSet IntSet::subtract(const IntSet& otherIntSet) const
 {
-   IntSet subSet = (*this);
-   int sizeOtherInt = otherIntSet.size();
+   compact();
+   IntSet subSet(used, policy);
+   subSet.reserve_members(used);
 
-   for(int i = 0; i < sizeOtherInt; ++i){
-      if(subSet.contains(otherIntSet.data[i])){
-         subSet.remove(otherIntSet.data[i]);
+   for(int i = 0; i < used; ++i){
+      if(!otherIntSet.contains(data[i])){
+         subSet.append_new(data[i]);
       }
    }
    return subSet;
 }
 
+// Union in place: just a bulk add of the other set's members.
+void IntSet::unionInPlace(const IntSet& otherIntSet)
+{
+   if (this == &otherIntSet) return;
+   otherIntSet.compact();
+   bulk_add(otherIntSet.data, otherIntSet.used);
+}
+
+// Keep the members that are in the other set, sliding them down over
+// the ones that are not (one pass), then rebuild the index once.
+void IntSet::intersectInPlace(const IntSet& otherIntSet)
+{
+   if (this == &otherIntSet) return;
+
+   compact();
+   int kept = 0;
+   for (int i = 0; i < used; ++i) {
+      if (otherIntSet.contains(data[i]))
+         data[kept++] = data[i];
+   }
+   if (kept == used) return;
+   used = kept;
+   refresh_index();
+}
+
+void IntSet::subtractInPlace(const IntSet& otherIntSet)
+{
+   if (this == &otherIntSet) {
+      reset();
+      return;
+   }
+
+   compact();
+   int kept = 0;
+   for (int i = 0; i < used; ++i) {
+      if (!otherIntSet.contains(data[i]))
+         data[kept++] = data[i];
+   }
+   if (kept == used) return;
+   used = kept;
+   refresh_index();
+}
+
 // Resets the set to be empty.
 // Observes invariant?
 void IntSet::reset()
 {
    used = 0;
+   holes = 0;
+   deallocate_items(*policy, index, index_capacity);
+   index = NULL;
+   index_capacity = 0;
 }
 
 // Adds an integer to the set if it's not already present.
@@ -252,31 +775,86 @@ bool IntSet::add(int anInt)
 {
    if(!contains(anInt)){
       if(used >= capacity){
-         resize(int(capacity * 1.5) + 1); // as per special requirements
+         // reuse remove's holes when they are a good part of data
+         // (so the O(n) pass pays for itself), otherwise grow
+         if (holes * 4 >= used)
+            compact();
+         else
+            resize(int(policy->next_capacity(capacity, used + 1, sizeof(int))));
       }
-      
+      if (index != NULL && (size() + 1) * 4 > index_capacity * 3)
+         rebuild_index(index_capacity * 2);
+
       data[used] = anInt;
       ++used;
+
+      if (index != NULL) {
+         index_insert(anInt, used - 1);
+      } else if (used >= INDEX_MIN_ITEMS) {
+         rebuild_index(4 * INDEX_MIN_ITEMS);
+      }
       return true;
    }
    return false;
 }
 
-// Removes an integer from the set if it's present. Shift by 1.
+// Adds a run of ints, making room for all of them once.
+int IntSet::bulk_add(const int* values, int count)
+{
+   reserve_members(size() + count);
+
+   int added = 0;
+   for (int i = 0; i < count; ++i) {
+      if (!contains(values[i])) {
+         append_new(values[i]);
+         ++added;
+      }
+   }
+   return added;
+}
+
+// Removes an integer from the set if it's present. A small set
+// (no index) shifts by 1; an indexed one leaves a hole in data, so
+// the cost is one index probe whatever the size.
 bool IntSet::remove(int anInt)
 {
-   if(contains(anInt)){
+   if (index == NULL) {
       for(int i = 0; i < used; ++i){
          if(data[i] == anInt) {
             for(int j = i; j < used - 1; ++j) {
                data[j] = data[j + 1];
             }
             --used;
-            return true; 
+            return true;
          }
       }
+      return false;
    }
-   return false;
+
+   int slot = index_lookup(anInt);
+   if (slot < 0) return false;
+   int position = index[slot].pos;
+   index_erase(slot);
+   if (position == used - 1)
+      --used;
+   else
+      ++holes;
+   if (used == holes)
+      used = holes = 0;
+   return true;
+}
+
+// The members themselves, data[0] .. data[used - 1].
+const int* IntSet::members() const
+{
+   compact();
+   return data;
+}
+
+// reallocation count and peak capacity so far
+const growth_stats& IntSet::growth() const
+{
+   return stats;
 }
 
 // Checks if two sets are empty, then equal.
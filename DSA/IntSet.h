@@ -0,0 +1,219 @@
+// FILE: IntSet.h - header file for IntSet class
+// CLASS PROVIDED: IntSet (a set of int values that remembers the order
+//                 in which its members joined)
+//
+// STORAGE:
+//   The members are kept in a dynamic array in membership order. Once
+//   the set has a few dozen members they are also kept in a hash index
+//   (see IntSet-1.cpp), so contains, add and remove take O(1) expected
+//   time instead of a scan of the array; the index never changes the
+//   membership order that DumpData shows. remove leaves a hole in the
+//   array instead of closing it up; the holes are squeezed out in one
+//   O(n) pass when the array is about to grow or is next read as a
+//   whole (DumpData, members, the set algebra, copies).
+//   Because of that pass, even the const member functions change the
+//   array, so an IntSet shared between threads needs a lock around
+//   every call, not only around the mutators.
+//
+// CONSTANT for the IntSet class:
+//   static const int DEFAULT_CAPACITY = ____
+//     IntSet::DEFAULT_CAPACITY is the initial capacity of an IntSet
+//     that is created by the default constructor (and the smallest
+//     capacity an IntSet ever has).
+//
+// CONSTRUCTOR for the IntSet class:
+//   IntSet(int initial_capacity = DEFAULT_CAPACITY,
+//          CS3358_FA2023::growth_policy* policy = 0)
+//     Pre:  policy is NULL or outlives the IntSet (it is not owned).
+//     Post: The invoking IntSet is initialized to an empty IntSet
+//           (i.e., one containing no relevant elements) with room for
+//           initial_capacity members (DEFAULT_CAPACITY if
+//           initial_capacity <= 0). The array, and every later one, is
+//           obtained from and sized by policy (see growthPolicy.h); the
+//           hash index is obtained from policy too. A NULL policy means
+//           geometric_growth(1.5, 1), which grows a full array to
+//           1.5 * capacity + 1.
+//
+// CONSTANT MEMBER FUNCTIONS (ACCESSORS) for the IntSet class:
+//   int size() const
+//     Pre:  (none)
+//     Post: Number of elements in the invoking IntSet is returned.
+//   bool isEmpty() const
+//     Pre:  (none)
+//     Post: True is returned if the invoking IntSet has no relevant
+//           elements, otherwise false is returned.
+//   bool contains(int anInt) const
+//     Pre:  (none)
+//     Post: true is returned if the invoking IntSet has anInt as an
+//           element, otherwise false is returned.
+//   bool isSubsetOf(const IntSet& otherIntSet) const
+//     Pre:  (none)
+//     Post: True is returned if all elements of the invoking IntSet
+//           are also elements of otherIntSet, otherwise false is
+//           returned.
+//           By definition, true is returned if the invoking IntSet
+//           is empty (i.e., an empty IntSet is always isSubsetOf
+//           another IntSet, even if the other IntSet is also empty).
+//   void DumpData(std::ostream& out) const
+//     Pre:  (none)
+//     Post: Contents of the invoking IntSet is inserted into out
+//           with 2 spaces separating one element from another if
+//           there are 2 or more elements.
+//   IntSet unionWith(const IntSet& otherIntSet) const
+//     Pre:  (none)
+//     Post: An IntSet representing the union of the invoking IntSet
+//           and otherIntSet is returned.
+//           Note: Equivalently (see postcondition of add), the IntSet
+//                 returned is one that initially is an exact copy of
+//                 the invoking IntSet but subsequently has all elements
+//                 of otherIntSet added.
+//   IntSet intersect(const IntSet& otherIntSet) const
+//     Pre:  (none)
+//     Post: An IntSet representing the intersection of the invoking
+//           IntSet and otherIntSet is returned.
+//           Note: Equivalently (see postcondition of remove), the
+//                 IntSet returned is one that initially is an exact
+//                 copy of the invoking IntSet but subsequently has all
+//                 of its elements that are not also elements of
+//                 otherIntSet removed.
+//   IntSet subtract(const IntSet& otherIntSet) const
+//     Pre:  (none)
+//     Post: An IntSet representing the difference between the invoking
+//           IntSet and otherIntSet is returned.
+//           Note: Equivalently (see postcondition of remove), the
+//                 IntSet returned is one that initially is an exact
+//                 copy of the invoking IntSet but subsequently has all
+//                 elements of otherIntSet removed.
+//   void contains_many(const int* keys, std::size_t n, bool* out) const
+//     Pre:  keys points at n ints and out at room for n bools.
+//     Post: out[i] is contains(keys[i]) for each i < n. Small
+//           (unindexed) sets compare a block of keys against every
+//           member at once with SIMD compares; indexed sets prefetch
+//           the slots of later keys while probing earlier ones.
+//   const int* members() const
+//     Pre:  (none)
+//     Post: A pointer to the size() members, in membership order, has
+//           been returned (for bulk readers such as RoaringIntSet). It
+//           is invalidated by any change to the IntSet.
+//   const CS3358_FA2023::growth_stats& growth() const
+//     Pre:  (none)
+//     Post: The return value holds the number of reallocations and the
+//           peak capacity of this IntSet.
+//
+// MODIFICATION MEMBER FUNCTIONS (MUTATORS) for the IntSet class:
+//   void reset()
+//     Pre:  (none)
+//     Post: The invoking IntSet is reset to become an empty IntSet.
+//   bool add(int anInt)
+//     Pre:  (none)
+//     Post: If contains(anInt) returns false, anInt has been added to
+//           the invoking IntSet as a new element and true is returned,
+//           otherwise the invoking IntSet is unchanged and false is
+//           returned.
+//   bool remove(int anInt)
+//     Pre:  (none)
+//     Post: If contains(anInt) returns true, anInt has been removed
+//           from the invoking IntSet and true is returned, otherwise
+//           the invoking IntSet is unchanged and false is returned.
+//   int bulk_add(const int* values, int count)
+//     Pre:  values points at count ints (not into this IntSet's own
+//           members).
+//     Post: Each of the values that was not yet a member has been
+//           added, in the order given; the number added has been
+//           returned. Room for all count values is made once, up
+//           front, so this costs O(count) (vs. repeated growth with
+//           add()).
+//   void unionInPlace(const IntSet& otherIntSet)
+//   void intersectInPlace(const IntSet& otherIntSet)
+//   void subtractInPlace(const IntSet& otherIntSet)
+//     Pre:  (none)
+//     Post: The invoking IntSet has become its union with /
+//           intersection with / difference from otherIntSet (what
+//           unionWith / intersect / subtract would return), without a
+//           copy being made. Members keep their relative membership
+//           order; union members new to the set come after them, in
+//           otherIntSet's order. O(n + m).
+//
+// NON-MEMBER FUNCTIONS for the IntSet class:
+//   bool operator==(const IntSet& is1, const IntSet& is2)
+//     Pre:  (none)
+//     Post: True is returned if is1 and is2 have the same elements
+//           (whatever their order), otherwise false is returned.
+//
+// VALUE SEMANTICS for the IntSet class:
+//   Assignments and the copy constructor may be used with IntSet
+//   objects. A copy uses the source's policy; assignment keeps its own.
+//
+// DYNAMIC MEMORY USAGE by the IntSet class:
+//   If there is insufficient dynamic memory, the following functions
+//   throw bad_alloc: the constructors, add, bulk_add, unionWith,
+//   intersect, subtract, unionInPlace, and the assignment operator.
+
+#ifndef INTSET_H
+#define INTSET_H
+
+#include <cstdlib>    // provides size_t
+#include <iostream>   // provides ostream
+#include "growthPolicy.h"
+
+class IntSet
+{
+public:
+   static const int DEFAULT_CAPACITY = 1;
+
+   IntSet(int initial_capacity = DEFAULT_CAPACITY,
+          CS3358_FA2023::growth_policy* policy = 0);
+   IntSet(const IntSet& src);
+   ~IntSet();
+   IntSet& operator=(const IntSet& rhs);
+
+   int size() const;
+   bool isEmpty() const;
+   bool contains(int anInt) const;
+   void contains_many(const int* keys, std::size_t n, bool* out) const;
+   bool isSubsetOf(const IntSet& otherIntSet) const;
+   void DumpData(std::ostream& out) const;
+   IntSet unionWith(const IntSet& otherIntSet) const;
+   IntSet intersect(const IntSet& otherIntSet) const;
+   IntSet subtract(const IntSet& otherIntSet) const;
+   const int* members() const;
+   const CS3358_FA2023::growth_stats& growth() const;
+
+   void reset();
+   bool add(int anInt);
+   bool remove(int anInt);
+   int bulk_add(const int* values, int count);
+   void unionInPlace(const IntSet& otherIntSet);
+   void intersectInPlace(const IntSet& otherIntSet);
+   void subtractInPlace(const IntSet& otherIntSet);
+
+private:
+   int* data;
+   int capacity;
+   mutable int used;
+   mutable int holes;
+   CS3358_FA2023::growth_policy* policy;
+   CS3358_FA2023::growth_stats stats;
+   struct index_slot
+   {
+      int key;
+      int dist;      // distance from the key's home slot; -1 if empty
+      int pos;       // where key is in data
+   };
+   index_slot* index;
+   int index_capacity;
+   void resize(int new_capacity);
+   void rebuild_index(int new_index_capacity);
+   bool index_find(int anInt) const;
+   int index_lookup(int anInt) const;
+   void index_insert(int anInt, int position);
+   void index_erase(int slot);
+   void compact() const;
+   void reserve_members(int n);
+   void append_new(int anInt);
+   void refresh_index();
+};
+
+bool operator==(const IntSet& is1, const IntSet& is2);
+
+#endif
@@ -0,0 +1,545 @@
+// FILE: IntSetIO.cpp
+// IMPLEMENTS: intset_save, intset_load and IntSetView (see IntSetIO.h
+//             for documentation and the file format)
+// INVARIANT for the IntSetView class:
+//   1. If the view is closed, base is NULL and length, count and
+//      block_count are 0.
+//   2. If it is open, base points at the length bytes of a file whose
+//      header passed check_layout: count members in block_count
+//      blocks, block_index at base + HEADER_BYTES, and the sorted
+//      section (sorted_bytes long) right after the index. mapped says
+//      whether base must be munmap'ed or delete[]'d.
+//   3. If open was asked to verify the file, both sections decoded
+//      cleanly and hold the same members (see decode_sections).
+//   Otherwise nothing past the header is trusted: contains()
+//   bounds-checks every offset and varint against the section it came
+//   from.
+
+#include "IntSetIO.h"
+#include <algorithm>   // provides sort, min
+#include <climits>     // provides INT_MAX
+#include <cstring>     // provides memcmp
+#include <fstream>     // provides ifstream, ofstream
+#include <stdint.h>    // provides uint32_t, uint64_t
+#include <vector>      // provides vector
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>     // provides open, O_RDONLY
+#include <sys/mman.h>  // provides mmap, munmap
+#include <sys/stat.h>  // provides fstat
+#include <unistd.h>    // provides close
+#define INTSET_IO_MMAP 1
+#endif
+using namespace std;
+
+typedef vector<unsigned char> bytes;
+
+static const char MAGIC[8] = { 'D', 'S', 'A', 'I', 'S', 'E', 'T', '1' };
+static const size_t HEADER_BYTES = 48;
+static const size_t INDEX_ENTRY_BYTES = 8;
+static const uint32_t FLAG_ORDER = 1;
+static const int MAX_VARINT_BYTES = 5;
+static const uint32_t BLOCK = IntSetView::BLOCK_KEYS;
+
+// ===== little-endian fields, varints, checksum =====
+
+static void put_u32(bytes& out, uint32_t v)
+{
+   for (int i = 0; i < 4; ++i)
+      out.push_back((unsigned char)(v >> (8 * i)));
+}
+
+static void put_u64(bytes& out, uint64_t v)
+{
+   for (int i = 0; i < 8; ++i)
+      out.push_back((unsigned char)(v >> (8 * i)));
+}
+
+static uint32_t get_u32(const unsigned char* p)
+{
+   return uint32_t(p[0]) | (uint32_t(p[1]) << 8) |
+          (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+static uint64_t get_u64(const unsigned char* p)
+{
+   return uint64_t(get_u32(p)) | (uint64_t(get_u32(p + 4)) << 32);
+}
+
+static void put_varint(bytes& out, uint64_t v)
+{
+   while (v >= 0x80)
+   {
+      out.push_back((unsigned char)(v | 0x80));
+      v >>= 7;
+   }
+   out.push_back((unsigned char)v);
+}
+
+// Reads one varint from [p, end) into v and moves p past it; false if
+// it runs off the end or is longer than MAX_VARINT_BYTES.
+static bool get_varint(const unsigned char*& p, const unsigned char* end, uint64_t& v)
+{
+   v = 0;
+   for (int i = 0; i < MAX_VARINT_BYTES && p != end; ++i)
+   {
+      unsigned char b = *p++;
+      v |= uint64_t(b & 0x7F) << (7 * i);
+      if ((b & 0x80) == 0) return true;
+   }
+   return false;
+}
+
+// ints sort as unsigned values once the sign bit is flipped
+static uint32_t to_unsigned(int anInt)
+{
+   return uint32_t(anInt) ^ 0x80000000u;
+}
+
+static int to_int(uint32_t u)
+{
+   return int(u ^ 0x80000000u);
+}
+
+static uint64_t zigzag(int64_t d)
+{
+   return (uint64_t(d) << 1) ^ uint64_t(d >> 63);
+}
+
+static int64_t unzigzag(uint64_t z)
+{
+   return int64_t(z >> 1) ^ -int64_t(z & 1);
+}
+
+static uint64_t fnv1a(const unsigned char* p, size_t n)
+{
+   uint64_t h = 14695981039346656037ULL;
+   for (size_t i = 0; i < n; ++i)
+   {
+      h ^= p[i];
+      h *= 1099511628211ULL;
+   }
+   return h;
+}
+
+// ===== header =====
+
+struct layout
+{
+   uint32_t count;
+   uint32_t block_count;
+   uint32_t flags;
+   uint64_t sorted_bytes;
+   uint64_t order_bytes;
+   uint64_t checksum;
+};
+
+// Decodes and sanity-checks a header. payload_bytes is set to the size
+// of everything after it. The section sizes must fit count keys (one to
+// MAX_VARINT_BYTES bytes per varint), but count itself can be anything
+// up to INT_MAX, so a caller must not allocate payload_bytes before it
+// knows the input really holds that much (see read_payload).
+static bool check_layout(const unsigned char* h, layout& l, uint64_t& payload_bytes)
+{
+   if (memcmp(h, MAGIC, sizeof(MAGIC)) != 0) return false;
+   l.count = get_u32(h + 8);
+   l.block_count = get_u32(h + 12);
+   l.flags = get_u32(h + 16);
+   l.sorted_bytes = get_u64(h + 24);
+   l.order_bytes = get_u64(h + 32);
+   l.checksum = get_u64(h + 40);
+
+   uint64_t most = uint64_t(l.count) * MAX_VARINT_BYTES;
+   uint64_t gaps = uint64_t(l.count) - l.block_count;   // varints in sorted
+   if (l.count > uint32_t(INT_MAX) || get_u32(h + 20) != 0 ||
+       (l.flags & ~FLAG_ORDER) != 0 ||
+       l.block_count != (uint64_t(l.count) + BLOCK - 1) / BLOCK ||
+       l.sorted_bytes < gaps || l.sorted_bytes > gaps * MAX_VARINT_BYTES ||
+       l.order_bytes > most ||
+       ((l.flags & FLAG_ORDER) != 0) != (l.order_bytes > 0) ||
+       (l.order_bytes > 0 && l.order_bytes < l.count))
+      return false;
+
+   payload_bytes = uint64_t(l.block_count) * INDEX_ENTRY_BYTES +
+                   l.sorted_bytes + l.order_bytes;
+   return true;
+}
+
+// ===== save =====
+
+// Builds the whole file in memory: header, then the payload.
+static void encode(const IntSet& s, bool keep_order, bytes& file)
+{
+   const int* members = s.members();
+   int count = s.size();
+
+   vector<uint32_t> keys(count);
+   bool ascending = true;
+   for (int i = 0; i < count; ++i)
+   {
+      keys[i] = to_unsigned(members[i]);
+      if (i > 0 && members[i] < members[i - 1]) ascending = false;
+   }
+   sort(keys.begin(), keys.end());
+
+   uint32_t block_count = (uint32_t(count) + BLOCK - 1) / BLOCK;
+   bytes index, sorted, order;
+   index.reserve(block_count * INDEX_ENTRY_BYTES);
+   for (int i = 0; i < count; ++i)
+   {
+      if (uint32_t(i) % BLOCK == 0)
+      {
+         put_u32(index, keys[i]);
+         put_u32(index, uint32_t(sorted.size()));
+      }
+      else
+         put_varint(sorted, keys[i] - keys[i - 1] - 1);
+   }
+
+   bool with_order = keep_order && !ascending;
+   if (with_order)
+   {
+      int64_t previous = 0;
+      for (int i = 0; i < count; ++i)
+      {
+         put_varint(order, zigzag(int64_t(members[i]) - previous));
+         previous = members[i];
+      }
+   }
+
+   bytes payload;
+   payload.reserve(index.size() + sorted.size() + order.size());
+   payload.insert(payload.end(), index.begin(), index.end());
+   payload.insert(payload.end(), sorted.begin(), sorted.end());
+   payload.insert(payload.end(), order.begin(), order.end());
+
+   file.clear();
+   file.reserve(HEADER_BYTES + payload.size());
+   file.insert(file.end(), MAGIC, MAGIC + sizeof(MAGIC));
+   put_u32(file, uint32_t(count));
+   put_u32(file, block_count);
+   put_u32(file, with_order ? FLAG_ORDER : 0);
+   put_u32(file, 0);
+   put_u64(file, sorted.size());
+   put_u64(file, order.size());
+   put_u64(file, fnv1a(payload.empty() ? 0 : &payload[0], payload.size()));
+   file.insert(file.end(), payload.begin(), payload.end());
+}
+
+bool intset_save(const IntSet& s, ostream& out, bool keep_order)
+{
+   bytes file;
+   encode(s, keep_order, file);
+   out.write(reinterpret_cast<const char*>(&file[0]), streamsize(file.size()));
+   return bool(out);
+}
+
+bool intset_save(const IntSet& s, const char* path, bool keep_order)
+{
+   ofstream out(path, ios::binary | ios::trunc);
+   if (!out) return false;
+   if (!intset_save(s, out, keep_order)) return false;
+   out.close();
+   return !out.fail();
+}
+
+// ===== load =====
+
+// Decodes the sorted section into keys (increasing ints); false if any
+// block is out of place or any varint is bad.
+static bool decode_sorted(const layout& l, const unsigned char* index,
+                          const unsigned char* sorted, vector<int>& keys)
+{
+   const unsigned char* p = sorted;
+   const unsigned char* end = sorted + l.sorted_bytes;
+   keys.clear();
+   keys.reserve(l.count);
+
+   for (uint32_t b = 0; b < l.block_count; ++b)
+   {
+      uint32_t u = get_u32(index + b * INDEX_ENTRY_BYTES);
+      if (get_u32(index + b * INDEX_ENTRY_BYTES + 4) != uint32_t(p - sorted))
+         return false;
+      if (b > 0 && u <= to_unsigned(keys.back()))
+         return false;
+      keys.push_back(to_int(u));
+
+      uint32_t in_block = min(BLOCK, l.count - b * BLOCK);
+      for (uint32_t k = 1; k < in_block; ++k)
+      {
+         uint64_t gap;
+         if (!get_varint(p, end, gap) || uint64_t(u) + gap + 1 > 0xFFFFFFFFull)
+            return false;
+         u = uint32_t(u + gap + 1);
+         keys.push_back(to_int(u));
+      }
+   }
+   return p == end;
+}
+
+// Decodes the order section into keys (membership order).
+static bool decode_order(const layout& l, const unsigned char* order, vector<int>& keys)
+{
+   const unsigned char* p = order;
+   const unsigned char* end = order + l.order_bytes;
+   keys.clear();
+   keys.reserve(l.count);
+
+   int64_t previous = 0;
+   for (uint32_t i = 0; i < l.count; ++i)
+   {
+      uint64_t z;
+      if (!get_varint(p, end, z)) return false;
+      int64_t key = previous + unzigzag(z);
+      if (key < INT_MIN || key > INT_MAX) return false;
+      keys.push_back(int(key));
+      previous = key;
+   }
+   return p == end;
+}
+
+// Decodes both sections into keys (membership order) and checks that
+// they agree: the order section, when there is one, must hold exactly
+// the members of the sorted section (decode_sorted has already checked
+// that those are strictly increasing, so a sorted copy of the order
+// keys must equal them). The checksum only shows that the file is as it
+// was written, not that its writer kept the two in step.
+static bool decode_sections(const layout& l, const unsigned char* index,
+                            const unsigned char* sorted, const unsigned char* order,
+                            vector<int>& keys)
+{
+   if (!decode_sorted(l, index, sorted, keys)) return false;
+   if ((l.flags & FLAG_ORDER) == 0) return true;
+
+   vector<int> in_order;
+   if (!decode_order(l, order, in_order)) return false;
+   vector<int> members(in_order);
+   sort(members.begin(), members.end());
+   if (members != keys) return false;
+   keys.swap(in_order);
+   return true;
+}
+
+// The number of bytes in after the read position, or -1 if in can't
+// tell (it can't seek). The read position is left where it was.
+static streamoff bytes_left(istream& in)
+{
+   streampos here = in.tellg();
+   if (here == streampos(-1)) return -1;
+   in.seekg(0, ios::end);
+   streampos end = in.tellg();
+   in.seekg(here);
+   if (end == streampos(-1) || !in)
+   {
+      in.clear();
+      in.seekg(here);
+      return -1;
+   }
+   return streamoff(end - here);
+}
+
+// Reads exactly n bytes of in into payload; false if in ends first.
+// A stream that can tell how much it holds is checked up front; any
+// other is read READ_CHUNK bytes at a time, so the buffer only ever
+// grows by what was actually read, whatever n a header claims.
+static bool read_payload(istream& in, uint64_t n, bytes& payload)
+{
+   const uint64_t READ_CHUNK = uint64_t(1) << 20;
+   streamoff left = bytes_left(in);
+   if (left >= 0 && uint64_t(left) < n) return false;
+
+   payload.clear();
+   if (left >= 0) payload.reserve(size_t(n) + 1);
+   while (uint64_t(payload.size()) < n)
+   {
+      size_t done = payload.size();
+      size_t step = size_t(min(n - done, READ_CHUNK));
+      payload.resize(done + step);
+      in.read(reinterpret_cast<char*>(&payload[done]), streamsize(step));
+      if (uint64_t(in.gcount()) != step) return false;
+   }
+   payload.push_back(0);   // so &payload[0] is valid when n == 0
+   return true;
+}
+
+bool intset_load(istream& in, IntSet& s)
+{
+   unsigned char header[HEADER_BYTES];
+   layout l;
+   uint64_t payload_bytes;
+   if (!in.read(reinterpret_cast<char*>(header), HEADER_BYTES) ||
+       !check_layout(header, l, payload_bytes))
+      return false;
+
+   bytes payload;
+   if (!read_payload(in, payload_bytes, payload) ||
+       fnv1a(&payload[0], size_t(payload_bytes)) != l.checksum)
+      return false;
+
+   const unsigned char* index = &payload[0];
+   const unsigned char* sorted = index + size_t(l.block_count) * INDEX_ENTRY_BYTES;
+   const unsigned char* order = sorted + l.sorted_bytes;
+
+   vector<int> keys;
+   if (!decode_sections(l, index, sorted, order, keys)) return false;
+
+   // checked into a scratch set first, so a bad file leaves s alone
+   IntSet loaded(int(l.count));
+   if (l.count > 0 && loaded.bulk_add(&keys[0], int(l.count)) != int(l.count))
+      return false;
+   s = loaded;
+   return true;
+}
+
+bool intset_load(const char* path, IntSet& s)
+{
+   ifstream in(path, ios::binary);
+   return in && intset_load(in, s);
+}
+
+// ===== IntSetView =====
+
+const int IntSetView::BLOCK_KEYS;
+
+IntSetView::IntSetView()
+   : base(NULL), length(0), mapped(false), count(0), block_count(0),
+     block_index(NULL), sorted(NULL), sorted_bytes(0)
+{
+}
+
+IntSetView::~IntSetView()
+{
+   close();
+}
+
+bool IntSetView::open(const char* path, bool verify_checksum)
+{
+   close();
+
+#ifdef INTSET_IO_MMAP
+   int fd = ::open(path, O_RDONLY);
+   if (fd < 0) return false;
+   struct stat info;
+   if (fstat(fd, &info) != 0 || info.st_size < off_t(HEADER_BYTES))
+   {
+      ::close(fd);
+      return false;
+   }
+   void* p = mmap(NULL, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+   ::close(fd);
+   if (p == MAP_FAILED) return false;
+   base = static_cast<const unsigned char*>(p);
+   length = size_t(info.st_size);
+   mapped = true;
+#else
+   ifstream in(path, ios::binary | ios::ate);
+   if (!in) return false;
+   streamoff size = in.tellg();
+   if (size < streamoff(HEADER_BYTES)) return false;
+   unsigned char* copy = new unsigned char[size_t(size)];
+   in.seekg(0);
+   if (!in.read(reinterpret_cast<char*>(copy), size))
+   {
+      delete [] copy;
+      return false;
+   }
+   base = copy;
+   length = size_t(size);
+   mapped = false;
+#endif
+
+   layout l;
+   uint64_t payload_bytes;
+   if (!check_layout(base, l, payload_bytes) ||
+       payload_bytes != uint64_t(length - HEADER_BYTES) ||
+       (verify_checksum && fnv1a(base + HEADER_BYTES, length - HEADER_BYTES) != l.checksum))
+   {
+      close();
+      return false;
+   }
+
+   count = int(l.count);
+   block_count = int(l.block_count);
+   block_index = base + HEADER_BYTES;
+   sorted = block_index + size_t(block_count) * INDEX_ENTRY_BYTES;
+   sorted_bytes = size_t(l.sorted_bytes);
+
+   // the full check decodes every key, as intset_load would
+   vector<int> keys;
+   if (verify_checksum &&
+       !decode_sections(l, block_index, sorted, sorted + sorted_bytes, keys))
+   {
+      close();
+      return false;
+   }
+   return true;
+}
+
+void IntSetView::close()
+{
+   if (base != NULL)
+   {
+#ifdef INTSET_IO_MMAP
+      if (mapped)
+         munmap(const_cast<unsigned char*>(base), length);
+      else
+#endif
+         delete [] base;
+   }
+   base = NULL;
+   length = 0;
+   mapped = false;
+   count = 0;
+   block_count = 0;
+   block_index = NULL;
+   sorted = NULL;
+   sorted_bytes = 0;
+}
+
+bool IntSetView::is_open() const
+{
+   return base != NULL;
+}
+
+int IntSetView::size() const
+{
+   return count;
+}
+
+// Binary search for the last block starting at or below anInt, then
+// walk that block's gaps until they reach or pass it.
+bool IntSetView::contains(int anInt) const
+{
+   uint32_t target = to_unsigned(anInt);
+   int lo = 0, hi = block_count;           // first block with first key > target
+   while (lo < hi)
+   {
+      int mid = lo + (hi - lo) / 2;
+      if (get_u32(block_index + size_t(mid) * INDEX_ENTRY_BYTES) <= target)
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+   if (lo == 0) return false;
+
+   int b = lo - 1;
+   const unsigned char* entry = block_index + size_t(b) * INDEX_ENTRY_BYTES;
+   uint32_t u = get_u32(entry);
+   if (u == target) return true;
+
+   size_t start = get_u32(entry + 4);
+   size_t stop = (b + 1 < block_count) ? get_u32(entry + INDEX_ENTRY_BYTES + 4) : sorted_bytes;
+   if (start > stop || stop > sorted_bytes) return false;
+
+   const unsigned char* p = sorted + start;
+   const unsigned char* end = sorted + stop;
+   int in_block = min(BLOCK_KEYS, count - b * BLOCK_KEYS);
+   for (int k = 1; k < in_block; ++k)
+   {
+      uint64_t gap;
+      if (!get_varint(p, end, gap)) return false;
+      uint64_t next = uint64_t(u) + gap + 1;
+      if (next >= target) return next == target;
+      u = uint32_t(next);
+   }
+   return false;
+}
@@ -0,0 +1,118 @@
+// FILE: IntSetIO.h
+// FUNCTIONS AND CLASS PROVIDED: a compact binary file format for IntSet
+//   (intset_save / intset_load) and IntSetView, which answers size()
+//   and contains() straight from a saved file mapped into memory,
+//   without building an IntSet.
+//
+// FILE FORMAT (all integers little-endian):
+//   header, 48 bytes:
+//     magic          8 bytes  "DSAISET1"
+//     count          uint32   number of members
+//     block_count    uint32   (count + BLOCK_KEYS - 1) / BLOCK_KEYS
+//     flags          uint32   bit 0: an order section follows
+//     reserved       uint32   0
+//     sorted_bytes   uint64   size of the sorted section
+//     order_bytes    uint64   size of the order section (0 if none)
+//     checksum       uint64   64-bit FNV-1a hash of everything after
+//                             the header
+//   block index, 8 bytes per block:
+//     first key (as uint32 u = key ^ 0x80000000) and the offset of the
+//     block's data in the sorted section, both uint32
+//   sorted section:
+//     the members in increasing order, BLOCK_KEYS per block; after a
+//     block's first key (which is in the index) each key is stored as
+//     the varint of (u - previous u - 1), so dense sets take about one
+//     byte per member
+//   order section (only if flags bit 0 is set):
+//     the members in membership order, each as the varint of the
+//     zigzag-coded difference from the one before (starting from 0)
+//
+//   A varint is 7 bits per byte, low bits first, with the top bit set
+//   on every byte but the last (at most 5 bytes for 32 bits).
+//
+// FUNCTIONS PROVIDED:
+//   bool intset_save(const IntSet& s, std::ostream& out, bool keep_order = true)
+//   bool intset_save(const IntSet& s, const char* path, bool keep_order = true)
+//     Pre:  (none)
+//     Post: s has been written to out (or the file path, replaced if it
+//           exists) in the format above, and true has been returned;
+//           false has been returned if writing failed. The order
+//           section is written only if keep_order is true and s's
+//           membership order is not already increasing.
+//   bool intset_load(std::istream& in, IntSet& s)
+//   bool intset_load(const char* path, IntSet& s)
+//     Pre:  (none)
+//     Post: If a valid saved set (right magic, sizes, checksum and
+//           encoding, with the order section holding exactly the
+//           members of the sorted section) was read, s holds its members -- in their saved
+//           membership order if there was an order section, otherwise
+//           in increasing order -- and true has been returned.
+//           Otherwise false has been returned and s is unchanged.
+//           Memory is only allocated for bytes that are really there,
+//           so a header that claims more than in holds costs nothing.
+//
+// CLASS PROVIDED: IntSetView (a read-only saved set)
+//   IntSetView()
+//     Post: The view is closed (size() is 0).
+//   bool open(const char* path, bool verify_checksum = true)
+//     Post: Any file already open has been closed. If path holds a
+//           valid saved set, it has been mapped into memory (read into
+//           memory where mmap is not available) and true has been
+//           returned; otherwise false has been returned and the view
+//           is closed. With verify_checksum true the whole file is
+//           checked as by intset_load (checksum, encoding, and the
+//           order and sorted sections holding the same members). With
+//           verify_checksum false those passes are skipped, so opening
+//           costs O(1) and pages are read as contains() touches them;
+//           decoding is still bounds-checked.
+//   void close()
+//     Post: The file has been unmapped; the view is closed.
+//   bool is_open() const
+//   int size() const
+//     Post: Whether a file is open / the number of members saved.
+//   bool contains(int anInt) const
+//     Post: true has been returned if anInt is a saved member (a binary
+//           search of the block index, then decoding at most one block
+//           of BLOCK_KEYS keys).
+//   IntSetView can't be copied; the destructor closes it.
+
+#ifndef INT_SET_IO_H
+#define INT_SET_IO_H
+
+#include <cstdlib>   // provides size_t
+#include <iostream>  // provides istream, ostream
+#include "IntSet.h"
+
+bool intset_save(const IntSet& s, std::ostream& out, bool keep_order = true);
+bool intset_save(const IntSet& s, const char* path, bool keep_order = true);
+bool intset_load(std::istream& in, IntSet& s);
+bool intset_load(const char* path, IntSet& s);
+
+class IntSetView
+{
+public:
+   static const int BLOCK_KEYS = 128;
+
+   IntSetView();
+   ~IntSetView();
+   bool open(const char* path, bool verify_checksum = true);
+   void close();
+   bool is_open() const;
+   int size() const;
+   bool contains(int anInt) const;
+
+private:
+   const unsigned char* base;        // the whole file
+   std::size_t length;
+   bool mapped;                      // base came from mmap (else new[])
+   int count;
+   int block_count;
+   const unsigned char* block_index; // block_count 8-byte entries
+   const unsigned char* sorted;      // the sorted section
+   std::size_t sorted_bytes;
+
+   IntSetView(const IntSetView&) = delete;
+   IntSetView& operator=(const IntSetView&) = delete;
+};
+
+#endif
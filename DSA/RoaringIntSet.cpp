@@ -0,0 +1,662 @@
+// FILE: RoaringIntSet.cpp
+//       Implementation file for the RoaringIntSet class
+//       (See RoaringIntSet.h for documentation.)
+// INVARIANT for the RoaringIntSet class:
+// (1) An int x is stored as the unsigned 32-bit value
+//     u = x ^ 0x80000000 (so increasing ints are increasing u); the
+//     high 16 bits of u pick the chunk, the low 16 bits ("lows") are
+//     stored in that chunk's container.
+// (2) chunks holds one chunk per high-16-bit key that has at least one
+//     member, in increasing key order; each chunk's card is the number
+//     of its members and used is the sum of the cards.
+// (3) An ARRAY chunk has card <= ARRAY_MAX and values holds its lows
+//     in increasing order; words is empty.
+//     A BITMAP chunk has card > ARRAY_MAX and words holds 1024 words,
+//     bit (low % 64) of words[low / 64] set for each member; values
+//     is empty.
+//     A RUN chunk has values holding (start, length - 1) pairs of
+//     maximal runs of consecutive lows, in increasing order; words is
+//     empty.
+
+#include "RoaringIntSet.h"
+#include <algorithm>   // provides lower_bound, set_union, set_intersection, ...
+#include <iterator>    // provides back_inserter
+using namespace std;
+
+typedef RoaringIntSet::chunk chunk;
+
+// Largest ARRAY container; above it a bitmap (8 KiB) is smaller.
+static const int ARRAY_MAX = 4096;
+static const int BITMAP_WORDS = 65536 / 64;
+
+// ===== int <-> (key, low) =====
+
+static uint32_t to_unsigned(int anInt)
+{
+   return uint32_t(anInt) ^ 0x80000000u;
+}
+
+static int to_int(uint16_t key, uint16_t low)
+{
+   return int(((uint32_t(key) << 16) | low) ^ 0x80000000u);
+}
+
+// ===== word-parallel bitmap kernels =====
+
+static int popcount(uint64_t w)
+{
+#if defined(__GNUC__)
+   return __builtin_popcountll(w);
+#else
+   w = w - ((w >> 1) & 0x5555555555555555ULL);
+   w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+   w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+   return int((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Index of the lowest set bit of w (w != 0).
+static int lowest_bit(uint64_t w)
+{
+#if defined(__GNUC__)
+   return __builtin_ctzll(w);
+#else
+   return popcount((w & (0 - w)) - 1);
+#endif
+}
+
+static int count_bits(const uint64_t* w)
+{
+   int c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+   for (int i = 0; i < BITMAP_WORDS; i += 4)
+   {
+      c0 += popcount(w[i]);
+      c1 += popcount(w[i + 1]);
+      c2 += popcount(w[i + 2]);
+      c3 += popcount(w[i + 3]);
+   }
+   return (c0 + c1) + (c2 + c3);
+}
+
+// out = a OP b, one 64-bit word at a time (the loops are simple
+// enough for the compiler to vectorize).
+static void or_words(const uint64_t* a, const uint64_t* b, uint64_t* out)
+{
+   for (int i = 0; i < BITMAP_WORDS; ++i)
+      out[i] = a[i] | b[i];
+}
+
+static void and_words(const uint64_t* a, const uint64_t* b, uint64_t* out)
+{
+   for (int i = 0; i < BITMAP_WORDS; ++i)
+      out[i] = a[i] & b[i];
+}
+
+static void andnot_words(const uint64_t* a, const uint64_t* b, uint64_t* out)
+{
+   for (int i = 0; i < BITMAP_WORDS; ++i)
+      out[i] = a[i] & ~b[i];
+}
+
+static bool subset_words(const uint64_t* a, const uint64_t* b)
+{
+   uint64_t stray = 0;
+   for (int i = 0; i < BITMAP_WORDS; ++i)
+      stray |= a[i] & ~b[i];
+   return stray == 0;
+}
+
+static bool test_bit(const vector<uint64_t>& words, uint16_t low)
+{
+   return (words[low >> 6] >> (low & 63)) & 1;
+}
+
+// ===== container conversions =====
+
+// Appends the lows of c, in increasing order, to out.
+static void decode(const chunk& c, vector<uint16_t>& out)
+{
+   switch (c.kind)
+   {
+      case RoaringIntSet::ARRAY:
+         out.insert(out.end(), c.values.begin(), c.values.end());
+         break;
+      case RoaringIntSet::BITMAP:
+         for (int i = 0; i < BITMAP_WORDS; ++i)
+         {
+            uint64_t w = c.words[i];
+            for (; w != 0; w &= w - 1)
+               out.push_back(uint16_t(i * 64 + lowest_bit(w)));
+         }
+         break;
+      case RoaringIntSet::RUN:
+         for (size_t r = 0; r < c.values.size(); r += 2)
+            for (uint32_t v = c.values[r]; v <= uint32_t(c.values[r]) + c.values[r + 1]; ++v)
+               out.push_back(uint16_t(v));
+         break;
+   }
+}
+
+// Makes c an ARRAY or BITMAP chunk (whichever invariant (3) asks for
+// at its card), keeping its members.
+static void make_plain(chunk& c)
+{
+   if (c.kind == RoaringIntSet::BITMAP && c.card > ARRAY_MAX) return;
+   if (c.kind == RoaringIntSet::ARRAY && c.card <= ARRAY_MAX) return;
+
+   vector<uint16_t> lows;
+   lows.reserve(c.card);
+   decode(c, lows);
+   vector<uint64_t>().swap(c.words);
+   if (c.card <= ARRAY_MAX)
+   {
+      c.kind = RoaringIntSet::ARRAY;
+      c.values.swap(lows);
+   }
+   else
+   {
+      c.kind = RoaringIntSet::BITMAP;
+      c.words.assign(BITMAP_WORDS, 0);
+      for (size_t i = 0; i < lows.size(); ++i)
+         c.words[lows[i] >> 6] |= uint64_t(1) << (lows[i] & 63);
+      vector<uint16_t>().swap(c.values);
+   }
+}
+
+// Fills words (1024 of them) with the members of the plain chunk c.
+static void bitmap_of(const chunk& c, vector<uint64_t>& words)
+{
+   if (c.kind == RoaringIntSet::BITMAP)
+   {
+      words = c.words;
+      return;
+   }
+   words.assign(BITMAP_WORDS, 0);
+   for (size_t i = 0; i < c.values.size(); ++i)
+      words[c.values[i] >> 6] |= uint64_t(1) << (c.values[i] & 63);
+}
+
+// Returns c itself if it is plain (ARRAY or BITMAP), otherwise a
+// plain copy built in scratch.
+static const chunk& plain(const chunk& c, chunk& scratch)
+{
+   if (c.kind != RoaringIntSet::RUN) return c;
+   scratch = c;
+   make_plain(scratch);
+   return scratch;
+}
+
+static bool chunk_contains(const chunk& c, uint16_t low)
+{
+   switch (c.kind)
+   {
+      case RoaringIntSet::ARRAY:
+         return binary_search(c.values.begin(), c.values.end(), low);
+      case RoaringIntSet::BITMAP:
+         return test_bit(c.words, low);
+      case RoaringIntSet::RUN:
+      {
+         // last run starting at or before low
+         size_t lo = 0, hi = c.values.size() / 2;
+         while (lo < hi)
+         {
+            size_t mid = (lo + hi) / 2;
+            if (c.values[2 * mid] <= low) lo = mid + 1;
+            else hi = mid;
+         }
+         if (lo == 0) return false;
+         uint32_t start = c.values[2 * (lo - 1)];
+         return low <= start + c.values[2 * (lo - 1) + 1];
+      }
+   }
+   return false;
+}
+
+// Sets c's kind, card and storage from a bitmap that has just been
+// computed into words (taking words' buffer).
+static void set_from_words(chunk& c, vector<uint64_t>& words)
+{
+   c.kind = RoaringIntSet::BITMAP;
+   c.card = count_bits(&words[0]);
+   c.values.clear();
+   c.words.swap(words);
+   make_plain(c);
+}
+
+static void set_from_values(chunk& c, vector<uint16_t>& lows)
+{
+   c.kind = RoaringIntSet::ARRAY;
+   c.card = int(lows.size());
+   c.words.clear();
+   c.values.swap(lows);
+   make_plain(c);
+}
+
+// ===== chunk-level set algebra (results are plain, maybe empty) =====
+
+static void union_chunks(const chunk& x, const chunk& y, chunk& out)
+{
+   chunk sx, sy;
+   const chunk& a = plain(x, sx);
+   const chunk& b = plain(y, sy);
+   out.key = a.key;
+
+   if (a.kind == RoaringIntSet::ARRAY && b.kind == RoaringIntSet::ARRAY &&
+       a.card + b.card <= ARRAY_MAX)
+   {
+      vector<uint16_t> lows;
+      lows.reserve(a.card + b.card);
+      set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                back_inserter(lows));
+      set_from_values(out, lows);
+      return;
+   }
+
+   vector<uint64_t> words;
+   if (a.kind == RoaringIntSet::BITMAP && b.kind == RoaringIntSet::BITMAP)
+   {
+      words.resize(BITMAP_WORDS);
+      or_words(&a.words[0], &b.words[0], &words[0]);
+   }
+   else
+   {
+      const chunk& big = (a.kind == RoaringIntSet::BITMAP) ? a : b;
+      const chunk& small = (&big == &a) ? b : a;
+      bitmap_of(big, words);
+      for (size_t i = 0; i < small.values.size(); ++i)
+         words[small.values[i] >> 6] |= uint64_t(1) << (small.values[i] & 63);
+   }
+   set_from_words(out, words);
+}
+
+static void intersect_chunks(const chunk& x, const chunk& y, chunk& out)
+{
+   chunk sx, sy;
+   const chunk& a = plain(x, sx);
+   const chunk& b = plain(y, sy);
+   out.key = a.key;
+
+   if (a.kind == RoaringIntSet::BITMAP && b.kind == RoaringIntSet::BITMAP)
+   {
+      vector<uint64_t> words(BITMAP_WORDS);
+      and_words(&a.words[0], &b.words[0], &words[0]);
+      set_from_words(out, words);
+      return;
+   }
+
+   vector<uint16_t> lows;
+   if (a.kind == RoaringIntSet::ARRAY && b.kind == RoaringIntSet::ARRAY)
+      set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                       back_inserter(lows));
+   else
+   {
+      const chunk& small = (a.kind == RoaringIntSet::ARRAY) ? a : b;
+      const chunk& big = (&small == &a) ? b : a;
+      for (size_t i = 0; i < small.values.size(); ++i)
+         if (test_bit(big.words, small.values[i]))
+            lows.push_back(small.values[i]);
+   }
+   set_from_values(out, lows);
+}
+
+static void subtract_chunks(const chunk& x, const chunk& y, chunk& out)
+{
+   chunk sx, sy;
+   const chunk& a = plain(x, sx);
+   const chunk& b = plain(y, sy);
+   out.key = a.key;
+
+   if (a.kind == RoaringIntSet::ARRAY)
+   {
+      vector<uint16_t> lows;
+      if (b.kind == RoaringIntSet::ARRAY)
+         set_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                        back_inserter(lows));
+      else
+         for (size_t i = 0; i < a.values.size(); ++i)
+            if (!test_bit(b.words, a.values[i]))
+               lows.push_back(a.values[i]);
+      set_from_values(out, lows);
+      return;
+   }
+
+   vector<uint64_t> words;
+   if (b.kind == RoaringIntSet::BITMAP)
+   {
+      words.resize(BITMAP_WORDS);
+      andnot_words(&a.words[0], &b.words[0], &words[0]);
+   }
+   else
+   {
+      words = a.words;
+      for (size_t i = 0; i < b.values.size(); ++i)
+         words[b.values[i] >> 6] &= ~(uint64_t(1) << (b.values[i] & 63));
+   }
+   set_from_words(out, words);
+}
+
+static bool subset_chunk(const chunk& x, const chunk& y)
+{
+   if (x.card > y.card) return false;
+
+   chunk sx, sy;
+   const chunk& a = plain(x, sx);
+   const chunk& b = plain(y, sy);
+   if (a.kind == RoaringIntSet::BITMAP)
+      return subset_words(&a.words[0], &b.words[0]);   // b is a BITMAP too
+   if (b.kind == RoaringIntSet::ARRAY)
+      return includes(b.values.begin(), b.values.end(), a.values.begin(), a.values.end());
+   for (size_t i = 0; i < a.values.size(); ++i)
+      if (!test_bit(b.words, a.values[i]))
+         return false;
+   return true;
+}
+
+
+// ===== RoaringIntSet =====
+
+RoaringIntSet::RoaringIntSet() : used(0)
+{
+}
+
+// Sort the members once and cut them into chunks, rather than adding
+// them one at a time in membership order.
+RoaringIntSet::RoaringIntSet(const IntSet& src) : used(0)
+{
+   const int* members = src.members();
+   vector<uint32_t> keys(members, members + src.size());
+   for (size_t i = 0; i < keys.size(); ++i)
+      keys[i] = to_unsigned(int(keys[i]));
+   sort(keys.begin(), keys.end());
+
+   size_t i = 0;
+   while (i < keys.size())
+   {
+      chunk c;
+      c.key = uint16_t(keys[i] >> 16);
+      vector<uint16_t> lows;
+      for (; i < keys.size() && uint16_t(keys[i] >> 16) == c.key; ++i)
+         lows.push_back(uint16_t(keys[i]));
+      set_from_values(c, lows);
+      used += c.card;
+      chunks.push_back(c);
+   }
+   run_optimize();
+}
+
+RoaringIntSet::chunk* RoaringIntSet::find_chunk(uint16_t key)
+{
+   const RoaringIntSet* self = this;
+   return const_cast<chunk*>(self->find_chunk(key));
+}
+
+const RoaringIntSet::chunk* RoaringIntSet::find_chunk(uint16_t key) const
+{
+   size_t lo = 0, hi = chunks.size();
+   while (lo < hi)
+   {
+      size_t mid = (lo + hi) / 2;
+      if (chunks[mid].key < key) lo = mid + 1;
+      else hi = mid;
+   }
+   return (lo < chunks.size() && chunks[lo].key == key) ? &chunks[lo] : 0;
+}
+
+bool RoaringIntSet::add(int anInt)
+{
+   uint32_t u = to_unsigned(anInt);
+   uint16_t key = uint16_t(u >> 16), low = uint16_t(u);
+
+   chunk* c = find_chunk(key);
+   if (c == 0)
+   {
+      chunk fresh;
+      fresh.key = key;
+      fresh.kind = ARRAY;
+      fresh.card = 1;
+      fresh.values.push_back(low);
+      size_t lo = 0, hi = chunks.size();
+      while (lo < hi)
+      {
+         size_t mid = (lo + hi) / 2;
+         if (chunks[mid].key < key) lo = mid + 1;
+         else hi = mid;
+      }
+      chunks.insert(chunks.begin() + lo, fresh);
+      ++used;
+      return true;
+   }
+
+   if (chunk_contains(*c, low)) return false;
+   if (c->kind == RUN) make_plain(*c);
+
+   ++c->card;
+   if (c->kind == ARRAY)
+      c->values.insert(lower_bound(c->values.begin(), c->values.end(), low), low);
+   else
+      c->words[low >> 6] |= uint64_t(1) << (low & 63);
+   make_plain(*c);   // an ARRAY past ARRAY_MAX becomes a BITMAP
+   ++used;
+   return true;
+}
+
+bool RoaringIntSet::remove(int anInt)
+{
+   uint32_t u = to_unsigned(anInt);
+   uint16_t key = uint16_t(u >> 16), low = uint16_t(u);
+
+   chunk* c = find_chunk(key);
+   if (c == 0 || !chunk_contains(*c, low)) return false;
+   if (c->kind == RUN) make_plain(*c);
+
+   --c->card;
+   --used;
+   if (c->card == 0)
+   {
+      chunks.erase(chunks.begin() + (c - &chunks[0]));
+      return true;
+   }
+   if (c->kind == ARRAY)
+      c->values.erase(lower_bound(c->values.begin(), c->values.end(), low));
+   else
+      c->words[low >> 6] &= ~(uint64_t(1) << (low & 63));
+   make_plain(*c);   // a BITMAP down to ARRAY_MAX becomes an ARRAY
+   return true;
+}
+
+void RoaringIntSet::reset()
+{
+   chunks.clear();
+   used = 0;
+}
+
+// Bytes per container: array 2 per member, bitmap 8192, run 4 per run.
+void RoaringIntSet::run_optimize()
+{
+   vector<uint16_t> lows;
+   for (size_t k = 0; k < chunks.size(); ++k)
+   {
+      chunk& c = chunks[k];
+      lows.clear();
+      decode(c, lows);
+
+      size_t runs = 1;
+      for (size_t i = 1; i < lows.size(); ++i)
+         if (lows[i] != lows[i - 1] + 1) ++runs;
+
+      size_t plain_bytes = (c.card <= ARRAY_MAX) ? 2 * size_t(c.card) : 8 * BITMAP_WORDS;
+      if (4 * runs < plain_bytes)
+      {
+         vector<uint16_t> pairs;
+         pairs.reserve(2 * runs);
+         size_t start = 0;
+         for (size_t i = 1; i <= lows.size(); ++i)
+            if (i == lows.size() || lows[i] != lows[i - 1] + 1)
+            {
+               pairs.push_back(lows[start]);
+               pairs.push_back(uint16_t(i - 1 - start));
+               start = i;
+            }
+         c.kind = RUN;
+         c.values.swap(pairs);
+         vector<uint64_t>().swap(c.words);
+      }
+      else if (c.kind == RUN)
+      {
+         make_plain(c);
+      }
+   }
+}
+
+int RoaringIntSet::size() const
+{
+   return used;
+}
+
+bool RoaringIntSet::isEmpty() const
+{
+   return used == 0;
+}
+
+bool RoaringIntSet::contains(int anInt) const
+{
+   uint32_t u = to_unsigned(anInt);
+   const chunk* c = find_chunk(uint16_t(u >> 16));
+   return c != 0 && chunk_contains(*c, uint16_t(u));
+}
+
+bool RoaringIntSet::isSubsetOf(const RoaringIntSet& other) const
+{
+   if (used > other.used) return false;
+
+   size_t j = 0;
+   for (size_t i = 0; i < chunks.size(); ++i)
+   {
+      while (j < other.chunks.size() && other.chunks[j].key < chunks[i].key) ++j;
+      if (j == other.chunks.size() || other.chunks[j].key != chunks[i].key)
+         return false;
+      if (!subset_chunk(chunks[i], other.chunks[j]))
+         return false;
+   }
+   return true;
+}
+
+// The three set operations walk both chunk lists in key order, like
+// a sorted merge.
+RoaringIntSet RoaringIntSet::unionWith(const RoaringIntSet& other) const
+{
+   RoaringIntSet result;
+   result.chunks.reserve(chunks.size() + other.chunks.size());
+
+   size_t i = 0, j = 0;
+   while (i < chunks.size() || j < other.chunks.size())
+   {
+      if (j == other.chunks.size() ||
+          (i < chunks.size() && chunks[i].key < other.chunks[j].key))
+         result.chunks.push_back(chunks[i++]);
+      else if (i == chunks.size() || other.chunks[j].key < chunks[i].key)
+         result.chunks.push_back(other.chunks[j++]);
+      else
+      {
+         chunk c;
+         union_chunks(chunks[i++], other.chunks[j++], c);
+         result.chunks.push_back(c);
+      }
+      result.used += result.chunks.back().card;
+   }
+   return result;
+}
+
+RoaringIntSet RoaringIntSet::intersect(const RoaringIntSet& other) const
+{
+   RoaringIntSet result;
+
+   size_t i = 0, j = 0;
+   while (i < chunks.size() && j < other.chunks.size())
+   {
+      if (chunks[i].key < other.chunks[j].key) ++i;
+      else if (other.chunks[j].key < chunks[i].key) ++j;
+      else
+      {
+         chunk c;
+         intersect_chunks(chunks[i++], other.chunks[j++], c);
+         if (c.card > 0)
+         {
+            result.used += c.card;
+            result.chunks.push_back(c);
+         }
+      }
+   }
+   return result;
+}
+
+RoaringIntSet RoaringIntSet::subtract(const RoaringIntSet& other) const
+{
+   RoaringIntSet result;
+
+   size_t j = 0;
+   for (size_t i = 0; i < chunks.size(); ++i)
+   {
+      while (j < other.chunks.size() && other.chunks[j].key < chunks[i].key) ++j;
+      if (j == other.chunks.size() || other.chunks[j].key != chunks[i].key)
+      {
+         result.used += chunks[i].card;
+         result.chunks.push_back(chunks[i]);
+         continue;
+      }
+      chunk c;
+      subtract_chunks(chunks[i], other.chunks[j], c);
+      if (c.card > 0)
+      {
+         result.used += c.card;
+         result.chunks.push_back(c);
+      }
+   }
+   return result;
+}
+
+IntSet RoaringIntSet::toIntSet() const
+{
+   IntSet result(used);
+   vector<uint16_t> lows;
+   for (size_t k = 0; k < chunks.size(); ++k)
+   {
+      lows.clear();
+      decode(chunks[k], lows);
+      for (size_t i = 0; i < lows.size(); ++i)
+         result.add(to_int(chunks[k].key, lows[i]));
+   }
+   return result;
+}
+
+void RoaringIntSet::DumpData(ostream& out) const
+{
+   vector<uint16_t> lows;
+   bool first = true;
+   for (size_t k = 0; k < chunks.size(); ++k)
+   {
+      lows.clear();
+      decode(chunks[k], lows);
+      for (size_t i = 0; i < lows.size(); ++i)
+      {
+         if (!first) out << "  ";
+         out << to_int(chunks[k].key, lows[i]);
+         first = false;
+      }
+   }
+}
+
+size_t RoaringIntSet::bytes_used() const
+{
+   size_t bytes = sizeof(*this) + chunks.capacity() * sizeof(chunk);
+   for (size_t k = 0; k < chunks.size(); ++k)
+      bytes += chunks[k].values.capacity() * sizeof(uint16_t) +
+               chunks[k].words.capacity() * sizeof(uint64_t);
+   return bytes;
+}
+
+// Same members: same sizes and one a subset of the other.
+bool operator==(const RoaringIntSet& rs1, const RoaringIntSet& rs2)
+{
+   return rs1.size() == rs2.size() && rs1.isSubsetOf(rs2);
+}
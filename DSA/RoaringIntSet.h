@@ -0,0 +1,153 @@
+// FILE: RoaringIntSet.h
+// CLASS PROVIDED: RoaringIntSet (a set of ints stored as compressed
+//                 bitmaps; an alternative to IntSet for big, dense or
+//                 clustered sets)
+//
+// STORAGE:
+//   The 32-bit key space is cut into 65536 chunks of 65536 values (by
+//   the high 16 bits of each int). Only chunks that have members are
+//   stored, in key order, and each one picks the smallest of three
+//   containers for its low 16 bits:
+//     array  - a sorted list of up to 4096 uint16 values (2 bytes each)
+//     bitmap - 65536 bits in 1024 64-bit words (8 KiB, any cardinality)
+//     run    - sorted (start, length - 1) pairs for runs of
+//              consecutive values (4 bytes per run)
+//   Array and bitmap containers switch over at 4096 members as items
+//   are added and removed; run containers are only made by
+//   run_optimize() (and the IntSet conversion) and turn back into an
+//   array or bitmap the first time they are changed.
+//
+//   Union, intersection, difference and subset tests work chunk by
+//   chunk: bitmap against bitmap is a loop of 64-bit OR / AND / AND-NOT
+//   over 1024 words (which compilers turn into SIMD code) plus a
+//   popcount; array against array is a sorted merge; array against
+//   bitmap tests one bit per array value.
+//
+//   Dense and clustered sets pack into a small fraction of IntSet's 4
+//   bytes per member. Keys spread thinly over the whole int range
+//   (about one per chunk) are the worst case: every member then costs
+//   a whole chunk, and adding a new chunk shifts the chunk list, so
+//   IntSet is smaller and faster for such sets (and building from an
+//   IntSet, which sorts once, beats adding one key at a time).
+//
+//   Unlike IntSet, membership order is NOT kept: members always come
+//   out in increasing order.
+//
+// CONSTRUCTORS for the RoaringIntSet class:
+//   RoaringIntSet()
+//     Pre:  (none)
+//     Post: The set has been initialized as an empty set.
+//   explicit RoaringIntSet(const IntSet& src)
+//     Pre:  (none)
+//     Post: The set holds the members of src, and run_optimize() has
+//           been applied.
+//
+// MODIFICATION MEMBER FUNCTIONS for the RoaringIntSet class:
+//   bool add(int anInt)
+//     Pre:  (none)
+//     Post: If anInt was not a member, it has been added and true has
+//           been returned; otherwise false has been returned.
+//   bool remove(int anInt)
+//     Pre:  (none)
+//     Post: If anInt was a member, it has been removed and true has
+//           been returned; otherwise false has been returned.
+//   void reset()
+//     Pre:  (none)
+//     Post: The set is empty.
+//   void run_optimize()
+//     Pre:  (none)
+//     Post: Every chunk uses whichever container (array, bitmap or
+//           run) takes the fewest bytes for its members.
+//
+// CONSTANT MEMBER FUNCTIONS for the RoaringIntSet class:
+//   int size() const
+//     Post: The number of members has been returned.
+//   bool isEmpty() const
+//     Post: true has been returned if the set has no members.
+//   bool contains(int anInt) const
+//     Post: true has been returned if anInt is a member (a binary
+//           search of the chunk keys, then one bit test or a binary
+//           search within the chunk).
+//   bool isSubsetOf(const RoaringIntSet& other) const
+//     Post: true has been returned if every member of this set is also
+//           a member of other.
+//   RoaringIntSet unionWith(const RoaringIntSet& other) const
+//   RoaringIntSet intersect(const RoaringIntSet& other) const
+//   RoaringIntSet subtract(const RoaringIntSet& other) const
+//     Post: The union / intersection / difference (members of this set
+//           that are not in other) has been returned.
+//   IntSet toIntSet() const
+//     Post: An IntSet with the same members, added in increasing
+//           order, has been returned.
+//   void DumpData(std::ostream& out) const
+//     Post: The members have been written to out in increasing order,
+//           separated by two spaces (the IntSet::DumpData format).
+//   std::size_t bytes_used() const
+//     Post: The number of bytes of memory the set holds (object,
+//           chunk list and containers) has been returned.
+//
+// NONMEMBER FUNCTIONS for the RoaringIntSet class:
+//   bool operator==(const RoaringIntSet& rs1, const RoaringIntSet& rs2)
+//     Post: true has been returned if rs1 and rs2 have the same members.
+//
+// VALUE SEMANTICS for the RoaringIntSet class:
+//   Assignments and the copy constructor may be used with
+//   RoaringIntSet objects.
+//
+// DYNAMIC MEMORY USAGE by the RoaringIntSet class:
+//   If there is insufficient dynamic memory, the constructors, add,
+//   remove, run_optimize, unionWith, intersect, subtract, toIntSet and
+//   the assignment operator throw bad_alloc.
+
+#ifndef ROARING_INT_SET_H
+#define ROARING_INT_SET_H
+
+#include <cstdlib>   // provides size_t
+#include <iostream>  // provides ostream
+#include <stdint.h>  // provides uint16_t, uint32_t, uint64_t
+#include <vector>    // provides vector
+#include "IntSet.h"
+
+class RoaringIntSet
+{
+public:
+   RoaringIntSet();
+   explicit RoaringIntSet(const IntSet& src);
+   bool add(int anInt);
+   bool remove(int anInt);
+   void reset();
+   void run_optimize();
+   int size() const;
+   bool isEmpty() const;
+   bool contains(int anInt) const;
+   bool isSubsetOf(const RoaringIntSet& other) const;
+   RoaringIntSet unionWith(const RoaringIntSet& other) const;
+   RoaringIntSet intersect(const RoaringIntSet& other) const;
+   RoaringIntSet subtract(const RoaringIntSet& other) const;
+   IntSet toIntSet() const;
+   void DumpData(std::ostream& out) const;
+   std::size_t bytes_used() const;
+
+   // One 65536-value chunk (see STORAGE); public only so that the
+   // helper functions in RoaringIntSet.cpp can take it.
+   enum container_kind { ARRAY, BITMAP, RUN };
+   struct chunk
+   {
+      uint16_t key;                  // high 16 bits of the members
+      container_kind kind;
+      int card;                      // members in this chunk (>= 1)
+      std::vector<uint16_t> values;  // ARRAY: sorted lows; RUN: pairs
+      std::vector<uint64_t> words;   // BITMAP: 1024 words
+   };
+
+private:
+   std::vector<chunk> chunks;        // in increasing key order
+   int used;                         // total members
+
+   chunk* find_chunk(uint16_t key);
+   const chunk* find_chunk(uint16_t key) const;
+};
+
+bool operator==(const RoaringIntSet& rs1, const RoaringIntSet& rs2);
+
+#endif
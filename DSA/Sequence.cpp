@@ -1,5 +1,5 @@
 // FILE: Sequence.cpp
-// CLASS IMPLEMENTED: sequence (see sequence.h for documentation)
+// CLASS IMPLEMENTED: sequence (see Sequence.h for documentation)
 // INVARIANT for the sequence ADT:
 //   1. The number of items in the sequence is in the member variable
 //      used;
@@ -37,48 +37,116 @@
 //                postcondition for the function for both of the two
 //                possible scenarios (current item is and is not the
 //                last item in the sequence).
+//   5. A sequence that has been moved from owns no array: data is NULL
+//      and used, current_index and capacity are all 0. It behaves as an
+//      empty sequence and allocates again on the next insert/attach.
+//
+// NOTE: Whenever the array is reallocated or copied, items are moved
+//       with a single memcpy when value_type is trivially copyable and
+//       with std::move otherwise (see relocate_items below), never by
+//       copy-assigning one item at a time.
 
 #include <cassert>
 #include "Sequence.h"
+#include "growthPolicy.h"
+#include "seqAlgo.h"
 #include <cstdlib>
 #include <initializer_list>
+#include <cstring>
 #include <iostream>
+#include <algorithm>
 #include <new>
+#include <type_traits>
+#include <utility>
 using namespace std;
 
 namespace CS3358_FA2023
 {
+   // Moves n items from src to (non-overlapping) dest.
+   static void relocate_items(sequence::value_type* dest, sequence::value_type* src, size_t n)
+   {
+      if (is_trivially_copyable<sequence::value_type>::value) {
+         if (n > 0) memcpy(dest, src, n * sizeof(sequence::value_type));
+      } else {
+         for (size_t i = 0; i < n; ++i)
+            dest[i] = std::move(src[i]);
+      }
+   }
+
+   // The growth used when no policy is given (the original 1.5x + 1).
+   static growth_policy* default_sequence_growth()
+   {
+      static geometric_growth policy(1.5, 1);
+      return &policy;
+   }
+
+   // Copies n items from src to (non-overlapping) dest.
+   static void copy_items(sequence::value_type* dest, const sequence::value_type* src, size_t n)
+   {
+      if (is_trivially_copyable<sequence::value_type>::value) {
+         if (n > 0) memcpy(dest, src, n * sizeof(sequence::value_type));
+      } else {
+         for (size_t i = 0; i < n; ++i)
+            dest[i] = src[i];
+      }
+   }
+
+   // Moves the n items at src to the (possibly overlapping) items at dest.
+   static void shift_items(sequence::value_type* dest, sequence::value_type* src, size_t n)
+   {
+      if (n == 0 || dest == src) return;
+      if (is_trivially_copyable<sequence::value_type>::value) {
+         memmove(dest, src, n * sizeof(sequence::value_type));
+      } else if (dest < src) {
+         std::move(src, src + n, dest);
+      } else {
+         std::move_backward(src, src + n, dest + n);
+      }
+   }
+
     // === CONSTRUCTORS and DESTRUCTOR ===
    
    // Constructor with given capacity. Initializes a dynamic array of given size.
-   sequence::sequence(size_t initial_capacity) : used(0), current_index(0), capacity(initial_capacity)
+   sequence::sequence(size_t initial_capacity, growth_policy* policy) : used(0), current_index(0), capacity(initial_capacity), policy(policy)
    {
       // Check PRE
       if(initial_capacity < 1){
       capacity = 1;}
+      if(policy == NULL){
+         this->policy = default_sequence_growth();}
 
       // DynSeqArray
-      data = new value_type[capacity];
+      data = allocate_items<value_type>(*this->policy, capacity);
+      stats.record_allocation(capacity);
    }
 
    // Copy constructor. Initializes sequence from another sequence.
-   sequence::sequence(const sequence& source) : used(source.used), current_index(source.current_index), capacity(source.capacity)
+   sequence::sequence(const sequence& source) : used(source.used), current_index(source.current_index), capacity(source.capacity), policy(source.policy)
    {
+      // A moved-from source has no array; start over with the minimum.
+      if(capacity < 1){
+         capacity = 1;}
+
       // dynArray
-      data = new value_type[capacity];
+      data = allocate_items<value_type>(*policy, capacity);
+      stats.record_allocation(capacity);
 
       // copy
-      for (size_t i = 0; i < used; ++i) 
-      {
-         data[i] = source.data[i];
-      }
+      copy_items(data, source.data, used);
+   }
+
+   // Move constructor. Takes over source's array; source is left empty.
+   sequence::sequence(sequence&& source) : data(source.data), used(source.used), current_index(source.current_index), capacity(source.capacity), policy(source.policy), stats(source.stats)
+   {
+      source.data = NULL;
+      source.used = source.current_index = source.capacity = 0;
    }
 
    // Destruction
    sequence::~sequence()
    {
       // Begone!
-      delete [] data;
+      deallocate_items(*policy, data, capacity);
       data = NULL;
    }
 
@@ -88,6 +156,8 @@ namespace CS3358_FA2023
    // Inflate
    void sequence::resize(size_t new_capacity)
    {
+      size_t old_capacity = capacity;
+
       // Valid! Resize
       if(new_capacity < 1){
          new_capacity = 1;}
@@ -97,14 +167,38 @@ namespace CS3358_FA2023
          capacity = new_capacity;}
 
       // dynA, to new place
-      value_type *temp_data = new value_type[capacity];
-      for (size_t i = 0; i < used; ++i) {
-         temp_data[i] = data[i];
-      }
+      value_type *temp_data = allocate_items<value_type>(*policy, capacity);
+      relocate_items(temp_data, data, used);
 
       // Goodbye!
-      delete [] data;
+      deallocate_items(*policy, data, old_capacity);
       data = temp_data;
+      stats.record_reallocation(capacity);
+   }
+
+   // Grow only; never reallocates when there is already enough room.
+   void sequence::reserve(size_t new_capacity)
+   {
+      if(new_capacity > capacity){
+         resize(new_capacity);}
+   }
+
+   // Give back every unused slot.
+   void sequence::shrink_to_fit()
+   {
+      if(capacity > used && capacity > 1){
+         resize(used);}
+   }
+
+   // Exchange everything, no items touched.
+   void sequence::swap(sequence& other)
+   {
+      std::swap(data, other.data);
+      std::swap(used, other.used);
+      std::swap(current_index, other.current_index);
+      std::swap(capacity, other.capacity);
+      std::swap(policy, other.policy);
+      std::swap(stats, other.stats);
    }
 
    // Sets the current item to the first item in the sequence = 0.
@@ -124,11 +218,11 @@ namespace CS3358_FA2023
    // Inserts a new item before the current item, or at the start if no current item.
    void sequence::insert(const value_type& entry)
    {
-      if(used == capacity){resize(size_t (1.5 * capacity) + 1);}
+      if(used == capacity){resize(policy->next_capacity(capacity, used + 1, sizeof(value_type)));}
 
       if(!is_item()) {
          current_index = 0;
-         for(size_t i = used + 1; i> current_index; --i){
+         for(size_t i = used; i > current_index; --i){
             data[i] = data[i - 1];
          }
 
@@ -138,7 +232,7 @@ namespace CS3358_FA2023
       } else {
 
          // Insert if existing item present
-         for(size_t i = used + 1; i > current_index; --i){
+         for(size_t i = used; i > current_index; --i){
             data[i] = data[i - 1];
          }
 
@@ -153,7 +247,7 @@ namespace CS3358_FA2023
    {
       // Checks
       if(used == capacity){
-         resize(size_t (1.5 * capacity) + 1);
+         resize(policy->next_capacity(capacity, used + 1, sizeof(value_type)));
       }
 
       if(!is_item()){
@@ -163,7 +257,7 @@ namespace CS3358_FA2023
       } else {
          //Append
          current_index = current_index + 1;
-         for (size_t i = used + 1; i > current_index; --i) {
+         for (size_t i = used; i > current_index; --i) {
             data[i] = data[i-1];
          }
 
@@ -185,27 +279,96 @@ namespace CS3358_FA2023
       --used;
    }
 
+   // Inserts copies of [first, last) before the current item.
+   void sequence::insert_range(const value_type* first, const value_type* last)
+   {
+      assert(first <= last);
+      if (first == last) return;
+
+      if(!is_item()) {
+         current_index = 0;}
+
+      open_gap(current_index, size_t(last - first));
+      copy_items(data + current_index, first, size_t(last - first));
+   }
+
+   void sequence::insert_range(initializer_list<value_type> entries)
+   {
+      insert_range(entries.begin(), entries.end());
+   }
+
+   // Attaches copies of [first, last) after the current item.
+   void sequence::attach_range(const value_type* first, const value_type* last)
+   {
+      assert(first <= last);
+      if (first == last) return;
+
+      size_t count = size_t(last - first);
+      size_t position = is_item() ? current_index + 1 : used;
+
+      open_gap(position, count);
+      copy_items(data + position, first, count);
+      current_index = position + count - 1;
+   }
+
+   void sequence::attach_range(initializer_list<value_type> entries)
+   {
+      attach_range(entries.begin(), entries.end());
+   }
+
+   // Removes count items starting at the current item with one shift.
+   void sequence::erase_range(size_t count)
+   {
+      if (count == 0) return;
+      assert(is_item());
+      assert(count <= used - current_index);
+
+      shift_items(data + current_index, data + current_index + count,
+                  used - current_index - count);
+      used -= count;
+   }
+
    // Assignment operator. Assign sequence to other sequence
    sequence& sequence::operator=(const sequence& source)
    {
       // failsafe
       if (this == &source) return *this;
 
-      value_type *temp_data = new value_type[source.capacity];
+      size_t new_capacity = (source.capacity < 1) ? 1 : source.capacity;
+      value_type *temp_data = allocate_items<value_type>(*policy, new_capacity);
 
-      for (size_t i = 0; i < source.used; ++i) {
-         temp_data[i] = source.data[i];
-      }
+      copy_items(temp_data, source.data, source.used);
 
       // remove
-      delete [] data;
+      deallocate_items(*policy, data, capacity);
+      stats.record_reallocation(new_capacity);
 
       // replace
       data = temp_data;
+      capacity = new_capacity;
+      used = source.used;
+      current_index = source.current_index;
+
+      return *this;
+   }
+
+   // Move assignment. Release ours, take source's, leave source empty.
+   sequence& sequence::operator=(sequence&& source)
+   {
+      if (this == &source) return *this;
+
+      deallocate_items(*policy, data, capacity);
+
+      policy = source.policy;
+      stats = source.stats;
+      data = source.data;
       capacity = source.capacity;
       used = source.used;
       current_index = source.current_index;
 
+      source.data = NULL;
+      source.used = source.current_index = source.capacity = 0;
+
       return *this;
    }
 
@@ -225,11 +388,130 @@ namespace CS3358_FA2023
    }
 
    // return item in sequence at current_index.
-   sequence::value_type sequence::current() const
+   const sequence::value_type& sequence::current() const
    {
       // Assert can be used to protect.
       assert(is_item());
 
       return data[current_index];
    }
+
+   // same, but the item can be changed in place
+   sequence::value_type& sequence::current()
+   {
+      assert(is_item());
+
+      return data[current_index];
+   }
+
+   // contiguous iterators over data[0 .. used)
+   sequence::iterator sequence::begin()
+   {
+      return data;
+   }
+
+   sequence::iterator sequence::end()
+   {
+      return data + used;
+   }
+
+   sequence::const_iterator sequence::begin() const
+   {
+      return data;
+   }
+
+   sequence::const_iterator sequence::end() const
+   {
+      return data + used;
+   }
+
+   // first occurrence of target becomes the current item
+   bool sequence::find(const value_type& target)
+   {
+      const value_type* hit = seq_find<value_type>(data, data + used, target);
+      if (hit == data + used) return false;
+      current_index = size_t(hit - data);
+      return true;
+   }
+
+   sequence::size_type sequence::count_if(bool (*pred)(const value_type&)) const
+   {
+      return seq_count_if<value_type>(data, data + used, pred);
+   }
+
+   bool sequence::min_max(value_type& min_value, value_type& max_value) const
+   {
+      return seq_min_max<value_type>(data, data + used, min_value, max_value);
+   }
+
+   sequence::value_type sequence::sum() const
+   {
+      return seq_sum<value_type>(data, data + used);
+   }
+
+   // binary search for the first item >= target
+   void sequence::seek_lower_bound(const value_type& target)
+   {
+      current_index = size_t(lower_bound(data, data + used, target) - data);
+   }
+
+   // keep ascending order: go to the spot, then insert (or attach at end)
+   void sequence::insert_sorted(const value_type& entry)
+   {
+      seek_lower_bound(entry);
+      if (is_item()) {
+         insert(entry);
+      } else {
+         attach(entry);
+      }
+   }
+
+   // one pass into a fresh array sized for both
+   void sequence::merge(const sequence& other)
+   {
+      // our items get moved out below, so merge a copy with ourselves
+      if (this == &other) {
+         sequence copy(other);
+         merge(copy);
+         return;
+      }
+
+      size_t total = used + other.used;
+      size_t new_capacity = (capacity < total) ? total : capacity;
+      value_type *temp_data = allocate_items<value_type>(*policy, new_capacity);
+
+      std::merge(make_move_iterator(data), make_move_iterator(data + used),
+                 other.data, other.data + other.used, temp_data);
+
+      deallocate_items(*policy, data, capacity);
+      data = temp_data;
+      capacity = new_capacity;
+      used = current_index = total;
+      stats.record_reallocation(capacity);
+   }
+
+   // reallocation count and peak capacity so far
+   const growth_stats& sequence::growth() const
+   {
+      return stats;
+   }
+
+
+   // PRIVATE HELPER FUNCTIONS
+
+   // Pre:  position <= used; the items being added don't live in data.
+   // Post: capacity >= used + count (after at most one reallocation),
+   //       the items from position on have moved count places right,
+   //       and used has grown by count. data[position] through
+   //       data[position + count - 1] are left for the caller to fill.
+   void sequence::open_gap(size_t position, size_t count)
+   {
+      assert(position <= used);
+
+      if(used + count > capacity){
+         resize(policy->next_capacity(capacity, used + count, sizeof(value_type)));}
+
+      shift_items(data + position + count, data + position, used - position);
+      used += count;
+   }
 }
\ No newline at end of file
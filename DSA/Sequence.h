@@ -0,0 +1,313 @@
+// FILE: Sequence.h
+// CLASS PROVIDED: sequence (a container class for a list of items,
+//                 where each list may have a designated item called
+//                 the current item; the items are kept in a dynamic
+//                 array that grows as needed)
+//
+// TYPEDEFS and MEMBER CONSTANTS for the sequence class:
+//   typedef ____ value_type
+//     sequence::value_type is the data type of the items in the
+//     sequence. It may be any of the C++ built-in types (int, char,
+//     etc.), or a class with a default constructor, an assignment
+//     operator, and a copy constructor.
+//   typedef ____ size_type
+//     sequence::size_type is the data type of any variable that keeps
+//     track of how many items are in a sequence.
+//   static const size_type DEFAULT_CAPACITY = _____
+//     sequence::DEFAULT_CAPACITY is the initial capacity of a sequence
+//     that is created by the default constructor.
+//   typedef value_type* iterator
+//   typedef const value_type* const_iterator
+//     Contiguous random-access iterators over the items, first to
+//     last.
+//
+// CONSTRUCTORS for the sequence class:
+//   sequence(size_type initial_capacity = DEFAULT_CAPACITY,
+//            growth_policy* policy = 0)
+//     Pre:  policy is NULL or outlives the sequence (it is not owned).
+//     Post: The sequence has been initialized as an empty sequence.
+//           The insert/attach functions will work efficiently (without
+//           allocating new memory) until this capacity is reached.
+//           (An initial_capacity of 0 is treated as 1.) The array, and
+//           every later one, is obtained from and sized by policy (see
+//           growthPolicy.h); a NULL policy means geometric_growth(1.5,
+//           1), which grows a full array to 1.5 * capacity + 1.
+//   sequence(sequence&& source)
+//     Pre:  (none)
+//     Post: The new sequence has taken over source's array, items and
+//           current item without copying any item; source is left
+//           empty, with no array (it allocates again on the next
+//           insert/attach).
+//
+// MODIFICATION MEMBER FUNCTIONS for the sequence class:
+//   void resize(size_type new_capacity)
+//     Pre:  (none)
+//     Post: The sequence's current capacity is changed to new_capacity
+//           (but not less than the number of items already on the
+//           sequence, and not less than 1).
+//   void reserve(size_type new_capacity)
+//     Pre:  (none)
+//     Post: The capacity is at least new_capacity; the items and the
+//           current item are unchanged. Nothing is reallocated if the
+//           capacity was already big enough.
+//   void shrink_to_fit()
+//     Pre:  (none)
+//     Post: The capacity is size() (or 1 for an empty sequence).
+//   void swap(sequence& other)
+//     Pre:  (none)
+//     Post: The contents, current items and capacities of the invoking
+//           sequence and other have been exchanged in O(1).
+//   void start()
+//     Pre:  (none)
+//     Post: The first item on the sequence becomes the current item
+//           (but if the sequence is empty, then there is no current item).
+//   void advance()
+//     Pre:  is_item() returns true.
+//     Post: If the current item was the last item in the sequence, then
+//           there is no longer any current item. Otherwise, the new current
+//           item is the item immediately after the original current item.
+//   void insert(const value_type& entry)
+//     Pre:  (none)
+//     Post: A new copy of entry has been inserted in the sequence
+//           before the current item. If there was no current item, then
+//           the new entry has been inserted at the front of the sequence.
+//           In either case, the newly inserted item is now the
+//           current item of the sequence.
+//   void attach(const value_type& entry)
+//     Pre:  (none)
+//     Post: A new copy of entry has been inserted in the sequence after
+//           the current item. If there was no current item, then the new
+//           entry has been attached to the end of the sequence. In either
+//           case, the newly inserted item is now the current item of the
+//           sequence.
+//   void remove_current()
+//     Pre:  is_item() returns true.
+//     Post: The current item has been removed from the sequence, and
+//           the item after this (if there is one) is now the new current
+//           item.
+//   void insert_range(const value_type* first, const value_type* last)
+//   template <class ForwardIterator>
+//   void insert_range(ForwardIterator first, ForwardIterator last)
+//   void insert_range(std::initializer_list<value_type> entries)
+//     Pre:  [first, last) is a valid range that is not inside the
+//           invoking sequence. The template takes any forward iterators
+//           (of a vector, list, set, ...) whose items convert to
+//           value_type; it counts the range with std::distance first,
+//           so it must be possible to walk it twice.
+//     Post: Copies of the entries have been inserted, in their original
+//           order, before the current item (at the front if there was
+//           no current item). The first inserted entry is now the
+//           current item (an empty range changes nothing).
+//   void attach_range(const value_type* first, const value_type* last)
+//   template <class ForwardIterator>
+//   void attach_range(ForwardIterator first, ForwardIterator last)
+//   void attach_range(std::initializer_list<value_type> entries)
+//     Pre:  As for insert_range.
+//     Post: Copies of the entries have been inserted, in their original
+//           order, after the current item (at the end if there was no
+//           current item). The last attached entry is now the current
+//           item, just as after the same attach calls one at a time.
+//   void erase_range(size_type count)
+//     Pre:  count == 0, or is_item() returns true and at least count
+//           items remain from the current item on.
+//     Post: The current item and the count - 1 items after it have been
+//           removed. The item after them (if any) is now the current
+//           item.
+//     NOTE: Each range function reallocates at most once and shifts
+//           the items after the cursor at most once, so loading N items
+//           costs O(N + n) instead of O(N * n).
+//   bool find(const value_type& target)
+//     Pre:  (none)
+//     Post: If target occurs, its first occurrence is now the current
+//           item and true has been returned; otherwise false has been
+//           returned and the cursor is unchanged.
+//   void seek_lower_bound(const value_type& target)
+//     Pre:  The items are in ascending order (by operator <).
+//     Post: The current item is the first item that is not less than
+//           target; if every item is less than target there is no
+//           current item. Found by binary search: O(log n).
+//   void insert_sorted(const value_type& entry)
+//     Pre:  The items are in ascending order.
+//     Post: A copy of entry has been inserted before the first item not
+//           less than it (so the items are still in ascending order),
+//           and it is the current item.
+//   void merge(const sequence& other)
+//     Pre:  The items of both sequences are in ascending order.
+//     Post: The invoking sequence holds its own items and copies of
+//           other's, in ascending order (equal items from the invoking
+//           sequence first), and there is no current item. This takes
+//           one linear pass and at most one allocation.
+//     NOTE: The sequence does not check or enforce the order these
+//           three assume; it holds if the sequence was only ever
+//           filled by insert_sorted and merge.
+//   sequence& operator=(sequence&& source)
+//     Pre:  (none)
+//     Post: As the move constructor, after the invoking sequence's own
+//           array has been released.
+//
+// CONSTANT MEMBER FUNCTIONS for the sequence class:
+//   size_type size() const
+//     Pre:  (none)
+//     Post: The return value is the number of items in the sequence.
+//   bool is_item() const
+//     Pre:  (none)
+//     Post: A true return value indicates that there is a valid
+//           "current" item that may be retrieved by activating the current
+//           member function (listed below). A false return value indicates
+//           that there is no valid current item.
+//   const value_type& current() const
+//   value_type& current()
+//     Pre:  is_item() returns true.
+//     Post: A reference to the current item in the sequence has been
+//           returned (no copy is made).
+//   iterator begin() / const_iterator begin() const
+//   iterator end() / const_iterator end() const
+//     Pre:  (none)
+//     Post: The first item / one past the last item has been returned,
+//           so a sequence works with range-for and the standard
+//           algorithms (including the parallel ones). The cursor is not
+//           used or changed.
+//     NOTE: Iterators and references are invalidated by anything that
+//           adds or removes items or changes the capacity.
+//   size_type count_if(bool (*pred)(const value_type&)) const
+//     Pre:  pred can be called from several threads at once.
+//     Post: The number of items for which pred returns true has been
+//           returned. (Use seq_count_if(begin(), end(), f) from
+//           seqAlgo.h for lambdas and function objects.)
+//   bool min_max(value_type& min_value, value_type& max_value) const
+//     Pre:  (none)
+//     Post: false for an empty sequence; otherwise true, with the
+//           smallest and largest item stored in min_value/max_value.
+//   value_type sum() const
+//     Pre:  (none)
+//     Post: The sum of the items has been returned.
+//   (find, count_if, min_max and sum read the items directly through
+//   the vectorized and, for large sequences, multi-threaded kernels of
+//   seqAlgo.h.)
+//   const growth_stats& growth() const
+//     Pre:  (none)
+//     Post: The return value holds the number of reallocations and the
+//           peak capacity of this sequence.
+//
+// VALUE SEMANTICS for the sequence class:
+//    Assignments and the copy constructor may be used with sequence
+//    objects; so may moves, which copy no items. A copy uses the
+//    source's policy; copy assignment keeps the invoking sequence's
+//    policy; moves and swap carry the policy along with the array it
+//    allocated.
+//
+// DYNAMIC MEMORY USAGE by the sequence class:
+//   If there is insufficient dynamic memory, the following functions
+//   throw bad_alloc: the constructors (except the move constructor),
+//   resize, reserve, shrink_to_fit, insert, attach, insert_range,
+//   attach_range, insert_sorted, merge, and the copy assignment
+//   operator.
+
+#ifndef SEQUENCE_CLASS_H
+#define SEQUENCE_CLASS_H
+
+#include <algorithm>          // provides copy
+#include <cstdlib>            // provides size_t
+#include <initializer_list>   // provides initializer_list
+#include <iterator>           // provides distance
+#include "growthPolicy.h"
+
+namespace CS3358_FA2023
+{
+   class sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 30;
+      typedef value_type* iterator;
+      typedef const value_type* const_iterator;
+      // CONSTRUCTORS and DESTRUCTOR
+      sequence(size_type initial_capacity = DEFAULT_CAPACITY,
+               growth_policy* policy = 0);
+      sequence(const sequence& source);
+      sequence(sequence&& source);
+      ~sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void resize(size_type new_capacity);
+      void reserve(size_type new_capacity);
+      void shrink_to_fit();
+      void swap(sequence& other);
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      void insert_range(const value_type* first, const value_type* last);
+      template <class ForwardIterator>
+      void insert_range(ForwardIterator first, ForwardIterator last);
+      void insert_range(std::initializer_list<value_type> entries);
+      void attach_range(const value_type* first, const value_type* last);
+      template <class ForwardIterator>
+      void attach_range(ForwardIterator first, ForwardIterator last);
+      void attach_range(std::initializer_list<value_type> entries);
+      void erase_range(size_type count);
+      bool find(const value_type& target);
+      void seek_lower_bound(const value_type& target);
+      void insert_sorted(const value_type& entry);
+      void merge(const sequence& other);
+      sequence& operator=(const sequence& source);
+      sequence& operator=(sequence&& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      const value_type& current() const;
+      value_type& current();
+      iterator begin();
+      iterator end();
+      const_iterator begin() const;
+      const_iterator end() const;
+      size_type count_if(bool (*pred)(const value_type&)) const;
+      bool min_max(value_type& min_value, value_type& max_value) const;
+      value_type sum() const;
+      const growth_stats& growth() const;
+
+   private:
+      value_type* data;
+      size_type used;
+      size_type current_index;
+      size_type capacity;
+      growth_policy* policy;
+      growth_stats stats;
+      void open_gap(size_type position, size_type count);
+   };
+
+   // The member templates have to be visible to every caller, so they
+   // are defined here rather than in Sequence.cpp. Like the pointer
+   // forms, they open the gap once (std::distance gives its size up
+   // front) and copy the range straight into it.
+
+   template <class ForwardIterator>
+   void sequence::insert_range(ForwardIterator first, ForwardIterator last)
+   {
+      size_type count = size_type(std::distance(first, last));
+      if (count == 0) return;
+
+      if(!is_item()) {
+         current_index = 0;}
+
+      open_gap(current_index, count);
+      std::copy(first, last, data + current_index);
+   }
+
+   template <class ForwardIterator>
+   void sequence::attach_range(ForwardIterator first, ForwardIterator last)
+   {
+      size_type count = size_type(std::distance(first, last));
+      if (count == 0) return;
+
+      size_type position = is_item() ? current_index + 1 : used;
+
+      open_gap(position, count);
+      std::copy(first, last, data + position);
+      current_index = position + count - 1;
+   }
+}
+
+#endif
@@ -1,121 +1,317 @@
+// FILE: btNode.cpp
+// The bst_* functions keep the tree an AVL tree, so every operation is
+// O(log n) whatever order the keys arrive in (sorted input used to make
+// a chain of right children).
+// INVARIANT for a tree of btNodes:
+//   1. Keys in a node's left subtree are smaller than its data, keys in
+//      its right subtree are bigger (no duplicates).
+//   2. Each node's height is 1 + the larger of its children's heights
+//      (an empty subtree has height 0), and the two heights differ by
+//      at most 1, so the tree is at most about 1.44 log2(n) deep.
+//   3. Each node's size is 1 + the sizes of its children (an empty
+//      subtree has size 0): the number of nodes in its subtree.
+
 #include "btNode.h"
+#include "nodePool.h"
+#include <algorithm>   // provides sort, unique
+#include <cassert>     // provides assert
+#include <vector>      // provides vector
 
-void bst_insert(btNode*& bst_root, int insInt) {
-   btNode* newNode = new btNode;
-   newNode->data = insInt;
-   newNode->left = newNode->right = nullptr;
-
-   if (bst_root == nullptr) {
-      bst_root = newNode;
-      return;
-   }
-
-   btNode* current = bst_root;
-   btNode* parent = nullptr;
-   while (current != nullptr) {
-      parent = current;
-      if (insInt < current->data) {
-         current = current->left;
-      } else if (insInt > current->data) {
-         current = current->right;
-      } else { // Node w same val
-         delete newNode; // Clean up, no insert
-         return;
-      }
-   }
+using CS3358_FA2023::node_pool;
+
+// ===== AVL helpers =====
+
+static int height(const btNode* node)
+{
+   return (node == 0) ? 0 : node->height;
+}
+
+static int size(const btNode* node)
+{
+   return (node == 0) ? 0 : node->size;
+}
 
-   if (insInt < parent->data) {
-      parent->left = newNode;
+// Recomputes node's height and size from its children.
+static void update(btNode* node)
+{
+   int lh = height(node->left), rh = height(node->right);
+   node->height = 1 + ((lh > rh) ? lh : rh);
+   node->size = 1 + size(node->left) + size(node->right);
+}
+
+/*       node            pivot
+        /    \          /     \
+     pivot    c   ->   a      node
+     /   \                    /   \
+    a     b                  b     c
+*/
+static void rotate_right(btNode*& node)
+{
+   btNode* pivot = node->left;
+   node->left = pivot->right;
+   pivot->right = node;
+   update(node);
+   update(pivot);
+   node = pivot;
+}
+
+static void rotate_left(btNode*& node)
+{
+   btNode* pivot = node->right;
+   node->right = pivot->left;
+   pivot->left = node;
+   update(node);
+   update(pivot);
+   node = pivot;
+}
+
+// Fixes node's height and size and, if its children's heights now differ by 2,
+// restores the balance with a single or double rotation.
+static void rebalance(btNode*& node)
+{
+   int balance = height(node->left) - height(node->right);
+   if (balance > 1) {
+      if (height(node->left->left) < height(node->left->right))
+         rotate_left(node->left);
+      rotate_right(node);
+   } else if (balance < -1) {
+      if (height(node->right->right) < height(node->right->left))
+         rotate_right(node->right);
+      rotate_left(node);
    } else {
-      parent->right = newNode;
+      update(node);
    }
 }
 
-bool bst_remove(btNode*& bst_root, int remInt) {
-   if (bst_root == nullptr){return false;}
-
-   btNode* current = bst_root;
-   btNode* parent = nullptr;
-   bool isLC = false;
-
-   // Find node to remove
-   while (current != nullptr && current->data != remInt) {
-      parent = current;
-      if (remInt < current->data) {
-         isLC = true;
-         current = current->left;
-      } else {
-         isLC = false;
-         current = current->right;
-      }
+// Links left, node and right into one AVL tree (every key in left is
+// smaller than node's, every key in right bigger) whatever their
+// heights, and returns its root. Descends the taller side's inner
+// spine to a subtree about as tall as the other side, hangs node
+// there and rebalances back up: O(height difference + 1).
+static btNode* join(btNode* left, btNode* node, btNode* right)
+{
+   int lh = height(left), rh = height(right);
+   if (lh > rh + 1) {
+      left->right = join(left->right, node, right);
+      rebalance(left);
+      return left;
    }
-
-   if (current == nullptr) {
-      return false; // Value not found
+   if (rh > lh + 1) {
+      right->left = join(left, node, right->left);
+      rebalance(right);
+      return right;
    }
+   node->left = left;
+   node->right = right;
+   update(node);
+   return node;
+}
 
-   // C1: Node w/ 2 children
-   if (current->left != nullptr && current->right != nullptr) {
-      // find prev (maximum in left subtree)
-      btNode* prev = current->left;
-      btNode* prevTop = current;
-      while (prev->right != nullptr) {
-         prevTop = prev;
-         prev = prev->right;
-      }
+// ===== insert / remove =====
+// pool is NULL for nodes from new/delete.
 
-      // Copy prev data to current node
-      current->data = prev->data;
+static btNode* new_node(node_pool<btNode>* pool)
+{
+   return (pool == 0) ? new btNode : pool->allocate();
+}
+
+static void free_node(btNode* node, node_pool<btNode>* pool)
+{
+   if (pool == 0) delete node;
+   else pool->deallocate(node);
+}
 
-      // Remove prev
-      if (prevTop == current) {
-         prevTop->left = prev->left;
+// Iterative, in O(1) space: while the top node has a left child,
+// rotate it up; once it has none, free it and continue with its
+// right subtree. Each node is rotated up at most once.
+static void clear_aux(btNode* node, node_pool<btNode>* pool)
+{
+   while (node != 0) {
+      if (node->left != 0) {
+         btNode* pivot = node->left;
+         node->left = pivot->right;
+         pivot->right = node;
+         node = pivot;
       } else {
-         prevTop->right = prev->left;
+         btNode* doomed = node;
+         node = node->right;
+         free_node(doomed, pool);
       }
-      delete prev;
    }
+}
 
-   // C2: Node w/ 1 child/null child
-   else {
-      btNode* child = (current->left != nullptr) ? current->left : current->right;
-      if (parent == nullptr) {
-            bst_root = child; // Root begone
-      } else {
-         if (isLC) {
-               parent->left = child;
-         } else {
-               parent->right = child;
-         }
-      }
-      delete current;
+static bool insert_aux(btNode*& node, int insInt, node_pool<btNode>* pool)
+{
+   if (node == 0) {
+      node = new_node(pool);
+      node->data = insInt;
+      node->left = node->right = 0;
+      node->height = 1;
+      node->size = 1;
+      return true;
    }
 
-   return true;
+   bool inserted;
+   if (insInt < node->data) {
+      inserted = insert_aux(node->left, insInt, pool);
+   } else if (insInt > node->data) {
+      inserted = insert_aux(node->right, insInt, pool);
+   } else { // Node w same val, no insert
+      return false;
+   }
+
+   if (inserted) rebalance(node);
+   return inserted;
 }
 
-void bst_remove_max(btNode*& bst_root, int& remInt) {
-   if (bst_root == nullptr) return;
+void bst_insert(btNode*& bst_root, int insInt) {
+   insert_aux(bst_root, insInt, 0);
+}
+
+void bst_insert(btNode*& bst_root, int insInt, node_pool<btNode>& pool) {
+   insert_aux(bst_root, insInt, &pool);
+}
 
-   btNode* current = bst_root;
-   btNode* parent = nullptr;
-   while (current->right != nullptr) {
-      parent = current;
-      current = current->right;
+// Unlinks the largest node under node (not NULL) and returns it,
+// rebalancing on the way back up.
+static btNode* unlink_max(btNode*& node)
+{
+   if (node->right == 0) {
+      btNode* largest = node;
+      node = node->left;
+      return largest;
    }
+   btNode* largest = unlink_max(node->right);
+   rebalance(node);
+   return largest;
+}
+
+// join without a middle node: the largest of left is taken out to link
+// the two.
+static btNode* join2(btNode* left, btNode* right)
+{
+   if (left == 0) return right;
+   if (right == 0) return left;
+   btNode* middle = unlink_max(left);
+   return join(left, middle, right);
+}
+
+// Removes the largest node under node, handing its value back in
+// remInt.
+static void remove_max_aux(btNode*& node, int& remInt, node_pool<btNode>* pool)
+{
+   btNode* largest = unlink_max(node);
+   remInt = largest->data;
+   free_node(largest, pool);
+}
 
-   remInt = current->data;
+static bool remove_aux(btNode*& node, int remInt, node_pool<btNode>* pool)
+{
+   if (node == 0) return false; // Value not found
 
-   if (parent == nullptr) { 
-      // Root is  max
-      bst_root = bst_root->left;
+   bool removed;
+   if (remInt < node->data) {
+      removed = remove_aux(node->left, remInt, pool);
+   } else if (remInt > node->data) {
+      removed = remove_aux(node->right, remInt, pool);
+   } else if (node->left != 0 && node->right != 0) {
+      // C1: Node w/ 2 children, take over prev (maximum in left subtree)
+      remove_max_aux(node->left, node->data, pool);
+      removed = true;
    } else {
-      parent->right = current->left;
+      // C2: Node w/ 1 child/null child
+      btNode* doomed = node;
+      node = (node->left != 0) ? node->left : node->right;
+      free_node(doomed, pool);
+      return true;
    }
 
-   delete current;
+   if (removed) rebalance(node);
+   return removed;
+}
+
+bool bst_remove(btNode*& bst_root, int remInt) {
+   return remove_aux(bst_root, remInt, 0);
+}
+
+bool bst_remove(btNode*& bst_root, int remInt, node_pool<btNode>& pool) {
+   return remove_aux(bst_root, remInt, &pool);
+}
+
+void bst_remove_max(btNode*& bst_root, int& remInt) {
+   if (bst_root == 0) return;
+   remove_max_aux(bst_root, remInt, 0);
+}
+
+void bst_remove_max(btNode*& bst_root, int& remInt, node_pool<btNode>& pool) {
+   if (bst_root == 0) return;
+   remove_max_aux(bst_root, remInt, &pool);
+}
+
+
+// ===== bulk build =====
+
+// Builds keys[lo .. hi-1] with the middle key on top; each node is
+// allocated before its subtrees, so a pool lays the tree out in
+// pre-order.
+static btNode* build_aux(const int* keys, int lo, int hi, node_pool<btNode>* pool)
+{
+   if (lo >= hi) return 0;
+   int mid = lo + (hi - lo) / 2;
+   btNode* node = new_node(pool);
+   node->data = keys[mid];
+   node->left = build_aux(keys, lo, mid, pool);
+   node->right = build_aux(keys, mid + 1, hi, pool);
+   update(node);
+   return node;
+}
+
+#ifndef NDEBUG
+static bool strictly_increasing(const int* keys, int n)
+{
+   for (int i = 1; i < n; ++i)
+      if (keys[i - 1] >= keys[i]) return false;
+   return true;
+}
+#endif
+
+btNode* bst_build_from_sorted(const int* keys, int n)
+{
+   assert(strictly_increasing(keys, n));
+   return build_aux(keys, 0, n, 0);
 }
 
+btNode* bst_build_from_sorted(const int* keys, int n, node_pool<btNode>& pool)
+{
+   assert(strictly_increasing(keys, n));
+   if (n > 0) pool.reserve(n);
+   return build_aux(keys, 0, n, &pool);
+}
+
+// Sorted, duplicate-free copy of keys[0 .. n-1].
+static void sorted_unique(const int* keys, int n, std::vector<int>& out)
+{
+   out.assign(keys, keys + ((n > 0) ? n : 0));
+   std::sort(out.begin(), out.end());
+   out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+btNode* bst_build_from_unsorted(const int* keys, int n)
+{
+   std::vector<int> sorted;
+   sorted_unique(keys, n, sorted);
+   return sorted.empty() ? 0 : bst_build_from_sorted(&sorted[0], int(sorted.size()));
+}
+
+btNode* bst_build_from_unsorted(const int* keys, int n, node_pool<btNode>& pool)
+{
+   std::vector<int> sorted;
+   sorted_unique(keys, n, sorted);
+   return sorted.empty() ? 0 : bst_build_from_sorted(&sorted[0], int(sorted.size()),
+                                                     pool);
+}
+
+// ===== export =====
 
 void portToArrayInOrder(btNode* bst_root, int* portArray)
 {
@@ -124,25 +320,282 @@ void portToArrayInOrder(btNode* bst_root, int* portArray)
    portToArrayInOrderAux(bst_root, portArray, portIndex);
 }
 
+// Morris traversal: no recursion and no stack, so a tree of any shape
+// can be exported. Before descending into a left subtree, its largest
+// node's (empty) right link is pointed back at the current node, which
+// is how the walk climbs back up; the link is cleared on the second
+// visit, so the tree is unchanged afterwards.
 void portToArrayInOrderAux(btNode* bst_root, int* portArray, int& portIndex)
 {
-   if (bst_root == 0) return;
-   portToArrayInOrderAux(bst_root->left, portArray, portIndex);
-   portArray[portIndex++] = bst_root->data;
-   portToArrayInOrderAux(bst_root->right, portArray, portIndex);
+   btNode* node = bst_root;
+   while (node != 0) {
+      if (node->left == 0) {
+         portArray[portIndex++] = node->data;
+         node = node->right;
+         continue;
+      }
+      btNode* prev = node->left;
+      while (prev->right != 0 && prev->right != node)
+         prev = prev->right;
+      if (prev->right == 0) {    // first visit: thread and go left
+         prev->right = node;
+         node = node->left;
+      } else {                   // back from the left subtree
+         prev->right = 0;
+         portArray[portIndex++] = node->data;
+         node = node->right;
+      }
+   }
+}
+
+// Everything fits: the full Morris walk. Otherwise walk in order with
+// an explicit stack (O(height)) and stop at capacity.
+int portToArrayInOrder(btNode* bst_root, int* portArray, int capacity)
+{
+   int total = size(bst_root);
+   if (total <= capacity) {
+      portToArrayInOrder(bst_root, portArray);
+      return total;
+   }
+
+   std::vector<const btNode*> path;
+   const btNode* node = bst_root;
+   int written = 0;
+   while (written < capacity) {
+      for (; node != 0; node = node->left)
+         path.push_back(node);
+      node = path.back();
+      path.pop_back();
+      portArray[written++] = node->data;
+      node = node->right;
+   }
+   return total;
 }
 
 void tree_clear(btNode*& root)
 {
-   if (root == 0) return;
-   tree_clear(root->left);
-   tree_clear(root->right);
-   delete root;
+   clear_aux(root, 0);
+   root = 0;
+}
+
+void tree_clear(btNode*& root, node_pool<btNode>& pool)
+{
+   pool.release_all();
    root = 0;
 }
 
 int bst_size(btNode* bst_root)
 {
-   if (bst_root == 0) return 0;
-   return 1 + bst_size(bst_root->left) + bst_size(bst_root->right);
+   return size(bst_root);
+}
+
+// ===== order statistics =====
+
+// Number of keys < value (or <= value when inclusive): walk down to
+// value, adding each left subtree (and node) passed on the right.
+static int count_below(const btNode* node, int value, bool inclusive)
+{
+   int count = 0;
+   while (node != 0) {
+      if (node->data < value || (inclusive && node->data == value)) {
+         count += size(node->left) + 1;
+         node = node->right;
+      } else {
+         node = node->left;
+      }
+   }
+   return count;
+}
+
+int bst_rank(btNode* bst_root, int value)
+{
+   return count_below(bst_root, value, false);
+}
+
+bool bst_select(btNode* bst_root, int k, int& value)
+{
+   if (k < 0 || k >= size(bst_root)) return false;
+   const btNode* node = bst_root;
+   for (;;) {
+      int left = size(node->left);
+      if (k < left) {
+         node = node->left;
+      } else if (k > left) {
+         k -= left + 1;
+         node = node->right;
+      } else {
+         value = node->data;
+         return true;
+      }
+   }
+}
+
+int bst_count_range(btNode* bst_root, int lo, int hi)
+{
+   if (lo > hi) return 0;
+   return count_below(bst_root, hi, true) - count_below(bst_root, lo, false);
+}
+
+// ===== range and batch operations =====
+
+int bst_range(btNode* bst_root, int lo, int hi,
+              void (*visit)(int key, void* context), void* context)
+{
+   if (lo > hi) return 0;
+   std::vector<const btNode*> path;
+   path.reserve(height(bst_root));
+   const btNode* node = bst_root;
+   int visited = 0;
+   for (;;) {
+      // go left, but skip straight past nodes (and their left
+      // subtrees) below lo
+      while (node != 0) {
+         if (node->data < lo) {
+            node = node->right;
+         } else {
+            path.push_back(node);
+            node = node->left;
+         }
+      }
+      if (path.empty()) break;
+      node = path.back();
+      path.pop_back();
+      if (node->data > hi) break;
+      visit(node->data, context);
+      ++visited;
+      node = node->right;
+   }
+   return visited;
+}
+
+// The keys of node's tree below lo / above hi, as an AVL tree; the
+// other nodes are freed. Like splitting the tree at lo: one path down,
+// re-joining what is kept on the way back up.
+static btNode* keep_below(btNode* node, int lo, node_pool<btNode>* pool)
+{
+   if (node == 0) return 0;
+   btNode* left = node->left;
+   if (node->data >= lo) {
+      clear_aux(node->right, pool);
+      free_node(node, pool);
+      return keep_below(left, lo, pool);
+   }
+   btNode* right = keep_below(node->right, lo, pool);
+   return join(left, node, right);
+}
+
+static btNode* keep_above(btNode* node, int hi, node_pool<btNode>* pool)
+{
+   if (node == 0) return 0;
+   btNode* right = node->right;
+   if (node->data <= hi) {
+      clear_aux(node->left, pool);
+      free_node(node, pool);
+      return keep_above(right, hi, pool);
+   }
+   btNode* left = keep_above(node->left, hi, pool);
+   return join(left, node, right);
+}
+
+// Walks down to the first node inside [lo, hi]; below it, the left
+// subtree keeps only keys < lo and the right only keys > hi.
+static btNode* remove_range_aux(btNode* node, int lo, int hi, node_pool<btNode>* pool)
+{
+   if (node == 0) return 0;
+   btNode* left = node->left;
+   btNode* right = node->right;
+   if (node->data < lo)
+      return join(left, node, remove_range_aux(right, lo, hi, pool));
+   if (node->data > hi)
+      return join(remove_range_aux(left, lo, hi, pool), node, right);
+   left = keep_below(left, lo, pool);
+   right = keep_above(right, hi, pool);
+   free_node(node, pool);
+   return join2(left, right);
+}
+
+int bst_remove_range(btNode*& bst_root, int lo, int hi)
+{
+   if (lo > hi) return 0;
+   int before = size(bst_root);
+   bst_root = remove_range_aux(bst_root, lo, hi, 0);
+   return before - size(bst_root);
+}
+
+int bst_remove_range(btNode*& bst_root, int lo, int hi, node_pool<btNode>& pool)
+{
+   if (lo > hi) return 0;
+   int before = size(bst_root);
+   bst_root = remove_range_aux(bst_root, lo, hi, &pool);
+   return before - size(bst_root);
+}
+
+// Merges sorted keys[lo .. hi-1] into node's tree: the keys split
+// around node's key, each part goes into its own subtree (an empty
+// subtree is built from its part directly) and the three are joined
+// again. Subtrees no key falls into are not visited.
+static btNode* insert_many_aux(btNode* node, const int* keys, int lo, int hi,
+                               node_pool<btNode>* pool)
+{
+   if (lo >= hi) return node;
+   if (node == 0) return build_aux(keys, lo, hi, pool);
+   int mid = int(std::lower_bound(keys + lo, keys + hi, node->data) - keys);
+   int skip = (mid < hi && keys[mid] == node->data) ? 1 : 0;
+   btNode* left = insert_many_aux(node->left, keys, lo, mid, pool);
+   btNode* right = insert_many_aux(node->right, keys, mid + skip, hi, pool);
+   return join(left, node, right);
+}
+
+// The same split, dropping node if its key is in the batch.
+static btNode* remove_many_aux(btNode* node, const int* keys, int lo, int hi,
+                               node_pool<btNode>* pool)
+{
+   if (lo >= hi || node == 0) return node;
+   int mid = int(std::lower_bound(keys + lo, keys + hi, node->data) - keys);
+   bool found = mid < hi && keys[mid] == node->data;
+   btNode* left = remove_many_aux(node->left, keys, lo, mid, pool);
+   btNode* right = remove_many_aux(node->right, keys, mid + (found ? 1 : 0), hi, pool);
+   if (!found) return join(left, node, right);
+   free_node(node, pool);
+   return join2(left, right);
+}
+
+static int insert_many(btNode*& bst_root, const int* keys, int n, node_pool<btNode>* pool)
+{
+   std::vector<int> batch;
+   sorted_unique(keys, n, batch);
+   if (batch.empty()) return 0;
+   int before = size(bst_root);
+   bst_root = insert_many_aux(bst_root, &batch[0], 0, int(batch.size()), pool);
+   return size(bst_root) - before;
+}
+
+static int remove_many(btNode*& bst_root, const int* keys, int n, node_pool<btNode>* pool)
+{
+   std::vector<int> batch;
+   sorted_unique(keys, n, batch);
+   if (batch.empty()) return 0;
+   int before = size(bst_root);
+   bst_root = remove_many_aux(bst_root, &batch[0], 0, int(batch.size()), pool);
+   return before - size(bst_root);
+}
+
+int bst_insert_many(btNode*& bst_root, const int* keys, int n)
+{
+   return insert_many(bst_root, keys, n, 0);
+}
+
+int bst_insert_many(btNode*& bst_root, const int* keys, int n, node_pool<btNode>& pool)
+{
+   return insert_many(bst_root, keys, n, &pool);
+}
+
+int bst_remove_many(btNode*& bst_root, const int* keys, int n)
+{
+   return remove_many(bst_root, keys, n, 0);
+}
+
+int bst_remove_many(btNode*& bst_root, const int* keys, int n, node_pool<btNode>& pool)
+{
+   return remove_many(bst_root, keys, n, &pool);
 }
@@ -0,0 +1,167 @@
+// FILE: btNode.h
+// PROVIDES: btNode (a node of a binary search tree of ints) and
+//           functions that work on a tree of btNodes through a pointer
+//           to its root (NULL for an empty tree)
+//
+// The bst_* functions keep the tree an AVL tree (see btNode.cpp), so
+// each of them is O(log n) whatever order the keys arrive in.
+//
+// FIELDS of a btNode:
+//   int data
+//     The key.
+//   btNode* left / btNode* right
+//     The roots of the subtrees with the smaller / bigger keys.
+//   int height
+//     The number of nodes on the longest path down from this node (a
+//     leaf has height 1).
+//   int size
+//     The number of nodes in the subtree rooted at this node.
+//   The bst_* functions set height and size; code that builds nodes by
+//   hand must give a leaf height 1 and size 1.
+//
+// FUNCTIONS for a tree of btNodes:
+//   void bst_insert(btNode*& bst_root, int insInt)
+//     Pre:  bst_root is the root of a tree built by these functions.
+//     Post: If insInt was not in the tree, it has been added;
+//           otherwise the tree is unchanged.
+//   bool bst_remove(btNode*& bst_root, int remInt)
+//     Pre:  bst_root is the root of a tree built by these functions.
+//     Post: If remInt was in the tree, it has been removed and true has
+//           been returned; otherwise the tree is unchanged and false
+//           has been returned.
+//   void bst_remove_max(btNode*& bst_root, int& remInt)
+//     Pre:  bst_root is the root of a tree built by these functions.
+//     Post: If the tree was not empty, its largest key has been removed
+//           and put in remInt; otherwise nothing has changed.
+//   void portToArrayInOrder(btNode* bst_root, int* portArray)
+//     Pre:  portArray has room for every key in the tree.
+//     Post: The keys have been written to portArray in increasing
+//           order.
+//   void portToArrayInOrderAux(btNode* bst_root, int* portArray,
+//                              int& portIndex)
+//     Pre:  portArray has room for portIndex + the number of keys.
+//     Post: The keys have been written in increasing order from
+//           portArray[portIndex] on, and portIndex has been advanced
+//           past them.
+//   void tree_clear(btNode*& root)
+//     Pre:  (none)
+//     Post: Every node of the tree has been deleted and root is NULL.
+//   int bst_size(btNode* bst_root)
+//     Pre:  (none)
+//     Post: The number of nodes in the tree has been returned, in O(1).
+//   int bst_rank(btNode* bst_root, int value)
+//     Pre:  (none)
+//     Post: The number of keys smaller than value has been returned
+//           (value's 0-based position if it is in the tree), in
+//           O(log n).
+//   bool bst_select(btNode* bst_root, int k, int& value)
+//     Pre:  (none)
+//     Post: If 0 <= k < bst_size(bst_root), the key with k smaller keys
+//           has been put in value and true has been returned;
+//           otherwise false has been returned and value is unchanged.
+//           O(log n).
+//   int bst_count_range(btNode* bst_root, int lo, int hi)
+//     Pre:  (none)
+//     Post: The number of keys in [lo, hi] has been returned (0 if
+//           lo > hi), in O(log n).
+//   int bst_range(btNode* bst_root, int lo, int hi,
+//                 void (*visit)(int key, void* context), void* context)
+//     Post: visit(key, context) has been called for each key in
+//           [lo, hi], in increasing order, and the number of calls has
+//           been returned (0 if lo > hi). O(log n + keys visited): only
+//           the path to lo and the nodes in the range are touched.
+//   int bst_remove_range(btNode*& bst_root, int lo, int hi)
+//     Post: Every key in [lo, hi] has been removed and the number
+//           removed has been returned (0 if lo > hi). O(log n + keys
+//           removed): the tree is split around the range and the
+//           remaining parts are joined again.
+//   int bst_insert_many(btNode*& bst_root, const int* keys, int n)
+//   int bst_remove_many(btNode*& bst_root, const int* keys, int n)
+//     Post: keys[0 .. n-1] (in any order, duplicates allowed) have
+//           been inserted / removed, and the number of keys actually
+//           added / removed has been returned. The batch is sorted and
+//           the tree walked once, entering only the subtrees some key
+//           of the batch falls into: O(m log(n / m + 1)) tree work for
+//           a batch of m keys, plus O(m log m) for the sort.
+//   btNode* bst_build_from_sorted(const int* keys, int n)
+//     Pre:  keys[0 .. n-1] are in strictly increasing order.
+//     Post: The root of a new, perfectly balanced tree of those keys
+//           has been returned (NULL if n <= 0), built in O(n) with no
+//           comparisons.
+//   btNode* bst_build_from_unsorted(const int* keys, int n)
+//     Post: As bst_build_from_sorted for keys sorted with duplicates
+//           dropped (O(n log n) for the sort; keys is not changed).
+//   int portToArrayInOrder(btNode* bst_root, int* portArray, int capacity)
+//     Pre:  portArray has room for capacity ints (capacity >= 0).
+//     Post: The smallest min(capacity, bst_size(bst_root)) keys have
+//           been written to portArray in increasing order, and
+//           bst_size(bst_root) has been returned: a return value above
+//           capacity means the export was cut short.
+//
+// NODE POOL OVERLOADS (see nodePool.h):
+//   void bst_insert(btNode*& bst_root, int insInt, node_pool<btNode>& pool)
+//   bool bst_remove(btNode*& bst_root, int remInt, node_pool<btNode>& pool)
+//   void bst_remove_max(btNode*& bst_root, int& remInt, node_pool<btNode>& pool)
+//     Post: As without pool, but nodes come from and go back to pool.
+//   void tree_clear(btNode*& root, node_pool<btNode>& pool)
+//     Pre:  pool holds no nodes but root's tree.
+//     Post: Every node has been released at once (pool.release_all(),
+//           O(1)) and root is NULL.
+//   btNode* bst_build_from_sorted(const int* keys, int n, node_pool<btNode>& pool)
+//   btNode* bst_build_from_unsorted(const int* keys, int n, node_pool<btNode>& pool)
+//     Post: As without pool; the n nodes are one contiguous block
+//           (pool.reserve(n)), laid out parent before children.
+//   bst_remove_range, bst_insert_many and bst_remove_many also take the
+//   pool as the last argument.
+//   A tree built with the pool overloads must only be changed and
+//   cleared through them, with the same pool.
+
+#ifndef BT_NODE_H
+#define BT_NODE_H
+
+#include "nodePool.h"
+
+struct btNode
+{
+   int data;
+   btNode* left;
+   btNode* right;
+   int height;
+   int size;
+};
+
+void bst_insert(btNode*& bst_root, int insInt);
+bool bst_remove(btNode*& bst_root, int remInt);
+void bst_remove_max(btNode*& bst_root, int& remInt);
+void portToArrayInOrder(btNode* bst_root, int* portArray);
+void portToArrayInOrderAux(btNode* bst_root, int* portArray, int& portIndex);
+void tree_clear(btNode*& root);
+int bst_size(btNode* bst_root);
+int bst_rank(btNode* bst_root, int value);
+bool bst_select(btNode* bst_root, int k, int& value);
+int bst_count_range(btNode* bst_root, int lo, int hi);
+int bst_range(btNode* bst_root, int lo, int hi,
+              void (*visit)(int key, void* context), void* context);
+int bst_remove_range(btNode*& bst_root, int lo, int hi);
+int bst_insert_many(btNode*& bst_root, const int* keys, int n);
+int bst_remove_many(btNode*& bst_root, const int* keys, int n);
+btNode* bst_build_from_sorted(const int* keys, int n);
+btNode* bst_build_from_unsorted(const int* keys, int n);
+int portToArrayInOrder(btNode* bst_root, int* portArray, int capacity);
+
+void bst_insert(btNode*& bst_root, int insInt, CS3358_FA2023::node_pool<btNode>& pool);
+bool bst_remove(btNode*& bst_root, int remInt, CS3358_FA2023::node_pool<btNode>& pool);
+void bst_remove_max(btNode*& bst_root, int& remInt, CS3358_FA2023::node_pool<btNode>& pool);
+void tree_clear(btNode*& root, CS3358_FA2023::node_pool<btNode>& pool);
+btNode* bst_build_from_sorted(const int* keys, int n,
+                              CS3358_FA2023::node_pool<btNode>& pool);
+btNode* bst_build_from_unsorted(const int* keys, int n,
+                                CS3358_FA2023::node_pool<btNode>& pool);
+int bst_remove_range(btNode*& bst_root, int lo, int hi,
+                     CS3358_FA2023::node_pool<btNode>& pool);
+int bst_insert_many(btNode*& bst_root, const int* keys, int n,
+                    CS3358_FA2023::node_pool<btNode>& pool);
+int bst_remove_many(btNode*& bst_root, const int* keys, int n,
+                    CS3358_FA2023::node_pool<btNode>& pool);
+
+#endif
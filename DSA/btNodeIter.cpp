@@ -0,0 +1,97 @@
+// FILE: btNodeIter.cpp
+//       Implementation file for the btNode iterators
+//       (See btNodeIter.h for documentation.)
+
+#include "btNodeIter.h"
+
+using CS3358_FA2023_A04_sequence::item_range;
+
+// ===== in-order =====
+
+void bst_in_order_iterator::push_left_spine(const btNode* node)
+{
+   for (; node != 0; node = node->left)
+      path.push_back(node);
+}
+
+bst_in_order_iterator::bst_in_order_iterator(const btNode* root)
+{
+   push_left_spine(root);
+}
+
+// The next node is the leftmost in the current node's right subtree,
+// or else the nearest ancestor still on the path.
+bst_in_order_iterator& bst_in_order_iterator::operator++()
+{
+   const btNode* done = path.back();
+   path.pop_back();
+   push_left_spine(done->right);
+   return *this;
+}
+
+// ===== pre-order =====
+
+bst_pre_order_iterator::bst_pre_order_iterator(const btNode* root)
+{
+   if (root != 0) path.push_back(root);
+}
+
+bst_pre_order_iterator& bst_pre_order_iterator::operator++()
+{
+   const btNode* done = path.back();
+   path.pop_back();
+   if (done->right != 0) path.push_back(done->right);
+   if (done->left != 0) path.push_back(done->left);
+   return *this;
+}
+
+// ===== post-order =====
+
+// Walks down to the first node of node's subtree in post-order: left
+// whenever possible, else right, until a leaf.
+void bst_post_order_iterator::push_first_leaf(const btNode* node)
+{
+   while (node != 0) {
+      path.push_back(node);
+      node = (node->left != 0) ? node->left : node->right;
+   }
+}
+
+bst_post_order_iterator::bst_post_order_iterator(const btNode* root)
+{
+   push_first_leaf(root);
+}
+
+// After a node come its parent's right subtree (if the node was the
+// left child and there is one), then the parent itself.
+bst_post_order_iterator& bst_post_order_iterator::operator++()
+{
+   const btNode* done = path.back();
+   path.pop_back();
+   if (!path.empty()) {
+      const btNode* parent = path.back();
+      if (parent->left == done && parent->right != 0)
+         push_first_leaf(parent->right);
+   }
+   return *this;
+}
+
+// ===== ranges =====
+
+item_range<bst_in_order_iterator> bst_in_order(const btNode* root)
+{
+   return item_range<bst_in_order_iterator>(bst_in_order_iterator(root),
+                                            bst_in_order_iterator());
+}
+
+item_range<bst_pre_order_iterator> bst_pre_order(const btNode* root)
+{
+   return item_range<bst_pre_order_iterator>(bst_pre_order_iterator(root),
+                                             bst_pre_order_iterator());
+}
+
+item_range<bst_post_order_iterator> bst_post_order(const btNode* root)
+{
+   return item_range<bst_post_order_iterator>(bst_post_order_iterator(root),
+                                              bst_post_order_iterator());
+}
@@ -0,0 +1,154 @@
+// FILE: btNodeIter.h
+// CLASSES PROVIDED: bst_in_order_iterator, bst_pre_order_iterator and
+//   bst_post_order_iterator (forward iterators over the keys of a tree
+//   of btNodes), and the functions bst_in_order, bst_pre_order and
+//   bst_post_order, which hand out a range of each kind for range-for
+//   and the standard algorithms.
+//
+//   The iterators keep the path from the root to the current node in a
+//   vector rather than recursing, so a tree of any shape can be walked
+//   (a chain of millions of nodes overflows the call stack in a
+//   recursive walk), and the walk can stop or pause at any node.
+//
+//   Example:
+//      btNode* root = 0;
+//      ...
+//      for (int key : bst_in_order(root)) ...
+//      std::vector<int> keys(bst_in_order(root).begin(),
+//                            bst_in_order(root).end());
+//
+// MEMBER FUNCTIONS for each iterator class:
+//   iterator()
+//     Post: The iterator is an end iterator (it equals every other
+//           end iterator).
+//   explicit iterator(const btNode* root)
+//     Post: The iterator is at the first node of root's tree in its
+//           order (an end iterator if root is NULL).
+//   const int& operator*() const
+//   const int* operator->() const
+//     Pre:  The iterator is not an end iterator.
+//     Post: The current node's key has been returned.
+//   const btNode* node() const
+//     Post: The current node has been returned (NULL at the end).
+//   iterator& operator++() / iterator operator++(int)
+//     Pre:  The iterator is not an end iterator.
+//     Post: The iterator has moved to the next node in its order
+//           (in-order: increasing keys; pre-order: a node before its
+//           left subtree, then its right subtree; post-order: a node
+//           after both of its subtrees), or to the end.
+//   bool operator==(const iterator&) const / operator!=
+//     Post: Whether both iterators are at the same node (or both at
+//           the end) has been returned.
+//
+// FUNCTIONS PROVIDED:
+//   item_range<bst_in_order_iterator> bst_in_order(const btNode* root)
+//   item_range<bst_pre_order_iterator> bst_pre_order(const btNode* root)
+//   item_range<bst_post_order_iterator> bst_post_order(const btNode* root)
+//     Post: The [first node, end) range of root's tree in that order
+//           has been returned. (The range's size() can't be used with
+//           these iterators; bst_size gives the count.)
+//
+// NOTE: Like item_range, an iterator is a view. It becomes invalid as
+//       soon as a node is inserted into or removed from the tree. The
+//       iterators hold O(height) pointers: O(log n) for trees the bst_*
+//       functions built, O(n) at worst for trees built by hand.
+
+#ifndef BT_NODE_ITER_H
+#define BT_NODE_ITER_H
+
+#include <cstddef>    // provides ptrdiff_t
+#include <iterator>   // provides forward_iterator_tag
+#include <vector>     // provides vector
+#include "btNode.h"
+#include "itemRange.h"
+
+class bst_in_order_iterator
+{
+public:
+   typedef std::forward_iterator_tag iterator_category;
+   typedef int value_type;
+   typedef std::ptrdiff_t difference_type;
+   typedef const int* pointer;
+   typedef const int& reference;
+
+   bst_in_order_iterator() {}
+   explicit bst_in_order_iterator(const btNode* root);
+   const int& operator*() const { return path.back()->data; }
+   const int* operator->() const { return &path.back()->data; }
+   const btNode* node() const { return path.empty() ? 0 : path.back(); }
+   bst_in_order_iterator& operator++();
+   bst_in_order_iterator operator++(int)
+      { bst_in_order_iterator old(*this); ++*this; return old; }
+   bool operator==(const bst_in_order_iterator& other) const
+      { return node() == other.node(); }
+   bool operator!=(const bst_in_order_iterator& other) const
+      { return node() != other.node(); }
+private:
+   // the current node on top, with the ancestors still to be visited
+   // (those it is in the left subtree of) below it
+   std::vector<const btNode*> path;
+   void push_left_spine(const btNode* node);
+};
+
+class bst_pre_order_iterator
+{
+public:
+   typedef std::forward_iterator_tag iterator_category;
+   typedef int value_type;
+   typedef std::ptrdiff_t difference_type;
+   typedef const int* pointer;
+   typedef const int& reference;
+
+   bst_pre_order_iterator() {}
+   explicit bst_pre_order_iterator(const btNode* root);
+   const int& operator*() const { return path.back()->data; }
+   const int* operator->() const { return &path.back()->data; }
+   const btNode* node() const { return path.empty() ? 0 : path.back(); }
+   bst_pre_order_iterator& operator++();
+   bst_pre_order_iterator operator++(int)
+      { bst_pre_order_iterator old(*this); ++*this; return old; }
+   bool operator==(const bst_pre_order_iterator& other) const
+      { return node() == other.node(); }
+   bool operator!=(const bst_pre_order_iterator& other) const
+      { return node() != other.node(); }
+private:
+   // the current node on top, with the right subtrees still to be
+   // visited below it (nearest first)
+   std::vector<const btNode*> path;
+};
+
+class bst_post_order_iterator
+{
+public:
+   typedef std::forward_iterator_tag iterator_category;
+   typedef int value_type;
+   typedef std::ptrdiff_t difference_type;
+   typedef const int* pointer;
+   typedef const int& reference;
+
+   bst_post_order_iterator() {}
+   explicit bst_post_order_iterator(const btNode* root);
+   const int& operator*() const { return path.back()->data; }
+   const int* operator->() const { return &path.back()->data; }
+   const btNode* node() const { return path.empty() ? 0 : path.back(); }
+   bst_post_order_iterator& operator++();
+   bst_post_order_iterator operator++(int)
+      { bst_post_order_iterator old(*this); ++*this; return old; }
+   bool operator==(const bst_post_order_iterator& other) const
+      { return node() == other.node(); }
+   bool operator!=(const bst_post_order_iterator& other) const
+      { return node() != other.node(); }
+private:
+   // the current node on top, with all of its ancestors below it
+   std::vector<const btNode*> path;
+   void push_first_leaf(const btNode* node);
+};
+
+CS3358_FA2023_A04_sequence::item_range<bst_in_order_iterator>
+bst_in_order(const btNode* root);
+CS3358_FA2023_A04_sequence::item_range<bst_pre_order_iterator>
+bst_pre_order(const btNode* root);
+CS3358_FA2023_A04_sequence::item_range<bst_post_order_iterator>
+bst_post_order(const btNode* root);
+
+#endif
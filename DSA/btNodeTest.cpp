@@ -0,0 +1,291 @@
+// FILE: btNodeTest.cpp
+// A non-interactive model check of the btNode functions: random
+// operations are applied both to a tree and to a std::set, and after
+// each batch the tree must hold the same keys, in order, and still be
+// an AVL tree with correct height fields. It prints one line per check
+// and returns EXIT_FAILURE if any fails. The range and batch functions
+// (and size fields) are checked the same way, with and without a
+// node_pool.
+
+#include <cmath>       // provides log2
+#include <cstdlib>     // provides EXIT_SUCCESS, EXIT_FAILURE, rand, srand, abs
+#include <iostream>    // provides cout
+#include <set>         // provides set
+#include <vector>      // provides vector
+#include "btNode.h"
+#include "nodePool.h"
+
+using namespace std;
+using CS3358_FA2023::node_pool;
+
+// PROTOTYPES for functions used by this test program:
+
+int check_avl(btNode* root, long lo, long hi, bool& ok);
+// Pre:  (none)
+// Post: ok has been set to false if some key of the tree is not in
+//       (lo, hi), the tree is not a search tree, some node's subtrees
+//       differ in height by more than one or some height field is
+//       wrong; ok is otherwise unchanged. The tree's height has been
+//       returned.
+bool same_keys(btNode* root, const set<int>& model);
+// Pre:  (none)
+// Post: true has been returned if portToArrayInOrder gives exactly the
+//       keys of model, in increasing order.
+bool model_check();
+// Pre:  (none)
+// Post: Trees have been put through random bst_insert, bst_remove and
+//       bst_remove_max calls alongside a std::set; true has been
+//       returned if every result matched the std::set and every tree
+//       stayed a valid AVL tree no taller than 1.45 log2(n + 2) + 1.
+bool ascending_inserts();
+// Pre:  (none)
+// Post: 2^20 keys have been inserted in increasing order (the case that
+//       degenerates an unbalanced tree into a list); true has been
+//       returned if the tree is a valid AVL tree of height at most 21.
+int check_sizes(btNode* root, bool& ok);
+// Pre:  (none)
+// Post: ok has been set to false if some node's size field is not the
+//       number of nodes in its subtree; the tree's size has been
+//       returned.
+bool range_batch_check();
+// Pre:  (none)
+// Post: Trees (half of them built in a node_pool) have been put through
+//       random bst_range, bst_remove_range, bst_insert_many and
+//       bst_remove_many calls alongside a std::set; true has been
+//       returned if every visit list and count matched the std::set,
+//       every tree stayed a valid AVL tree with correct size fields and
+//       each pool held exactly the tree's nodes.
+bool lopsided_joins();
+// Pre:  (none)
+// Post: A batch of 10^5 keys has been inserted into a 1-node tree and
+//       then all but the two end keys removed with bst_remove_range;
+//       true has been returned if both results are valid AVL trees of
+//       the right size.
+
+int main()
+{
+   bool ok = true;
+   bool passed;
+
+   passed = model_check();
+   cout << "model check against std::set: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   passed = ascending_inserts();
+   cout << "ascending inserts stay balanced: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   passed = range_batch_check();
+   cout << "range and batch functions against std::set: "
+        << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   passed = lopsided_joins();
+   cout << "joins of very different heights: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int check_avl(btNode* root, long lo, long hi, bool& ok)
+{
+   if (root == 0) return 0;
+   if (root->data <= lo || root->data >= hi) ok = false;
+   int left = check_avl(root->left, lo, root->data, ok);
+   int right = check_avl(root->right, root->data, hi, ok);
+   if (abs(left - right) > 1) ok = false;
+   int height = 1 + ((left > right) ? left : right);
+   if (height != root->height) ok = false;
+   return height;
+}
+
+bool same_keys(btNode* root, const set<int>& model)
+{
+   vector<int> keys(model.size() + 1);
+   portToArrayInOrder(root, &keys[0]);
+   int i = 0;
+   for (set<int>::const_iterator it = model.begin(); it != model.end(); ++it)
+      if (keys[i++] != *it) return false;
+   return true;
+}
+
+bool model_check()
+{
+   srand(4);
+   for (int round = 0; round < 200; ++round)
+   {
+      btNode* root = 0;
+      set<int> model;
+      int range = 1 + rand() % 500;
+      int ops = rand() % 3000;
+      bool ok = true;
+      for (int i = 0; i < ops && ok; ++i)
+      {
+         int key = rand() % range;
+         int op = rand() % 7;
+         if (op < 3)
+         {
+            bst_insert(root, key);
+            model.insert(key);
+         }
+         else if (op < 6)
+         {
+            if (bst_remove(root, key) != (model.erase(key) == 1)) ok = false;
+         }
+         else
+         {
+            int removed = -1;
+            bst_remove_max(root, removed);
+            if (model.empty())
+               ok = ok && removed == -1 && root == 0;
+            else
+            {
+               ok = ok && removed == *model.rbegin();
+               model.erase(removed);
+            }
+         }
+         if (i % 50 == 0) check_avl(root, -(1L << 40), 1L << 40, ok);
+      }
+
+      int height = check_avl(root, -(1L << 40), 1L << 40, ok);
+      if (!ok || !same_keys(root, model) ||
+          height > 1.45 * log2(double(model.size()) + 2) + 1)
+         return false;
+      tree_clear(root);
+      if (root != 0) return false;
+   }
+   return true;
+}
+
+bool ascending_inserts()
+{
+   btNode* root = 0;
+   for (int i = 0; i < (1 << 20); ++i)
+      bst_insert(root, i);
+   bool ok = true;
+   int height = check_avl(root, -(1L << 40), 1L << 40, ok);
+   tree_clear(root);
+   return ok && height <= 21;
+}
+
+int check_sizes(btNode* root, bool& ok)
+{
+   if (root == 0) return 0;
+   int size = 1 + check_sizes(root->left, ok) + check_sizes(root->right, ok);
+   if (size != root->size) ok = false;
+   return size;
+}
+
+// Appends key to the vector<int> that context points at.
+void collect(int key, void* context)
+{
+   static_cast<vector<int>*>(context)->push_back(key);
+}
+
+// Fills batch with n random keys in [0, range), duplicates allowed.
+void random_batch(vector<int>& batch, int n, int range)
+{
+   batch.resize(n + 1);   // + 1 so &batch[0] is valid when n is 0
+   for (int i = 0; i < n; ++i)
+      batch[i] = rand() % range;
+}
+
+bool range_batch_check()
+{
+   srand(5);
+   for (int round = 0; round < 1000; ++round)
+   {
+      bool use_pool = (round % 2 != 0);
+      node_pool<btNode> pool;
+      btNode* root = 0;
+      set<int> model;
+      int range = 1 + rand() % 3000;
+      vector<int> batch;
+
+      random_batch(batch, rand() % 1500, range);
+      for (size_t i = 0; i + 1 < batch.size(); ++i)
+      {
+         if (use_pool) bst_insert(root, batch[i], pool);
+         else bst_insert(root, batch[i]);
+         model.insert(batch[i]);
+      }
+
+      for (int step = 0; step < 12; ++step)
+      {
+         int lo = rand() % range - 5;
+         int op = rand() % 4;
+         if (op == 0)
+         {
+            int hi = lo + rand() % (range / 3 + 2) - 2;
+            vector<int> got, expected;
+            for (set<int>::const_iterator it = model.lower_bound(lo);
+                 lo <= hi && it != model.end() && *it <= hi; ++it)
+               expected.push_back(*it);
+            if (bst_range(root, lo, hi, collect, &got) != int(expected.size()) ||
+                got != expected)
+               return false;
+         }
+         else if (op == 1)
+         {
+            int hi = lo + rand() % (range / 2 + 2) - 2;
+            int expected = 0;
+            if (lo <= hi)
+            {
+               set<int>::iterator first = model.lower_bound(lo);
+               set<int>::iterator last = model.upper_bound(hi);
+               for (set<int>::iterator it = first; it != last; ++it)
+                  ++expected;
+               model.erase(first, last);
+            }
+            int removed = use_pool ? bst_remove_range(root, lo, hi, pool)
+                                   : bst_remove_range(root, lo, hi);
+            if (removed != expected) return false;
+         }
+         else
+         {
+            int n = rand() % ((rand() % 2 != 0) ? 5 : 800);
+            random_batch(batch, n, range);
+            int expected = 0;
+            for (int i = 0; i < n; ++i)
+               expected += (op == 2) ? int(model.insert(batch[i]).second)
+                                     : int(model.erase(batch[i]));
+            int changed;
+            if (op == 2)
+               changed = use_pool ? bst_insert_many(root, &batch[0], n, pool)
+                                  : bst_insert_many(root, &batch[0], n);
+            else
+               changed = use_pool ? bst_remove_many(root, &batch[0], n, pool)
+                                  : bst_remove_many(root, &batch[0], n);
+            if (changed != expected) return false;
+         }
+
+         bool ok = true;
+         check_avl(root, -(1L << 40), 1L << 40, ok);
+         if (!ok || check_sizes(root, ok) != int(model.size()) || !ok ||
+             !same_keys(root, model) || (use_pool && pool.live() != model.size()))
+            return false;
+      }
+      if (use_pool) tree_clear(root, pool);
+      else tree_clear(root);
+   }
+   return true;
+}
+
+bool lopsided_joins()
+{
+   btNode* root = 0;
+   vector<int> keys(100000);
+   for (int i = 0; i < 100000; ++i)
+      keys[i] = i;
+   bst_insert(root, 5);
+   bst_insert_many(root, &keys[0], 100000);
+
+   bool ok = true;
+   check_avl(root, -(1L << 40), 1L << 40, ok);
+   ok = ok && check_sizes(root, ok) == 100000;
+   bst_remove_range(root, 1, 99998);
+   check_avl(root, -(1L << 40), 1L << 40, ok);
+   ok = ok && check_sizes(root, ok) == 2;
+   tree_clear(root);
+   return ok;
+}
@@ -0,0 +1,340 @@
+// FILE: btTree.h (part of the namespace CS3358_FA2023)
+// TEMPLATE CLASS PROVIDED: bt_tree<Key, Value, Compare, Alloc> (an
+//                          ordered set of keys, or map from keys to
+//                          values, kept as an AVL tree; the btNode
+//                          operations for any key type)
+//
+// The btNode functions (see btNode.cpp) hard-code int keys and hold no
+// payload, so 64-bit keys or key/value entries meant another copy of
+// all of them. bt_tree is the same AVL tree as a header-only template:
+//   - Key is any type Compare orders (strictly, like std::less), and
+//     Value is the payload kept with each key. The default Value,
+//     bt_no_value, is empty: bt_tree<int> is a set, and its node is 32
+//     bytes, the same as a btNode.
+//   - Compare and the allocator are template arguments, so every
+//     comparison is an inline call the compiler specializes for Key
+//     (for int, one cmp instruction), never a call through a pointer.
+//     Lookups compare once per level (as std::lower_bound does), not
+//     twice as bst_insert/bst_remove do.
+//   - With a transparent Compare (one with an is_transparent typedef,
+//     like bt_less below or C++14's std::less<>), find, contains,
+//     remove, rank, count_range, range and remove_range also take any
+//     type K that Compare can compare with Key ("heterogeneous
+//     lookup"): a bt_tree<std::string, V, bt_less> can be searched
+//     with a const char* or a string view without building a string.
+//   - Alloc is rebound to the node type (std::allocator_traits), so a
+//     std-style allocator for Key can be passed.
+// Each node also keeps its subtree's size, for the order statistics.
+//
+// TYPEDEFS for the bt_tree template class:
+//   key_type, mapped_type, key_compare, allocator_type
+//     Key, Value, Compare and Alloc.
+//   size_type
+//     std::size_t. A tree holds at most INT_MAX keys (the nodes keep
+//     int sizes, to stay as small as a btNode).
+//   const_iterator
+//     A forward iterator over the entries in increasing key order:
+//     *it is the key, it.key() and it.value() the entry's key and
+//     value. Like the btNodeIter iterators it holds the path from the
+//     root (O(log n) pointers) and becomes invalid when the tree
+//     changes.
+//
+// CONSTRUCTORS for the bt_tree template class:
+//   explicit bt_tree(const Compare& comp = Compare(),
+//                    const Alloc& alloc = Alloc())
+//     Post: The tree is empty and will order keys with comp.
+//   bt_tree(const bt_tree& source)
+//     Post: The tree is a copy of source (same shape; O(n)).
+//   bt_tree(bt_tree&& source)
+//     Post: The tree has taken over source's nodes; source is empty.
+//
+// MODIFICATION MEMBER FUNCTIONS for the bt_tree template class:
+//   bool insert(const Key& key, const Value& value = Value())
+//     Post: If key was not in the tree, (key, value) has been added
+//           and true returned; otherwise the tree is unchanged and
+//           false has been returned. O(log n).
+//   bool remove(const K& key)
+//     Post: If key was in the tree, its entry has been removed and true
+//           returned; otherwise false has been returned. O(log n).
+//   bool remove_max(Key& key)
+//     Post: If the tree was not empty, its largest key has been put in
+//           key, its entry removed and true returned; otherwise false
+//           has been returned.
+//   size_type remove_range(const K& lo, const K& hi)
+//     Post: Every entry with lo <= key <= hi has been removed and the
+//           number removed returned (0 if hi is before lo). O(log n +
+//           entries removed).
+//   template <class InputIt> size_type insert_many(InputIt first, InputIt last)
+//   template <class InputIt> size_type remove_many(InputIt first, InputIt last)
+//     Pre:  [first, last) are Keys, in any order, duplicates allowed.
+//     Post: The keys have been inserted (with Value()) / removed and the
+//           number actually added / removed has been returned. The batch
+//           is sorted and the tree walked once (see bst_insert_many).
+//           On an empty tree insert_many is an O(m log m) bulk build.
+//   template <class InputIt> void assign_sorted(InputIt first, InputIt last)
+//     Pre:  [first, last) are Keys in strictly increasing order.
+//     Post: The tree holds exactly those keys (with Value()), built
+//           perfectly balanced in O(n) with no comparisons.
+//   Value* find(const K& key)
+//     Post: A pointer to key's value has been returned (NULL if key is
+//           not in the tree). It stays valid until the entry is removed.
+//   void clear()
+//     Post: The tree is empty. O(n), without recursion.
+//   bt_tree& operator=(const bt_tree& source) / operator=(bt_tree&& source)
+//   void swap(bt_tree& other)
+//     Post: As for the copy / move constructor; swap exchanges the two
+//           trees in O(1).
+//
+// CONSTANT MEMBER FUNCTIONS for the bt_tree template class:
+//   size_type size() const / bool empty() const
+//     Post: The number of entries / whether it is 0 has been returned.
+//   int height() const
+//     Post: The tree's height (0 if empty) has been returned.
+//   const Value* find(const K& key) const
+//   bool contains(const K& key) const
+//     Post: As find above / whether key is in the tree. O(log n).
+//   size_type rank(const K& key) const
+//     Post: The number of keys smaller than key has been returned.
+//   bool select(size_type k, Key& key) const
+//     Post: If k < size(), the key with k smaller keys has been put in
+//           key and true returned; otherwise false has been returned.
+//   size_type count_range(const K& lo, const K& hi) const
+//     Post: The number of keys in [lo, hi] has been returned, in
+//           O(log n).
+//   template <class Visit> size_type range(const K& lo, const K& hi, Visit visit) const
+//     Post: visit(key) (for a set) or visit(key, value) has been called
+//           for every entry with lo <= key <= hi, in increasing order,
+//           and the number of calls returned. O(log n + calls).
+//   template <class OutIt> OutIt copy_keys(OutIt out) const
+//     Post: The keys have been written to out in increasing order, and
+//           the iterator past the last one returned
+//           (portToArrayInOrder).
+//   const_iterator begin() const / end() const
+//     Post: The first entry / the end of the in-order walk.
+//   key_compare key_comp() const
+//     Post: A copy of the comparison object has been returned.
+//   (K is Key, or any type when Compare is transparent; see above.)
+//
+// VALUE SEMANTICS for the bt_tree template class:
+//    Assignments and the copy constructor may be used with bt_tree
+//    objects; move construction and move assignment take over the
+//    source's nodes in O(1).
+//
+// DYNAMIC MEMORY USAGE by the bt_tree template class:
+//   If there is insufficient dynamic memory, insert, insert_many,
+//   assign_sorted, the copy constructor and the copy assignment throw
+//   bad_alloc, and the tree is left unchanged (insert_many and
+//   assign_sorted allocate all their nodes before changing the tree).
+//   The destructor frees every node.
+
+#ifndef BT_TREE_H
+#define BT_TREE_H
+
+#include <cstddef>      // provides ptrdiff_t, size_t
+#include <functional>   // provides less
+#include <iterator>     // provides forward_iterator_tag
+#include <memory>       // provides allocator, allocator_traits
+#include <vector>       // provides vector
+
+namespace CS3358_FA2023
+{
+   // The payload of a bt_tree used as a set.
+   struct bt_no_value {};
+
+   // A transparent "<": compares a Key with anything it has a < for.
+   struct bt_less
+   {
+      typedef void is_transparent;
+      template <class A, class B>
+      bool operator()(const A& a, const B& b) const { return a < b; }
+   };
+
+   template <class Key, class Value = bt_no_value, class Compare = std::less<Key>,
+             class Alloc = std::allocator<Key> >
+   class bt_tree
+   {
+   private:
+      struct node
+      {
+         node* left;
+         node* right;
+         Key key;
+         Value value;
+         int height;
+         int size;
+
+         node(const Key& k, const Value& v)
+            : left(0), right(0), key(k), value(v), height(1), size(1) {}
+      };
+
+   public:
+      // TYPEDEFS
+      typedef Key key_type;
+      typedef Value mapped_type;
+      typedef Compare key_compare;
+      typedef Alloc allocator_type;
+      typedef std::size_t size_type;
+
+      class const_iterator
+      {
+      public:
+         typedef std::forward_iterator_tag iterator_category;
+         typedef Key value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef const Key* pointer;
+         typedef const Key& reference;
+
+         const_iterator() {}
+         const Key& operator*() const { return path.back()->key; }
+         const Key* operator->() const { return &path.back()->key; }
+         const Key& key() const { return path.back()->key; }
+         const Value& value() const { return path.back()->value; }
+         const_iterator& operator++()
+         {
+            const node* done = path.back();
+            path.pop_back();
+            push_left_spine(done->right);
+            return *this;
+         }
+         const_iterator operator++(int)
+            { const_iterator old(*this); ++*this; return old; }
+         bool operator==(const const_iterator& other) const
+            { return current() == other.current(); }
+         bool operator!=(const const_iterator& other) const
+            { return current() != other.current(); }
+      private:
+         friend class bt_tree;
+         // as in bst_in_order_iterator: the current node on top, with
+         // the ancestors still to be visited below it
+         std::vector<const node*> path;
+         explicit const_iterator(const node* root) { push_left_spine(root); }
+         const node* current() const { return path.empty() ? 0 : path.back(); }
+         void push_left_spine(const node* n)
+         {
+            for (; n != 0; n = n->left)
+               path.push_back(n);
+         }
+      };
+
+      // CONSTRUCTORS and DESTRUCTOR
+      explicit bt_tree(const Compare& comp = Compare(), const Alloc& alloc = Alloc());
+      bt_tree(const bt_tree& source);
+      bt_tree(bt_tree&& source);
+      ~bt_tree();
+      // MODIFICATION MEMBER FUNCTIONS
+      bt_tree& operator=(const bt_tree& source);
+      bt_tree& operator=(bt_tree&& source);
+      void swap(bt_tree& other);
+      bool insert(const Key& key, const Value& value = Value());
+      bool remove(const Key& key) { return remove_key(key); }
+      template <class K, class C = Compare, class = typename C::is_transparent>
+      bool remove(const K& key) { return remove_key(key); }
+      bool remove_max(Key& key);
+      size_type remove_range(const Key& lo, const Key& hi)
+         { return remove_keys_between(lo, hi); }
+      template <class K, class C = Compare, class = typename C::is_transparent>
+      size_type remove_range(const K& lo, const K& hi)
+         { return remove_keys_between(lo, hi); }
+      template <class InputIt>
+      size_type insert_many(InputIt first, InputIt last);
+      template <class InputIt>
+      size_type remove_many(InputIt first, InputIt last);
+      template <class InputIt>
+      void assign_sorted(InputIt first, InputIt last);
+      Value* find(const Key& key) { return value_of(find_node(key)); }
+      template <class K, class C = Compare, class = typename C::is_transparent>
+      Value* find(const K& key) { return value_of(find_node(key)); }
+      void clear();
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const { return size_type(size_of(root)); }
+      bool empty() const { return root == 0; }
+      int height() const { return height_of(root); }
+      const Value* find(const Key& key) const { return value_of(find_node(key)); }
+      template <class K, class C = Compare, class = typename C::is_transparent>
+      const Value* find(const K& key) const { return value_of(find_node(key)); }
+      bool contains(const Key& key) const { return find_node(key) != 0; }
+      template <class K, class C = Compare, class = typename C::is_transparent>
+      bool contains(const K& key) const { return find_node(key) != 0; }
+      size_type rank(const Key& key) const { return count_below(key, false); }
+      template <class K, class C = Compare, class = typename C::is_transparent>
+      size_type rank(const K& key) const { return count_below(key, false); }
+      bool select(size_type k, Key& key) const;
+      size_type count_range(const Key& lo, const Key& hi) const
+         { return count_between(lo, hi); }
+      template <class K, class C = Compare, class = typename C::is_transparent>
+      size_type count_range(const K& lo, const K& hi) const
+         { return count_between(lo, hi); }
+      template <class Visit>
+      size_type range(const Key& lo, const Key& hi, Visit visit) const
+         { return visit_between(lo, hi, visit); }
+      template <class K, class Visit, class C = Compare, class = typename C::is_transparent>
+      size_type range(const K& lo, const K& hi, Visit visit) const
+         { return visit_between(lo, hi, visit); }
+      template <class OutIt>
+      OutIt copy_keys(OutIt out) const;
+      const_iterator begin() const { return const_iterator(root); }
+      const_iterator end() const { return const_iterator(); }
+      key_compare key_comp() const { return comp; }
+
+   private:
+      typedef typename std::allocator_traits<Alloc>::template rebind_alloc<node> node_alloc;
+      typedef std::allocator_traits<node_alloc> node_traits;
+
+      static const int MAX_HEIGHT = 64;   // an AVL tree of 2^31 nodes is < 46 high
+
+      node* root;
+      Compare comp;
+      node_alloc alloc;
+
+      // AVL helpers (the same as in btNode.cpp)
+      static int height_of(const node* n) { return (n == 0) ? 0 : n->height; }
+      static int size_of(const node* n) { return (n == 0) ? 0 : n->size; }
+      static void update(node* n);
+      static void rotate_right(node*& n);
+      static void rotate_left(node*& n);
+      static void rebalance(node*& n);
+      static node* join(node* left, node* middle, node* right);
+      static node* join2(node* left, node* right);
+      static node* unlink_max(node*& n);
+      static node* build(node* const* nodes, int lo, int hi);
+      // nodes
+      node* new_node(const Key& key, const Value& value);
+      void free_node(node* n);
+      void free_nodes(std::vector<node*>& nodes, std::size_t from);
+      void clear_aux(node* n);
+      node* clone(const node* n);
+      template <class InputIt>
+      void make_nodes(InputIt first, InputIt last, std::vector<node*>& nodes);
+      static Value* value_of(const node* n)
+         { return (n == 0) ? 0 : const_cast<Value*>(&n->value); }
+      // searches (K is Key or, with a transparent Compare, any type)
+      template <class K> const node* find_node(const K& key) const;
+      template <class K> size_type count_below(const K& key, bool inclusive) const;
+      template <class K> size_type count_between(const K& lo, const K& hi) const;
+      template <class K, class Visit>
+      size_type visit_between(const K& lo, const K& hi, Visit& visit) const;
+      template <class Visit>
+      static void call(Visit& visit, const node* n, const bt_no_value*) { visit(n->key); }
+      template <class Visit, class V>
+      static void call(Visit& visit, const node* n, const V*) { visit(n->key, n->value); }
+      // changes
+      template <class K> bool remove_key(const K& key);
+      template <class K> bool remove_aux(node*& n, const K& key, bool& shorter);
+      template <class K> node* keep_below(node* n, const K& lo);
+      template <class K> node* keep_above(node* n, const K& hi);
+      template <class K> node* remove_range_aux(node* n, const K& lo, const K& hi);
+      template <class K> size_type remove_keys_between(const K& lo, const K& hi);
+      node* insert_many_aux(node* n, node* const* nodes, int lo, int hi,
+                            std::vector<node*>& unused);
+      node* remove_many_aux(node* n, const Key* keys, int lo, int hi);
+   };
+
+   template <class Key, class Value, class Compare, class Alloc>
+   void swap(bt_tree<Key, Value, Compare, Alloc>& a, bt_tree<Key, Value, Compare, Alloc>& b)
+   {
+      a.swap(b);
+   }
+}
+
+#include "btTree.template"
+#endif
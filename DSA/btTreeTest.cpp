@@ -0,0 +1,307 @@
+// FILE: btTreeTest.cpp
+// A non-interactive model check of the bt_tree template, in the style
+// of btNodeTest.cpp: random operations are applied both to a bt_tree
+// (used as a map, so every key carries a value) and to a std::map, for
+// int, 64-bit and std::string keys. After each operation the tree must
+// hold the same entries, in order, with each value still beside its
+// key (remove relinks a node's heir rather than copying it), and be no
+// taller than an AVL tree may be. The string trees use bt_less and are
+// searched, ranked and trimmed with const char* keys (heterogeneous
+// lookup). It prints one line per check and returns EXIT_FAILURE if any
+// fails.
+
+#include <cmath>       // provides log2
+#include <cstdlib>     // provides EXIT_SUCCESS, EXIT_FAILURE, rand, srand
+#include <cstdio>      // provides sprintf
+#include <iostream>    // provides cout
+#include <map>         // provides map
+#include <string>      // provides string
+#include <utility>     // provides pair, move
+#include <vector>      // provides vector
+#include "btTree.h"
+
+using namespace std;
+using CS3358_FA2023::bt_tree;
+using CS3358_FA2023::bt_less;
+
+// PROTOTYPES for functions used by this test program:
+
+template <class Key, class Compare>
+bool same_as_model(const bt_tree<Key, int, Compare>& tree, const map<Key, int>& model);
+// Pre:  (none)
+// Post: true has been returned if walking tree with its iterators, and
+//       copy_keys, give exactly the entries of model in increasing key
+//       order, select agrees with the walk and the tree is no taller
+//       than 1.45 log2(n + 2) + 1.
+template <class Key, class Compare>
+bool model_check(unsigned seed);
+// Pre:  (none)
+// Post: bt_tree<Key, int, Compare> trees have been put through random
+//       insert, remove, remove_max, remove_range, insert_many,
+//       remove_many, find, contains, rank, count_range and range calls
+//       (lookups made through probe, so with a const char* for string
+//       keys), copies, moves and swaps alongside a std::map, half of
+//       them then emptied by removes in random order; true has been
+//       returned if every result and every check with same_as_model
+//       passed.
+bool mixed_type_lookup();
+// Pre:  (none)
+// Post: true has been returned if a bt_tree<long long, int, bt_less>
+//       can be searched with int keys and a bt_tree<string, int,
+//       bt_less> with const char* keys, and both give the same answers
+//       as with keys of their own type.
+
+int main()
+{
+   bool ok = true;
+   bool passed;
+
+   passed = model_check<int, less<int> >(25);
+   cout << "int keys against std::map: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   passed = model_check<long long, less<long long> >(26);
+   cout << "64-bit keys against std::map: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   passed = model_check<string, bt_less>(27);
+   cout << "string keys (const char* lookups) against std::map: "
+        << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   passed = mixed_type_lookup();
+   cout << "lookups with another key type: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// The i-th key of each type; all three keep the order of i.
+void make_key(int i, int& key)
+{
+   key = i;
+}
+
+void make_key(int i, long long& key)
+{
+   key = (long long)i * 3000000019LL - 7;   // past 32 bits for i > 0
+}
+
+void make_key(int i, string& key)
+{
+   char digits[16];
+   sprintf(digits, "%07d", i);
+   key = string("key ") + digits;
+}
+
+// What lookups pass the tree: the key itself, or for a string, its
+// const char*.
+template <class Key>
+const Key& probe(const Key& key)
+{
+   return key;
+}
+
+const char* probe(const string& key)
+{
+   return key.c_str();
+}
+
+// Appends each (key, value) range visits.
+template <class Key>
+struct collector
+{
+   vector<pair<Key, int> >* entries;
+   void operator()(const Key& key, int value) const
+      { entries->push_back(make_pair(key, value)); }
+};
+
+template <class Key, class Compare>
+bool same_as_model(const bt_tree<Key, int, Compare>& tree, const map<Key, int>& model)
+{
+   if (tree.size() != model.size() || tree.empty() != model.empty())
+      return false;
+   if (tree.height() > 1.45 * log2(double(model.size()) + 2) + 1)
+      return false;
+
+   typename bt_tree<Key, int, Compare>::const_iterator it = tree.begin();
+   for (typename map<Key, int>::const_iterator m = model.begin(); m != model.end(); ++m, ++it)
+   {
+      if (it == tree.end() || *it != m->first || it.key() != m->first ||
+          it.value() != m->second)
+         return false;
+   }
+   if (it != tree.end()) return false;
+
+   vector<Key> keys(model.size());
+   if (tree.copy_keys(keys.begin()) != keys.end()) return false;
+   size_t k = 0;
+   for (typename map<Key, int>::const_iterator m = model.begin(); m != model.end(); ++m, ++k)
+      if (keys[k] != m->first) return false;
+
+   Key selected;
+   if (tree.select(model.size(), selected)) return false;
+   for (k = 0; k < model.size(); k += 1 + model.size() / 8)
+      if (!tree.select(k, selected) || selected != keys[k]) return false;
+   return true;
+}
+
+// Fills batch with n random keys from index range [0, range),
+// duplicates allowed.
+template <class Key>
+void random_batch(vector<Key>& batch, int n, int range)
+{
+   batch.resize(n);
+   for (int i = 0; i < n; ++i)
+      make_key(rand() % range, batch[i]);
+}
+
+template <class Key, class Compare>
+bool model_check(unsigned seed)
+{
+   typedef bt_tree<Key, int, Compare> tree_type;
+   typedef typename map<Key, int>::iterator model_iterator;
+
+   srand(seed);
+   int stamp = 0;
+   for (int round = 0; round < 120; ++round)
+   {
+      tree_type tree;
+      map<Key, int> model;
+      // small ranges remove many nodes with two children; big ones
+      // make deep trees
+      int range = (round % 2 == 0) ? 1 + rand() % 60 : 1 + rand() % 3000;
+      int ops = rand() % 1500;
+      vector<Key> batch;
+      for (int i = 0; i < ops; ++i)
+      {
+         Key key, hi;
+         make_key(rand() % range, key);
+         int op = rand() % 12;
+         bool ok = true;
+         if (op < 3)
+         {
+            ++stamp;
+            bool added = model.insert(make_pair(key, stamp)).second;
+            ok = tree.insert(key, stamp) == added;
+         }
+         else if (op < 6)
+            ok = tree.remove(probe(key)) == (model.erase(key) == 1);
+         else if (op == 6)
+         {
+            Key removed;
+            ok = tree.remove_max(removed) == !model.empty();
+            if (ok && !model.empty())
+            {
+               ok = removed == model.rbegin()->first;
+               model.erase(removed);
+            }
+         }
+         else if (op == 7 || op == 8)
+         {
+            random_batch(batch, rand() % ((rand() % 2 != 0) ? 5 : 400), range);
+            size_t expected = 0;
+            for (size_t j = 0; j < batch.size(); ++j)
+               expected += (op == 7) ? size_t(model.insert(make_pair(batch[j], 0)).second)
+                                     : model.erase(batch[j]);
+            size_t changed = (op == 7) ? tree.insert_many(batch.begin(), batch.end())
+                                       : tree.remove_many(batch.begin(), batch.end());
+            ok = changed == expected;
+         }
+         else if (op == 9)
+         {
+            make_key(rand() % range, hi);
+            model_iterator first = model.lower_bound(key);
+            model_iterator last = model.upper_bound(hi);
+            size_t expected = 0;
+            if (!(hi < key))
+            {
+               for (model_iterator m = first; m != last; ++m)
+                  ++expected;
+               model.erase(first, last);
+            }
+            ok = tree.remove_range(probe(key), probe(hi)) == expected;
+         }
+         else if (op == 10)
+         {
+            make_key(rand() % range, hi);
+            const int* value = tree.find(probe(key));
+            model_iterator m = model.find(key);
+            ok = tree.contains(probe(key)) == (m != model.end()) &&
+                 ((m == model.end()) ? value == 0 : value != 0 && *value == m->second);
+
+            size_t below = 0;
+            for (model_iterator b = model.begin(); b != model.end() && b->first < key; ++b)
+               ++below;
+            ok = ok && tree.rank(probe(key)) == below;
+
+            vector<pair<Key, int> > got, expected;
+            for (model_iterator r = model.lower_bound(key);
+                 !(hi < key) && r != model.end() && !(hi < r->first); ++r)
+               expected.push_back(*r);
+            collector<Key> visit = { &got };
+            ok = ok && tree.count_range(probe(key), probe(hi)) == expected.size() &&
+                 tree.range(probe(key), probe(hi), visit) == expected.size() &&
+                 got == expected;
+         }
+         else
+         {
+            // copies, moves and swaps must carry every entry along
+            tree_type copy(tree);
+            tree_type assigned;
+            assigned.insert(key, -1);
+            assigned = tree;
+            tree_type moved(move(copy));
+            ok = copy.empty() && same_as_model(moved, model) &&
+                 same_as_model(assigned, model);
+            tree_type other;
+            other.swap(moved);
+            tree = move(other);
+            ok = ok && moved.empty() && other.empty();
+         }
+         if (!ok || !same_as_model(tree, model)) return false;
+      }
+
+      // drain half the rounds key by key (the height must shrink with
+      // the tree), then clear the rest
+      while (round % 2 != 0 && !model.empty())
+      {
+         model_iterator m = model.begin();
+         for (int skip = rand() % int(model.size()); skip > 0; --skip)
+            ++m;
+         if (!tree.remove(probe(m->first))) return false;
+         model.erase(m);
+         if (model.size() % 16 == 0 && !same_as_model(tree, model)) return false;
+      }
+      tree.clear();
+      if (!tree.empty() || tree.height() != 0 || tree.begin() != tree.end())
+         return false;
+   }
+   return true;
+}
+
+bool mixed_type_lookup()
+{
+   bt_tree<long long, int, bt_less> wide;
+   bt_tree<string, int, bt_less> words;
+   for (int i = -50; i < 50; i += 2)
+      wide.insert(i, i);
+   for (int j = 0; j < 26; ++j)
+      words.insert(string(1, char('a' + j)), j);
+
+   bool ok = true;
+   for (int i = -52; i < 52; ++i)
+   {
+      ok = ok && wide.contains(i) == wide.contains((long long)i) &&
+           wide.rank(i) == wide.rank((long long)i) &&
+           wide.count_range(i, 60) == wide.count_range((long long)i, 60LL);
+      const int* value = wide.find(i);
+      ok = ok && (value == 0) == (i % 2 != 0 || i < -50 || i >= 50) &&
+           (value == 0 || *value == i);
+   }
+   ok = ok && words.contains("c") && !words.contains("cc") && words.rank("c") == 2 &&
+        words.count_range("b", "e") == 4 && *words.find("z") == 25 &&
+        words.remove("a") && !words.remove("a") && words.remove_range("w", "zz") == 4 &&
+        words.size() == 21 && wide.remove(0) && !wide.contains(0) && wide.size() == 49;
+   return ok;
+}
@@ -0,0 +1,59 @@
+// FILE: cnPtrQueue.h (part of the namespace CS3358_FA2023_A5P2)
+// CLASS PROVIDED: cnPtrQueue (a FIFO queue of CNode pointers, used for
+//                 the breadth-first walk in ShowAll_BF)
+//
+// The queue is kept in two stacks: push goes onto inStack; front and
+// pop take from outStack, refilling it from inStack (which reverses the
+// order) only when it is empty, so each pointer is moved once.
+//
+// CONSTRUCTOR for the cnPtrQueue class:
+//   cnPtrQueue()
+//     Post: The queue is empty.
+//
+// MODIFICATION MEMBER FUNCTIONS for the cnPtrQueue class:
+//   void push(CNode* cnPtr)
+//     Post: cnPtr has been added at the back of the queue.
+//   void pop()
+//     Pre:  empty() returns false.
+//     Post: The front pointer has been removed.
+//   CNode* front()
+//     Pre:  empty() returns false.
+//     Post: The front pointer has been returned (it is not removed).
+//
+// CONSTANT MEMBER FUNCTIONS for the cnPtrQueue class:
+//   bool empty() const
+//     Post: true has been returned if the queue holds no pointers.
+//   size_type size() const
+//     Post: The number of pointers in the queue has been returned.
+//
+// VALUE SEMANTICS for the cnPtrQueue class:
+//   Assignments and the copy constructor may be used with cnPtrQueue
+//   objects (the pointers are copied, not the CNodes).
+
+#ifndef CN_PTR_QUEUE_H
+#define CN_PTR_QUEUE_H
+
+#include <cstdlib>   // provides size_t
+#include <stack>     // provides stack
+#include "nodes_LLoLL.h"
+
+namespace CS3358_FA2023_A5P2
+{
+   class cnPtrQueue
+   {
+   public:
+      typedef std::size_t size_type;
+      cnPtrQueue();
+      bool empty() const;
+      size_type size() const;
+      CNode* front();
+      void push(CNode* cnPtr);
+      void pop();
+   private:
+      std::stack<CNode*> inStack;
+      std::stack<CNode*> outStack;
+      size_type numItems;
+   };
+}
+
+#endif
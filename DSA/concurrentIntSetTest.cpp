@@ -0,0 +1,226 @@
+// FILE: concurrentIntSetTest.cpp
+// A non-interactive stress test for ConcurrentIntSet and the epoch
+// module. It is meant to be run under ThreadSanitizer and
+// AddressSanitizer as well as in a plain build (see CMakeLists.txt);
+// it prints one line per check and returns EXIT_FAILURE if any fails.
+//
+// Usage: concurrentIntSetTest [rounds]   (rounds defaults to 4)
+
+#include <atomic>      // provides atomic
+#include <cstdlib>     // provides EXIT_SUCCESS, EXIT_FAILURE, atoi, malloc, free
+#include <functional>  // provides ref
+#include <iostream>    // provides cout
+#include <new>         // provides bad_alloc
+#include <set>         // provides set
+#include <thread>      // provides thread, yield
+#include <vector>      // provides vector
+#include "ConcurrentIntSet.h"
+#include "epoch.h"
+
+using namespace CS3358_FA2023;
+using namespace std;
+
+// While set, operator new fails every request of at least this many
+// bytes, so failed_growth can make ConcurrentIntSet's resize run out
+// of memory.
+static atomic<size_t> fail_from_bytes(0);
+
+void* operator new(size_t bytes)
+{
+   size_t limit = fail_from_bytes.load();
+   if (limit != 0 && bytes >= limit)
+      throw bad_alloc();
+   void* p = malloc(bytes == 0 ? 1 : bytes);
+   if (p == 0)
+      throw bad_alloc();
+   return p;
+}
+void* operator new[](size_t bytes) { return operator new(bytes); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+// PROTOTYPES for functions used by this test program:
+
+bool model_check(int round);
+// Pre:  (none)
+// Post: WRITERS threads have each made OPS random adds and removes of
+//       keys only they use (so each can check every result against its
+//       own std::set), while another thread kept calling contains over
+//       all of them; true has been returned if every result, and the
+//       final contents and size, matched the std::sets. Odd rounds
+//       spread the keys out so that they collide more in the table.
+bool failed_growth();
+// Pre:  (none)
+// Post: Keys have been added to a new set until a resize failed with
+//       bad_alloc, then more keys were added from other threads with
+//       memory available again; true has been returned if the failed
+//       add left the set unchanged and every later add (which needs
+//       every stripe lock) went through.
+bool many_threads_pin();
+// Pre:  (none)
+// Post: More threads than one block of the epoch participant table
+//       have pinned at the same time and each retired an object; true
+//       has been returned if all of those objects have been destroyed
+//       once the threads are gone.
+
+const int WRITERS = 6;
+const int OPS = 60000;
+const int PINNERS = 520;
+
+int main(int argc, char* argv[])
+{
+   int rounds = (argc > 1) ? atoi(argv[1]) : 4;
+   bool ok = true;
+
+   for (int round = 0; round < rounds; ++round)
+   {
+      bool passed = model_check(round);
+      cout << "model check, round " << round << ": "
+           << (passed ? "passed" : "FAILED") << endl;
+      ok = ok && passed;
+   }
+
+   bool passed = failed_growth();
+   cout << "bad_alloc while resizing: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   passed = many_threads_pin();
+   cout << PINNERS << " threads pinned at once: "
+        << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// A writer of model_check: the keys of writer t are those that leave
+// remainder t when divided by WRITERS, so no other writer touches them.
+void run_writer(ConcurrentIntSet& cset, set<int>& model, int t, int round,
+                atomic<bool>& bad)
+{
+   unsigned long state = (unsigned long)(t * 7 + round + 1);
+   for (int k = 0; k < OPS; ++k)
+   {
+      state = state * 6364136223846793005UL + 1442695040888963407UL;
+      int key = int((state >> 33) % 20000) * WRITERS + t;
+      if (round % 2 != 0) key = int(unsigned(key) * 65537u);
+
+      if ((state >> 20) % 3 != 0)
+      {
+         if (cset.add(key) != (model.count(key) == 0)) bad = true;
+         model.insert(key);
+      }
+      else
+      {
+         if (cset.remove(key) != (model.count(key) == 1)) bad = true;
+         model.erase(key);
+      }
+      if (cset.contains(key) != (model.count(key) == 1)) bad = true;
+   }
+}
+
+bool model_check(int round)
+{
+   ConcurrentIntSet cset;
+   vector< set<int> > models(WRITERS);
+   atomic<bool> bad(false);
+   atomic<bool> stop(false);
+
+   vector<thread> writers;
+   for (int t = 0; t < WRITERS; ++t)
+      writers.push_back(thread(run_writer, ref(cset), ref(models[t]), t, round,
+                               ref(bad)));
+   thread reader([&cset, &stop]()
+   {
+      while (!stop)
+         for (int key = 0; key < 1000; ++key)
+            cset.contains(key);
+   });
+   for (int t = 0; t < WRITERS; ++t)
+      writers[t].join();
+   stop = true;
+   reader.join();
+
+   int total = 0;
+   for (int t = 0; t < WRITERS; ++t)
+   {
+      total += int(models[t].size());
+      for (set<int>::const_iterator it = models[t].begin(); it != models[t].end(); ++it)
+         if (!cset.contains(*it)) bad = true;
+   }
+   if (cset.size() != total || cset.toIntSet().size() != total) bad = true;
+   return !bad;
+}
+
+bool failed_growth()
+{
+   ConcurrentIntSet cset;
+   // the first table's slots are well under this; every bigger one fails
+   fail_from_bytes = 4096;
+   int added = 0;
+   bool threw = false;
+   try
+   {
+      for (; added < 100000; ++added)
+         cset.add(added);
+   }
+   catch (const bad_alloc&)
+   {
+      threw = true;
+   }
+   fail_from_bytes = 0;
+   if (!threw || cset.size() != added || cset.contains(added)) return false;
+
+   vector<thread> writers;
+   for (int t = 0; t < 4; ++t)
+      writers.push_back(thread([&cset, added, t]()
+      {
+         for (int key = added + t; key < added + 20000; key += 4)
+            cset.add(key);
+      }));
+   for (int t = 0; t < 4; ++t)
+      writers[t].join();
+
+   for (int key = 0; key < added + 20000; ++key)
+      if (!cset.contains(key)) return false;
+   return cset.size() == added + 20000;
+}
+
+// Counts the destroyed objects that many_threads_pin retired.
+atomic<int> destroyed(0);
+
+void count_destroy(void* p)
+{
+   delete static_cast<int*>(p);
+   ++destroyed;
+}
+
+bool many_threads_pin()
+{
+   atomic<int> pinned(0);
+   vector<thread> pinners;
+   for (int t = 0; t < PINNERS; ++t)
+      pinners.push_back(thread([&pinned]()
+      {
+         epoch_guard guard;
+         ++pinned;
+         // stay pinned until every thread is, so all need a slot at once
+         while (pinned.load() < PINNERS)
+            this_thread::yield();
+         epoch_retire(static_cast<void*>(new int(0)), count_destroy);
+      }));
+   for (int t = 0; t < PINNERS; ++t)
+      pinners[t].join();
+
+   for (int tries = 0; tries < 8 && destroyed.load() < PINNERS; ++tries)
+      epoch_collect();
+   return destroyed.load() == PINNERS;
+}
@@ -0,0 +1,165 @@
+// FILE: concurrentSkipListTest.cpp
+// A non-interactive stress test for ConcurrentSkipList, meant to be run
+// under ThreadSanitizer and AddressSanitizer as well as in a plain
+// build (see CMakeLists.txt). It prints one line per check and returns
+// EXIT_FAILURE if any fails.
+
+#include <atomic>      // provides atomic
+#include <cstdlib>     // provides EXIT_SUCCESS, EXIT_FAILURE
+#include <functional>  // provides ref
+#include <iostream>    // provides cout
+#include <set>         // provides set
+#include <thread>      // provides thread
+#include <vector>      // provides vector
+#include "ConcurrentSkipList.h"
+#include "epoch.h"
+
+using namespace CS3358_FA2023;
+using namespace std;
+
+// PROTOTYPES for functions used by this test program:
+
+bool model_check();
+// Pre:  (none)
+// Post: 200000 random add, remove, contains and remove_max calls have
+//       been made on one thread, alongside a std::set; true has been
+//       returned if every result and size(), and the final snapshot,
+//       matched the std::set.
+bool stress();
+// Pre:  (none)
+// Post: THREADS threads have made random add, remove, remove_max and
+//       contains calls on a few hundred shared keys, each taking
+//       snapshots as it went; true has been returned if every snapshot
+//       was strictly increasing and the final size equals the adds
+//       that returned true minus the removes that did.
+
+const int THREADS = 6;
+const int OPS = 60000;
+const int KEYS = 512;
+
+int main()
+{
+   bool ok = true;
+   bool passed;
+
+   passed = model_check();
+   cout << "model check against std::set: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   passed = stress();
+   cout << THREADS << " threads on " << KEYS << " keys: "
+        << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   for (int i = 0; i < 3; ++i)
+      epoch_collect();
+   return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// The next pseudo-random number after state (a 64-bit LCG).
+unsigned long long next_random(unsigned long long& state)
+{
+   state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+   return state >> 20;
+}
+
+bool model_check()
+{
+   ConcurrentSkipList list;
+   set<int> model;
+   unsigned long long state = 7;
+   for (int i = 0; i < 200000; ++i)
+   {
+      unsigned long long r = next_random(state);
+      int key = int((r >> 13) % 5000);
+      bool ok;
+      switch (r % 4)
+      {
+      case 0:
+         ok = list.add(key) == model.insert(key).second;
+         break;
+      case 1:
+         ok = list.remove(key) == (model.erase(key) == 1);
+         break;
+      case 2:
+         ok = list.contains(key) == (model.count(key) == 1);
+         break;
+      default:
+         {
+            int removed = -1;
+            ok = list.remove_max(removed) == !model.empty();
+            if (ok && !model.empty())
+            {
+               ok = removed == *model.rbegin();
+               model.erase(removed);
+            }
+         }
+      }
+      if (!ok || list.size() != int(model.size())) return false;
+   }
+
+   vector<int> keys;
+   list.snapshot(keys);
+   return keys == vector<int>(model.begin(), model.end());
+}
+
+// One thread of stress: net is set to its successful adds minus its
+// successful removes; sorted is cleared if a snapshot was out of order.
+void run_thread(ConcurrentSkipList& list, int t, long& net, atomic<bool>& sorted)
+{
+   unsigned long long state = (unsigned long long)(t + 1);
+   long n = 0;
+   vector<int> keys;
+   for (int i = 0; i < OPS; ++i)
+   {
+      unsigned long long r = next_random(state);
+      int key = int((r >> 13) % KEYS);
+      int removed;
+      switch (r % 5)
+      {
+      case 0:
+         if (list.add(key)) ++n;
+         break;
+      case 1:
+         if (list.remove(key)) --n;
+         break;
+      case 2:
+         if (list.remove_max(removed)) --n;
+         break;
+      default:
+         list.contains(key);
+      }
+      if (i % 1000 == 0)
+      {
+         list.snapshot(keys);
+         for (size_t j = 1; j < keys.size(); ++j)
+            if (keys[j - 1] >= keys[j]) sorted = false;
+      }
+   }
+   net = n;
+}
+
+bool stress()
+{
+   ConcurrentSkipList list;
+   vector<long> net(THREADS);
+   atomic<bool> sorted(true);
+   vector<thread> threads;
+   for (int t = 0; t < THREADS; ++t)
+      threads.push_back(thread(run_thread, ref(list), t, ref(net[t]), ref(sorted)));
+   for (int t = 0; t < THREADS; ++t)
+      threads[t].join();
+
+   long total = 0;
+   for (int t = 0; t < THREADS; ++t)
+      total += net[t];
+   vector<int> keys;
+   list.snapshot(keys);
+   if (!sorted || long(keys.size()) != total || list.size() != total)
+      return false;
+
+   // adding every key again must leave each exactly once
+   for (int key = 0; key < KEYS; ++key)
+      list.add(key);
+   return list.size() == KEYS;
+}
@@ -0,0 +1,2037 @@
+// FILE: dsaBench.cpp
+// A micro-benchmark driver for the containers in this directory.
+//
+// Currently measures:
+//   - cursor-edit trace replayed against sequence (shifting array),
+//     gap_sequence (gap buffer) and rope_sequence<double> (chunked
+//     copy-on-write tree) at several sizes.
+//   - 1M sequence::attach calls with and without reserve: allocations,
+//     bytes allocated and bytes copied by growth, plus copy vs move of
+//     the resulting sequence.
+//   - loading 10K / 1M / 10M items at the cursor of a sequence, one
+//     attach per item vs one attach_range call.
+//   - sum, min/max, find and count_if over a sequence of double:
+//     walking the cursor with current() vs the built-in scans.
+//   - IntSet: add (ascending / random keys), contains (hits / misses),
+//     remove, unionWith and intersect.
+//   - IntSet membership probes on small (scanned) and big (indexed)
+//     sets: one contains() per key vs one contains_many() call.
+//   - IntSet set algebra: unionWith / intersect / subtract (which build
+//     a new set) vs unionInPlace / intersectInPlace / subtractInPlace,
+//     and bulk_add vs one add per key (run up to 10M with
+//     "dsaBench 10000000").
+//   - IntSet files (IntSetIO): rebuilding a set key by key vs
+//     intset_load, file size vs DumpData text, and IntSetView (mmap)
+//     open + contains vs IntSet::contains.
+//   - ConcurrentIntSet vs an IntSet behind one mutex: a read-mostly
+//     mix (90% contains, 5% add, 5% remove) on 1, 2, 4, ... threads
+//     (up to the hardware thread count, and at least 4).
+//   - IntSet vs RoaringIntSet on dense, sparse and clustered keys:
+//     building, contains, unionWith, intersect, subtract and memory.
+//   - p_queue: push with random / ascending / equal priorities, then
+//     front + pop until empty.
+//   - cnPtrQueue: push everything then pop everything, and a steady
+//     push-push-pop mix.
+//   - BST (btNode, AVL-balanced): insert with shuffled, ascending and
+//     descending keys, bst_size, portToArrayInOrder, the order
+//     statistics (bst_rank, bst_select, bst_count_range), range scans
+//     (bst_range vs a full export), batches one key at a time vs
+//     bst_insert_many / bst_remove_many / bst_remove_range, bst_remove,
+//     bst_remove_max, tree_clear, and the O(n) bulk builds
+//     (bst_build_from_sorted with new and with a node_pool,
+//     bst_build_from_unsorted) and a bounded portToArrayInOrder.
+//   - deep (degenerate) BSTs built by hand, 10M nodes as one chain and
+//     as a zigzag: portToArrayInOrder, the in-, pre- and post-order
+//     iterators (btNodeIter) and tree_clear, none of which recurse.
+//   - IntBTree (B+ tree) vs the btNode BST: building (insert, and
+//     build_from_sorted from portToArrayInOrder), random hit/miss
+//     lookups, lower_bound, remove and memory; lookups also report L1D
+//     and last-level cache read misses per lookup where Linux perf
+//     counters are available ("n/a" otherwise). Run up to 100M with
+//     "dsaBench 100000000" (about 6 GB).
+//   - bt_tree (the templated AVL tree) with int keys vs the btNode
+//     functions and std::set, and with int64 and string keys vs
+//     std::set: insert, contains (half hits) and remove, plus string
+//     lookups by const char* with and without heterogeneous lookup.
+//   - ConcurrentSkipList vs a btNode tree behind one mutex: a
+//     read-heavy mix (10% writes) and a write-heavy mix (50% writes,
+//     half add, half remove) on 1, 2, 4, ... threads (up to the
+//     hardware thread count, and at least 4).
+//   - node_pool vs new/delete for btNode, Node and CNode/PNode:
+//     building (bst_insert, InsertAsHead, a list of lists), walking
+//     the result (portToArrayInOrder, FindListLength) and freeing it
+//     (tree_clear, ListClear, Destroy_pList node by node vs one
+//     release_all).
+//   - linked lists (llcpImp): InsertAsHead, InsertAsTail,
+//     InsertSortedUp, FindListLength, FindMinMax, DelFirstTargetNode
+//     of the last node and ListClear.
+//
+// Every measurement reports ns/op, the number of operator new calls
+// and bytes requested during the timed part, and the process's peak
+// resident set size so far. Allocations are counted by replacing the
+// global operator new/delete in this file, so every container is
+// measured the same way.
+//
+// Usage: dsaBench [max_items] [--json FILE]
+//   max_items defaults to 100000; sizes 1000, 10000, ... up to
+//   max_items are run (operations that are O(n) per call --
+//   InsertAsTail, InsertSortedUp -- stop at QUADRATIC_MAX items).
+//   Every run replays the same pseudo-random
+//   keys and traces (fixed seeds) so numbers are comparable across
+//   builds. With --json, every measurement is also written to FILE as
+//   one JSON object (see write_json), for diffing runs across commits.
+//
+// Build (from the repository root; CMakeLists.txt builds Release by
+// default):
+//   cmake -S . -B build && cmake --build build --target dsa_bench
+//   build/dsa_bench 1000000 --json run.json
+
+#include <atomic>      // provides atomic
+#include <chrono>      // provides steady_clock
+#include <cstdio>      // provides remove
+#include <cstdlib>     // provides EXIT_SUCCESS, EXIT_FAILURE, atol, malloc, free
+#include <cstring>     // provides strcmp, memset
+#include <fstream>     // provides ofstream
+#include <iostream>    // provides cout, cerr
+#include <mutex>       // provides mutex, lock_guard
+#include <set>         // provides set
+#include <new>         // provides bad_alloc
+#include <sstream>     // provides ostringstream
+#include <string>      // provides string
+#include <thread>      // provides thread, hardware_concurrency
+#include <utility>     // provides move, swap
+#include <vector>      // provides vector
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>   // provides getrusage
+#endif
+#if defined(__linux__)
+#include <linux/perf_event.h>   // provides perf_event_attr
+#include <sys/ioctl.h>          // provides ioctl
+#include <sys/syscall.h>        // provides SYS_perf_event_open
+#include <unistd.h>             // provides syscall, read, close
+#endif
+#include "Sequence.h"
+#include "GapSequence.h"
+#include "ropeSequence.h"
+#include "IntSet.h"
+#include "RoaringIntSet.h"
+#include "ConcurrentIntSet.h"
+#include "IntSetIO.h"
+#include "DPQueue.h"
+#include "cnPtrQueue.h"
+#include "btNode.h"
+#include "btNodeIter.h"
+#include "IntBTree.h"
+#include "btTree.h"
+#include "ConcurrentSkipList.h"
+#include "llcpInt.h"
+#include "nodes_LLoLL.h"
+#include "nodePool.h"
+
+using namespace CS3358_FA2023;
+using namespace std;
+using CS3358_FA2023_A7::p_queue;
+using CS3358_FA2023_A5P2::cnPtrQueue;
+using CS3358_FA2023_A5P2::CNode;
+using CS3358_FA2023_A5P2::PNode;
+
+// Global allocation counters (see operator new below). They are
+// atomic because the concurrent benchmarks allocate from several
+// threads at once (relaxed: only totals are read, between timed parts).
+static atomic<size_t> alloc_count(0);
+static atomic<size_t> alloc_bytes(0);
+static atomic<size_t> last_alloc_bytes(0);
+
+void* operator new(size_t bytes)
+{
+   alloc_count.fetch_add(1, memory_order_relaxed);
+   alloc_bytes.fetch_add(bytes, memory_order_relaxed);
+   last_alloc_bytes.store(bytes, memory_order_relaxed);
+   void* p = malloc(bytes == 0 ? 1 : bytes);
+   if (p == 0)
+      throw bad_alloc();
+   return p;
+}
+void* operator new[](size_t bytes) { return operator new(bytes); }
+// GCC pairs new with delete even for replaced operators, and warns when
+// the inlined delete below frees what the operator new above malloc'ed.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+// Largest size run for operations that cost O(n) per call.
+const size_t QUADRATIC_MAX = 10000;
+
+// Predicate for the count_if scans.
+bool is_negative(const double& x)
+{
+   return x < 0;
+}
+
+// One step of a cursor-edit trace.
+struct EditOp
+{
+   enum Kind { START, ADVANCE, INSERT, ATTACH, REMOVE } kind;
+   size_t count;
+};
+
+// One measurement, as printed and as written by --json.
+struct BenchResult
+{
+   string suite;        // container measured
+   string name;         // operation and access pattern
+   size_t items;        // container size the operation ran at
+   size_t ops;          // operations in the timed part
+   double ns;           // elapsed nanoseconds for all ops
+   size_t allocs;       // operator new calls during the timed part
+   size_t bytes;        // bytes requested during the timed part
+   long peak_rss_kb;    // process peak RSS when the timed part ended
+};
+
+// Clock and allocation counters sampled when a timed part starts.
+struct Stopwatch
+{
+   chrono::steady_clock::time_point begin;
+   size_t count0;
+   size_t bytes0;
+};
+
+// Hardware cache-miss counters for this thread (-1 where unavailable).
+struct MissCounters
+{
+   int l1d_fd;          // L1 data cache read misses
+   int llc_fd;          // last-level cache read misses
+};
+
+// Every measurement taken so far, in run order.
+static vector<BenchResult> results;
+
+// PROTOTYPES for functions used by this benchmark program:
+
+unsigned long next_random(unsigned long& state);
+// Pre:  (none)
+// Post: state has been advanced one step of a 64-bit LCG and the
+//       high bits of the new state have been returned.
+void shuffled_keys(size_t items, unsigned long seed, vector<int>& keys);
+// Pre:  items fits in an int.
+// Post: keys holds 0 .. items - 1 in a pseudo-random order fixed by
+//       seed.
+long peak_rss_kb();
+// Pre:  (none)
+// Post: The peak resident set size of this process in KiB has been
+//       returned (0 where getrusage is not available).
+Stopwatch start_timer();
+// Pre:  (none)
+// Post: The clock and the allocation counters have been sampled.
+BenchResult stop_timer(const Stopwatch& timer, const char* suite,
+                       const char* name, size_t items, size_t ops);
+// Pre:  timer came from start_timer; ops > 0.
+// Post: The time, allocations and bytes since timer (and the current
+//       peak RSS) have been appended to results and returned.
+void print_result(const BenchResult& r);
+// Pre:  (none)
+// Post: r has been written to cout as one line.
+MissCounters start_miss_counters();
+// Pre:  (none)
+// Post: The L1D and last-level cache read-miss counters have been
+//       opened and started (an fd of -1 if the kernel or hardware
+//       doesn't provide one, e.g. in most containers and VMs).
+void print_misses(MissCounters& counters, size_t ops);
+// Pre:  counters came from start_miss_counters; ops > 0.
+// Post: The misses per op counted since then have been written to cout
+//       as one line ("n/a" for a missing counter) and the counters
+//       have been closed.
+void write_json(ostream& out, size_t max_items);
+// Pre:  (none)
+// Post: results have been written to out as one JSON object
+//       { "max_items": ..., "peak_rss_kb": ..., "results": [ {suite,
+//       name, items, ops, ns_per_op, allocs, bytes, peak_rss_kb}, ...] }.
+void make_edit_trace(size_t items, vector<EditOp>& trace);
+// Pre:  (none)
+// Post: trace holds a load phase of items attach calls followed by
+//       an edit phase of roughly items cursor moves, insert/attach
+//       bursts and removals, all clustered around a wandering cursor.
+template <class Seq>
+double replay_edit_trace(const vector<EditOp>& trace, const char* suite,
+                         size_t items, double& checksum);
+// Pre:  (none)
+// Post: trace has been replayed against an empty Seq and recorded
+//       under suite; the elapsed time in nanoseconds has been returned
+//       and checksum holds the sum of the final contents (so the
+//       backends can be compared for agreement and the work can't be
+//       optimized away).
+void bench_attach_growth(size_t items);
+// Pre:  (none)
+// Post: items attach calls have been timed on a default-constructed
+//       sequence and on one that reserved items slots first; ns/op,
+//       allocations, bytes allocated and bytes copied by growth (all
+//       of the replaced arrays) have been written to cout, followed by
+//       the cost of copying vs moving the filled sequence.
+void bench_bulk_load(size_t items);
+// Pre:  (none)
+// Post: items values have been loaded right after the first item of a
+//       100-item sequence (so every per-item attach shifts the tail)
+//       once with attach per item and once with attach_range; ns per
+//       loaded item for both has been written to cout.
+void bench_scans(size_t items);
+// Pre:  (none)
+// Post: sum, min/max, an unsuccessful find and a count_if over a
+//       sequence of items doubles have been timed as a start/advance/
+//       current walk and as the built-in scans; ns per item for each
+//       has been written to cout.
+void bench_intset(size_t items);
+// Pre:  (none)
+// Post: IntSet add/contains/unionWith/intersect/remove over items keys
+//       have been timed and printed.
+void bench_intset_probe(int members, size_t probes);
+// Pre:  members > 0
+// Post: probes lookups (half hits, half misses) in an IntSet of
+//       members keys have been timed as a contains() loop and as one
+//       contains_many() call, and printed.
+void bench_intset_algebra(size_t items);
+// Pre:  (none)
+// Post: unionWith/intersect/subtract and their in-place forms on two
+//       half-overlapping sets of items keys, and bulk_add vs an add
+//       loop, have been timed and printed.
+void bench_intset_io(size_t items);
+// Pre:  (none)
+// Post: For random and ascending keys, building an IntSet of items keys
+//       with add, intset_save, intset_load, IntSetView::open and
+//       contains through the view have been timed and printed, with
+//       the file's and DumpData's sizes.
+void bench_concurrent_intset(int members, size_t ops_per_thread);
+// Pre:  members > 0
+// Post: The read-mostly mix has been run against a ConcurrentIntSet and
+//       a mutex-guarded IntSet holding about members keys, on 1, 2,
+//       4, ... threads doing ops_per_thread operations each, and the
+//       time per operation (wall time / all threads' operations) has
+//       been printed.
+void bench_roaring(size_t items);
+// Pre:  (none)
+// Post: IntSet and RoaringIntSet have each been built from the same
+//       two key sets of items keys (dense, sparse and clustered), and
+//       building (key by key, and RoaringIntSet from an IntSet),
+//       contains, unionWith, intersect and subtract have been
+//       timed and printed with the memory each representation holds.
+void bench_p_queue(size_t items);
+// Pre:  (none)
+// Post: items pushes with random, ascending and equal priorities, and
+//       draining the random queue, have been timed and printed.
+void bench_cn_ptr_queue(size_t items);
+// Pre:  (none)
+// Post: cnPtrQueue push-all/pop-all and a push-push-pop mix over items
+//       node pointers have been timed and printed.
+void bench_bst(size_t items);
+// Pre:  (none)
+// Post: BST inserts with shuffled, ascending and descending keys,
+//       bst_size, portToArrayInOrder, bst_rank, bst_select,
+//       bst_count_range, bst_remove, bst_remove_max, tree_clear,
+//       bst_range (vs exporting everything to find a range), batches
+//       of items / 10 keys inserted / removed one by one vs
+//       bst_insert_many / bst_remove_many, removing items / 10
+//       consecutive keys one by one vs bst_remove_range,
+//       bst_build_from_sorted / _unsorted and portToArrayInOrder into
+//       a buffer of items / 10 have been timed and printed.
+void bench_deep_bst(size_t items);
+// Pre:  items fits in an int.
+// Post: For a chain of items btNodes (each the right child of the one
+//       before) and a zigzag of items btNodes (alternately right and
+//       left children), portToArrayInOrder, walking the in-, pre- and
+//       post-order iterators and tree_clear have been timed and
+//       printed.
+void bench_btree(size_t items);
+// Pre:  (none)
+// Post: For items random keys, building a btNode BST and an IntBTree
+//       (by insert and by build_from_sorted), 1M lookups (half hits,
+//       half misses) in each, IntBTree::lower_bound and removing half
+//       the keys have been timed and printed, with cache misses per
+//       lookup and bytes per key.
+void bench_bt_tree(size_t items);
+// Pre:  items fits in an int.
+// Post: bt_tree insert, contains (half hits) and remove over items
+//       shuffled keys have been timed and printed for int keys
+//       (against the btNode functions and std::set), int64 keys and
+//       string keys (against std::set), with string lookups by
+//       const char* with and without a transparent comparator.
+void bench_concurrent_skiplist(int members, size_t ops_per_thread);
+// Pre:  members > 0
+// Post: A read-heavy (10% writes) and a write-heavy (50% writes) mix
+//       have been run against a ConcurrentSkipList and a mutex-guarded
+//       btNode tree holding about members keys, on 1, 2, 4, ...
+//       threads doing ops_per_thread operations each, and the time per
+//       operation has been printed.
+void bench_node_pool(size_t items);
+// Pre:  items fits in an int.
+// Post: Building a BST (bst_insert with shuffled keys), a Node list
+//       (InsertAsHead) and a list of lists (items CNodes under
+//       items / 100 PNodes), walking the first two and freeing all
+//       three have been timed with new/delete and with node_pools, and
+//       printed.
+void bench_llcp(size_t items);
+// Pre:  (none)
+// Post: the llcpImp list routines over items nodes have been timed and
+//       printed (the O(n)-per-call inserts only when items <=
+//       QUADRATIC_MAX).
+
+int main(int argc, char *argv[])
+{
+   size_t max_items = 100000;
+   const char* json_file = 0;
+   for (int i = 1; i < argc; ++i)
+   {
+      if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+         json_file = argv[++i];
+      else
+         max_items = size_t(atol(argv[i]));
+   }
+
+   cout << "cursor-edit trace: sequence vs gap_sequence vs rope_sequence" << endl;
+   for (size_t items = 1000; items <= max_items; items *= 10)
+   {
+      vector<EditOp> trace;
+      make_edit_trace(items, trace);
+
+      double sum_array = 0, sum_gap = 0, sum_rope = 0;
+      double ns_array = replay_edit_trace<sequence>(trace, "sequence", items, sum_array);
+      double ns_gap = replay_edit_trace<gap_sequence>(trace, "gap_sequence", items, sum_gap);
+      double ns_rope = replay_edit_trace< rope_sequence<double> >(trace, "rope_sequence",
+                                                                  items, sum_rope);
+
+      cout << "  items=" << items
+           << "  ops=" << trace.size()
+           << "  sequence " << ns_array / trace.size() << " ns/op"
+           << "  gap_sequence " << ns_gap / trace.size() << " ns/op"
+           << "  rope_sequence " << ns_rope / trace.size() << " ns/op"
+           << (sum_array == sum_gap && sum_array == sum_rope ? "" : "  CHECKSUM MISMATCH")
+           << endl;
+   }
+
+   bench_attach_growth(1000000);
+
+   cout << "bulk load at the cursor: attach per item vs attach_range" << endl;
+   const size_t BULK_SIZES[] = { 10000, 1000000, 10000000 };
+   for (size_t i = 0; i < sizeof(BULK_SIZES) / sizeof(BULK_SIZES[0]); ++i)
+      bench_bulk_load(BULK_SIZES[i]);
+
+   cout << "scans over sequence<double>: cursor walk vs built-in" << endl;
+   for (size_t i = 0; i < sizeof(BULK_SIZES) / sizeof(BULK_SIZES[0]); ++i)
+      bench_scans(BULK_SIZES[i]);
+
+   cout << "IntSet" << endl;
+   for (size_t items = 1000; items <= max_items; items *= 10)
+      bench_intset(items);
+
+   cout << "IntSet probes: contains vs contains_many" << endl;
+   const int PROBE_SET_SIZES[] = { 8, 16, 31, 1000, 100000 };
+   for (size_t i = 0; i < sizeof(PROBE_SET_SIZES) / sizeof(PROBE_SET_SIZES[0]); ++i)
+      bench_intset_probe(PROBE_SET_SIZES[i], 1000000);
+
+   cout << "IntSet set algebra: copying vs in place" << endl;
+   for (size_t items = 1000; items <= max_items; items *= 10)
+      bench_intset_algebra(items);
+
+   cout << "IntSet files: rebuild vs intset_load vs IntSetView" << endl;
+   for (size_t items = 1000; items <= max_items; items *= 10)
+      bench_intset_io(items);
+
+   cout << "ConcurrentIntSet vs mutex + IntSet (90% contains)" << endl;
+   bench_concurrent_intset(10000, 200000);
+
+   cout << "IntSet vs RoaringIntSet" << endl;
+   for (size_t items = 1000; items <= max_items; items *= 10)
+      bench_roaring(items);
+
+   cout << "p_queue" << endl;
+   for (size_t items = 1000; items <= max_items; items *= 10)
+      bench_p_queue(items);
+
+   cout << "cnPtrQueue" << endl;
+   for (size_t items = 1000; items <= max_items; items *= 10)
+      bench_cn_ptr_queue(items);
+
+   cout << "BST (btNode)" << endl;
+   for (size_t items = 1000; items <= max_items; items *= 10)
+      bench_bst(items);
+
+   cout << "deep BST (btNode, built by hand): iterative walks" << endl;
+   bench_deep_bst(10000000);
+
+   cout << "IntBTree (B+ tree) vs BST (btNode)" << endl;
+   for (size_t items = 1000; items <= max_items; items *= 10)
+      bench_btree(items);
+
+   cout << "bt_tree (templated AVL tree) vs btNode and std::set" << endl;
+   for (size_t items = 1000; items <= max_items; items *= 10)
+      bench_bt_tree(items);
+
+   cout << "ConcurrentSkipList vs mutex + btNode" << endl;
+   bench_concurrent_skiplist(100000, 200000);
+
+   cout << "node_pool vs new/delete (btNode, Node, CNode/PNode)" << endl;
+   for (size_t items = 1000; items <= max_items; items *= 10)
+      bench_node_pool(items);
+
+   cout << "linked lists (llcpImp)" << endl;
+   for (size_t items = 1000; items <= max_items; items *= 10)
+      bench_llcp(items);
+
+   cout << "peak RSS " << peak_rss_kb() << " KiB" << endl;
+
+   if (json_file != 0)
+   {
+      ofstream out(json_file);
+      if (out.fail())
+      {
+         cerr << "Unable to open " << json_file << endl;
+         return EXIT_FAILURE;
+      }
+      write_json(out, max_items);
+   }
+
+   return EXIT_SUCCESS;
+}
+
+unsigned long next_random(unsigned long& state)
+{
+   state = state * 6364136223846793005UL + 1442695040888963407UL;
+   return state >> 33;
+}
+
+void shuffled_keys(size_t items, unsigned long seed, vector<int>& keys)
+{
+   keys.resize(items);
+   for (size_t i = 0; i < items; ++i)
+      keys[i] = int(i);
+   for (size_t i = items; i > 1; --i)
+      swap(keys[i - 1], keys[next_random(seed) % i]);
+}
+
+long peak_rss_kb()
+{
+#if defined(__unix__) || defined(__APPLE__)
+   struct rusage usage;
+   if (getrusage(RUSAGE_SELF, &usage) != 0)
+      return 0;
+#ifdef __APPLE__
+   return long(usage.ru_maxrss / 1024);   // bytes on macOS
+#else
+   return long(usage.ru_maxrss);          // KiB on Linux and the BSDs
+#endif
+#else
+   return 0;
+#endif
+}
+
+Stopwatch start_timer()
+{
+   Stopwatch timer;
+   timer.count0 = alloc_count;
+   timer.bytes0 = alloc_bytes;
+   timer.begin = chrono::steady_clock::now();
+   return timer;
+}
+
+BenchResult stop_timer(const Stopwatch& timer, const char* suite,
+                       const char* name, size_t items, size_t ops)
+{
+   chrono::steady_clock::time_point finish = chrono::steady_clock::now();
+   size_t allocs = alloc_count - timer.count0;
+   size_t bytes = alloc_bytes - timer.bytes0;
+
+   BenchResult r;
+   r.suite = suite;
+   r.name = name;
+   r.items = items;
+   r.ops = ops;
+   r.ns = double(chrono::duration_cast<chrono::nanoseconds>(finish - timer.begin).count());
+   r.allocs = allocs;
+   r.bytes = bytes;
+   r.peak_rss_kb = peak_rss_kb();
+   results.push_back(r);
+   return r;
+}
+
+void print_result(const BenchResult& r)
+{
+   cout << "  items=" << r.items
+        << "  " << r.name
+        << "  " << r.ns / r.ops << " ns/op"
+        << "  allocations=" << r.allocs
+        << "  bytes=" << r.bytes
+        << "  peak RSS=" << r.peak_rss_kb << " KiB" << endl;
+}
+
+#if defined(__linux__)
+static int open_miss_counter(unsigned long long cache)
+{
+   struct perf_event_attr attr;
+   memset(&attr, 0, sizeof(attr));
+   attr.size = sizeof(attr);
+   attr.type = PERF_TYPE_HW_CACHE;
+   attr.config = cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+   attr.exclude_kernel = 1;
+   attr.exclude_hv = 1;
+   int fd = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+   if (fd >= 0)
+   {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+   }
+   return fd;
+}
+#endif
+
+MissCounters start_miss_counters()
+{
+   MissCounters counters;
+#if defined(__linux__)
+   counters.l1d_fd = open_miss_counter(PERF_COUNT_HW_CACHE_L1D);
+   counters.llc_fd = open_miss_counter(PERF_COUNT_HW_CACHE_LL);
+#else
+   counters.l1d_fd = counters.llc_fd = -1;
+#endif
+   return counters;
+}
+
+// Prints one counter as misses per op and closes it.
+static void print_miss_count(const char* label, int fd, size_t ops)
+{
+   cout << "  " << label << "=";
+#if defined(__linux__)
+   long long misses = 0;
+   if (fd >= 0 && read(fd, &misses, sizeof(misses)) == ssize_t(sizeof(misses)))
+      cout << double(misses) / ops;
+   else
+      cout << "n/a";
+   if (fd >= 0)
+      close(fd);
+#else
+   (void)fd;
+   (void)ops;
+   cout << "n/a";
+#endif
+}
+
+void print_misses(MissCounters& counters, size_t ops)
+{
+   cout << "   ";
+   print_miss_count("L1D misses/op", counters.l1d_fd, ops);
+   print_miss_count("LLC misses/op", counters.llc_fd, ops);
+   cout << endl;
+   counters.l1d_fd = counters.llc_fd = -1;
+}
+
+// The suite and case names are fixed strings in this file with no
+// quotes or backslashes, so they are written without escaping.
+void write_json(ostream& out, size_t max_items)
+{
+   out << "{\n  \"max_items\": " << max_items
+       << ",\n  \"peak_rss_kb\": " << peak_rss_kb()
+       << ",\n  \"results\": [";
+   for (size_t i = 0; i < results.size(); ++i)
+   {
+      const BenchResult& r = results[i];
+      out << (i == 0 ? "\n" : ",\n")
+          << "    {\"suite\": \"" << r.suite << "\""
+          << ", \"name\": \"" << r.name << "\""
+          << ", \"items\": " << r.items
+          << ", \"ops\": " << r.ops
+          << ", \"ns_per_op\": " << r.ns / r.ops
+          << ", \"allocs\": " << r.allocs
+          << ", \"bytes\": " << r.bytes
+          << ", \"peak_rss_kb\": " << r.peak_rss_kb << "}";
+   }
+   out << "\n  ]\n}\n";
+}
+
+void make_edit_trace(size_t items, vector<EditOp>& trace)
+{
+   unsigned long state = 3358;
+   trace.clear();
+
+   for (size_t i = 0; i < items; ++i)
+   {
+      EditOp op = { EditOp::ATTACH, 0 };
+      trace.push_back(op);
+   }
+
+   EditOp start_op = { EditOp::START, 0 };
+   trace.push_back(start_op);
+   for (size_t i = 0; i < items; ++i)
+   {
+      unsigned long r = next_random(state) % 100;
+      EditOp op = { EditOp::ADVANCE, 1 + next_random(state) % 8 };
+      if (r < 40)
+         op.kind = EditOp::INSERT;
+      else if (r < 75)
+         op.kind = EditOp::ATTACH;
+      else if (r < 90)
+         op.kind = EditOp::REMOVE;
+      else if (r == 99)
+         op.kind = EditOp::START;
+      trace.push_back(op);
+   }
+}
+
+template <class Seq>
+double replay_edit_trace(const vector<EditOp>& trace, const char* suite,
+                         size_t items, double& checksum)
+{
+   Stopwatch timer = start_timer();
+
+   Seq s;
+   double value = 0;
+   for (size_t i = 0; i < trace.size(); ++i)
+   {
+      switch (trace[i].kind)
+      {
+         case EditOp::START:
+            s.start();
+            break;
+         case EditOp::ADVANCE:
+            for (size_t k = 0; k < trace[i].count && s.is_item(); ++k)
+               s.advance();
+            if (!s.is_item())
+               s.start();
+            break;
+         case EditOp::INSERT:
+            s.insert(value += 1);
+            break;
+         case EditOp::ATTACH:
+            s.attach(value += 1);
+            break;
+         case EditOp::REMOVE:
+            if (s.is_item())
+               s.remove_current();
+            break;
+      }
+   }
+
+   BenchResult r = stop_timer(timer, suite, "edit trace", items, trace.size());
+
+   checksum = 0;
+   for (s.start(); s.is_item(); s.advance())
+      checksum += s.current();
+
+   return r.ns;
+}
+
+void bench_attach_growth(size_t items)
+{
+   cout << "sequence::attach x " << items << endl;
+   for (int reserved = 0; reserved <= 1; ++reserved)
+   {
+      sequence s;
+      if (reserved)
+         s.reserve(items);
+
+      Stopwatch timer = start_timer();
+      for (size_t i = 0; i < items; ++i)
+         s.attach(double(i));
+      BenchResult r = stop_timer(timer, "sequence",
+                                 reserved ? "attach (reserved)" : "attach (grow)",
+                                 items, items);
+
+      // every array but the final one was copied out in full when it
+      // was replaced
+      size_t copied = (r.allocs > 0) ? r.bytes - last_alloc_bytes : 0;
+
+      cout << "  " << (reserved ? "reserve first" : "grow on demand")
+           << "  " << r.ns / items << " ns/op"
+           << "  allocations=" << r.allocs
+           << "  bytes allocated=" << r.bytes
+           << "  bytes copied=" << copied << endl;
+
+      if (!reserved)
+      {
+         timer = start_timer();
+         sequence copied_seq(s);
+         r = stop_timer(timer, "sequence", "copy construct", items, 1);
+         cout << "  copy construct " << r.ns << " ns";
+
+         timer = start_timer();
+         sequence moved_seq(std::move(copied_seq));
+         r = stop_timer(timer, "sequence", "move construct", items, 1);
+         cout << "  move construct " << r.ns
+              << " ns  (" << moved_seq.size() << " items)" << endl;
+      }
+   }
+}
+
+void bench_bulk_load(size_t items)
+{
+   const size_t TAIL = 100;
+   vector<double> values(items);
+   for (size_t i = 0; i < items; ++i)
+      values[i] = double(i);
+
+   double ns[2];
+   size_t sizes[2];
+   for (int bulk = 0; bulk <= 1; ++bulk)
+   {
+      sequence s;
+      for (size_t i = 0; i < TAIL; ++i)
+         s.attach(double(i));
+      s.start();
+
+      Stopwatch timer = start_timer();
+      if (bulk)
+         s.attach_range(&values[0], &values[0] + items);
+      else
+         for (size_t i = 0; i < items; ++i)
+            s.attach(values[i]);
+      BenchResult r = stop_timer(timer, "sequence",
+                                 bulk ? "bulk load (attach_range)" : "bulk load (attach)",
+                                 items, items);
+
+      ns[bulk] = r.ns;
+      sizes[bulk] = s.size();
+   }
+
+   cout << "  items=" << items
+        << "  per-item " << ns[0] / items << " ns/item"
+        << "  attach_range " << ns[1] / items << " ns/item"
+        << (sizes[0] == sizes[1] ? "" : "  SIZE MISMATCH") << endl;
+}
+
+void bench_scans(size_t items)
+{
+   sequence s;
+   s.reserve(items);
+   unsigned long state = 7;
+   for (size_t i = 0; i < items; ++i)
+      s.attach(double(next_random(state) % 1000000) - 1000.0);
+
+   double walk_sum = 0, walk_lo = 0, walk_hi = 0;
+   size_t walk_found = 0, walk_count = 0;
+
+   // cursor walks: one current() copy and one cursor write per item
+   Stopwatch timer = start_timer();
+   for (s.start(); s.is_item(); s.advance())
+      walk_sum += s.current();
+   s.start();
+   walk_lo = walk_hi = s.current();
+   for (s.advance(); s.is_item(); s.advance())
+   {
+      if (s.current() < walk_lo) walk_lo = s.current();
+      if (s.current() > walk_hi) walk_hi = s.current();
+   }
+   for (s.start(); s.is_item() && s.current() != -1.5; s.advance())
+      ++walk_found;
+   for (s.start(); s.is_item(); s.advance())
+      walk_count += is_negative(s.current()) ? 1 : 0;
+   double walk_ns = stop_timer(timer, "sequence", "scans (cursor walk)", items, items).ns;
+
+   double sum = 0, lo = 0, hi = 0;
+   size_t count = 0;
+   bool found = false;
+   timer = start_timer();
+   sum = s.sum();
+   s.min_max(lo, hi);
+   found = s.find(-1.5);
+   count = s.count_if(is_negative);
+   double scan_ns = stop_timer(timer, "sequence", "scans (built-in)", items, items).ns;
+
+   bool agree = (lo == walk_lo && hi == walk_hi && count == walk_count &&
+                 found == (walk_found < items));
+   cout << "  items=" << items
+        << "  cursor walk " << walk_ns / items << " ns/item"
+        << "  built-in " << scan_ns / items << " ns/item"
+        << "  (sums " << walk_sum << " / " << sum << ")"
+        << (agree ? "" : "  RESULT MISMATCH") << endl;
+}
+
+void bench_intset(size_t items)
+{
+   vector<int> keys;
+   shuffled_keys(items, 11, keys);
+
+   IntSet ascending;
+   Stopwatch timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      ascending.add(int(i));
+   print_result(stop_timer(timer, "IntSet", "add (ascending)", items, items));
+
+   IntSet s;
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      s.add(keys[i]);
+   print_result(stop_timer(timer, "IntSet", "add (random)", items, items));
+
+   size_t hits = 0;
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      hits += s.contains(keys[i]) ? 1 : 0;
+   print_result(stop_timer(timer, "IntSet", "contains (hit)", items, items));
+
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      hits += s.contains(-1 - keys[i]) ? 1 : 0;
+   print_result(stop_timer(timer, "IntSet", "contains (miss)", items, items));
+
+   // every other key, shifted so half of it lies past s's keys
+   IntSet other;
+   for (size_t i = 1; i < items; i += 2)
+      other.add(int(i + items / 2));
+
+   timer = start_timer();
+   IntSet both = s.unionWith(other);
+   print_result(stop_timer(timer, "IntSet", "unionWith", items, 1));
+
+   timer = start_timer();
+   IntSet common = s.intersect(other);
+   print_result(stop_timer(timer, "IntSet", "intersect", items, 1));
+
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      s.remove(keys[items - 1 - i]);
+   print_result(stop_timer(timer, "IntSet", "remove (random)", items, items));
+
+   if (hits != items || both.size() + common.size() != int(items) + other.size())
+      cout << "  RESULT MISMATCH" << endl;
+}
+
+void bench_intset_probe(int members, size_t probes)
+{
+   IntSet s;
+   for (int i = 0; i < members; ++i)
+      s.add(3 * i);
+
+   // even probes hit, odd probes miss (3 * k + 1 is never a member)
+   unsigned long state = 29;
+   vector<int> keys(probes);
+   for (size_t i = 0; i < probes; ++i)
+      keys[i] = 3 * int(next_random(state) % unsigned(members)) + int(i % 2);
+
+   size_t hits = 0;
+   Stopwatch timer = start_timer();
+   for (size_t i = 0; i < probes; ++i)
+      hits += s.contains(keys[i]) ? 1 : 0;
+   print_result(stop_timer(timer, "IntSet probes", "contains loop", size_t(members), probes));
+
+   bool* out = new bool[probes];
+   timer = start_timer();
+   s.contains_many(&keys[0], probes, out);
+   print_result(stop_timer(timer, "IntSet probes", "contains_many", size_t(members), probes));
+
+   size_t batch_hits = 0;
+   for (size_t i = 0; i < probes; ++i)
+      batch_hits += out[i] ? 1 : 0;
+   delete [] out;
+   if (hits != (probes + 1) / 2 || batch_hits != hits)
+      cout << "  RESULT MISMATCH" << endl;
+}
+
+void bench_intset_algebra(size_t items)
+{
+   vector<int> keys;
+   shuffled_keys(items, 13, keys);
+
+   // a gets the keys, b the upper half of them plus as many new ones
+   IntSet a, b;
+   for (size_t i = 0; i < items; ++i)
+      a.add(keys[i]);
+   for (size_t i = items / 2; i < items; ++i)
+      b.add(keys[i]);
+   for (size_t i = 0; i < items / 2; ++i)
+      b.add(int(items + i));
+
+   Stopwatch timer = start_timer();
+   IntSet u = a.unionWith(b);
+   print_result(stop_timer(timer, "IntSet algebra", "unionWith", items, 1));
+
+   timer = start_timer();
+   IntSet in = a.intersect(b);
+   print_result(stop_timer(timer, "IntSet algebra", "intersect", items, 1));
+
+   timer = start_timer();
+   IntSet sub = a.subtract(b);
+   print_result(stop_timer(timer, "IntSet algebra", "subtract", items, 1));
+
+   // the copies are made outside the timed part
+   IntSet u2(a), in2(a), sub2(a);
+   timer = start_timer();
+   u2.unionInPlace(b);
+   print_result(stop_timer(timer, "IntSet algebra", "unionInPlace", items, 1));
+
+   timer = start_timer();
+   in2.intersectInPlace(b);
+   print_result(stop_timer(timer, "IntSet algebra", "intersectInPlace", items, 1));
+
+   timer = start_timer();
+   sub2.subtractInPlace(b);
+   print_result(stop_timer(timer, "IntSet algebra", "subtractInPlace", items, 1));
+
+   IntSet one_by_one;
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      one_by_one.add(keys[i]);
+   print_result(stop_timer(timer, "IntSet algebra", "add loop", items, items));
+
+   IntSet bulk;
+   timer = start_timer();
+   int added = bulk.bulk_add(&keys[0], int(items));
+   print_result(stop_timer(timer, "IntSet algebra", "bulk_add", items, items));
+
+   size_t half = items - items / 2;
+   if (u.size() != int(items + items / 2) || in.size() != int(half) ||
+       sub.size() != int(items / 2) || !(u2 == u) || !(in2 == in) ||
+       !(sub2 == sub) || added != int(items) || !(bulk == one_by_one))
+      cout << "  RESULT MISMATCH" << endl;
+}
+
+void bench_intset_io(size_t items)
+{
+   const char* path = "dsaBench.intset.tmp";
+   vector<int> random_keys;
+   shuffled_keys(items, 37, random_keys);
+
+   for (int pass = 0; pass < 2; ++pass)
+   {
+      string kind = (pass == 0) ? "random" : "ascending";
+      string build_name = "add loop (" + kind + ")";
+      string save_name = "intset_save (" + kind + ")";
+      string load_name = "intset_load (" + kind + ")";
+      string open_name = "IntSetView open (" + kind + ")";
+      string probe_name = "IntSetView contains (" + kind + ")";
+
+      Stopwatch timer = start_timer();
+      IntSet s;
+      for (size_t i = 0; i < items; ++i)
+         s.add(pass == 0 ? random_keys[i] : int(i));
+      print_result(stop_timer(timer, "IntSet files", build_name.c_str(), items, items));
+
+      ostringstream text;
+      s.DumpData(text);
+      size_t text_bytes = text.str().size();
+
+      timer = start_timer();
+      bool saved = intset_save(s, path);
+      print_result(stop_timer(timer, "IntSet files", save_name.c_str(), items, 1));
+
+      ostringstream binary;
+      intset_save(s, binary);
+      size_t file_bytes = binary.str().size();
+      cout << "  items=" << items << "  file " << double(file_bytes) / items
+           << " bytes/member  (DumpData text " << double(text_bytes) / items
+           << ", IntSet array 4)" << endl;
+
+      IntSet loaded;
+      timer = start_timer();
+      bool load_ok = intset_load(path, loaded);
+      print_result(stop_timer(timer, "IntSet files", load_name.c_str(), items, 1));
+
+      IntSetView view;
+      timer = start_timer();
+      bool open_ok = view.open(path, false);
+      print_result(stop_timer(timer, "IntSet files", open_name.c_str(), items, 1));
+
+      size_t hits = 0;
+      timer = start_timer();
+      for (size_t i = 0; i < items; ++i)
+         hits += view.contains(random_keys[i]) ? 1 : 0;
+      print_result(stop_timer(timer, "IntSet files", probe_name.c_str(), items, items));
+
+      if (!saved || !load_ok || !open_ok || !(loaded == s) ||
+          view.size() != s.size() || hits != items)
+         cout << "  RESULT MISMATCH" << endl;
+   }
+   remove(path);
+}
+
+// One thread's share of a mix over keys in [0, 2 * members):
+// write_percent% of the operations are writes (half add, half remove),
+// the rest contains. Returns the number of hits.
+template <class Set>
+size_t run_mix(Set& s, int members, unsigned write_percent, size_t ops,
+               unsigned long seed)
+{
+   unsigned long state = seed;
+   size_t hits = 0;
+   for (size_t i = 0; i < ops; ++i)
+   {
+      unsigned long r = next_random(state);
+      int key = int(r % unsigned(2 * members));
+      unsigned long pick = (r >> 20) % 100;
+      if (pick < write_percent / 2)
+         s.add(key);
+      else if (pick < write_percent)
+         s.remove(key);
+      else
+         hits += s.contains(key) ? 1 : 0;
+   }
+   return hits;
+}
+
+// The way the set is shared today: one lock around every call.
+struct locked_int_set
+{
+   IntSet set;
+   mutex lock;
+
+   explicit locked_int_set(int capacity) : set(capacity) {}
+
+   bool add(int anInt) { lock_guard<mutex> hold(lock); return set.add(anInt); }
+   bool remove(int anInt) { lock_guard<mutex> hold(lock); return set.remove(anInt); }
+   bool contains(int anInt) { lock_guard<mutex> hold(lock); return set.contains(anInt); }
+};
+
+template <class Set>
+void time_mix(Set& s, const char* suite, const char* name, int members,
+              unsigned write_percent, size_t threads, size_t ops_per_thread)
+{
+   string label = string(name) + " (" + to_string(write_percent) + "% writes, " +
+                  to_string(threads) + " threads)";
+   vector<size_t> hits(threads);
+   vector<thread> workers;
+   Stopwatch timer = start_timer();
+   for (size_t t = 0; t < threads; ++t)
+      workers.push_back(thread([&s, &hits, t, members, write_percent, ops_per_thread]()
+         { hits[t] = run_mix(s, members, write_percent, ops_per_thread, 31 + t); }));
+   for (size_t t = 0; t < threads; ++t)
+      workers[t].join();
+   BenchResult r = stop_timer(timer, suite, label.c_str(), size_t(members),
+                              threads * ops_per_thread);
+   cout << "  threads=" << threads << "  " << name << "  "
+        << r.ns / r.ops << " ns/op  " << 1e3 * r.ops / r.ns << " Mops/s" << endl;
+}
+
+// Both sets start with the even keys below 2 * members. They are sized
+// for every key, so the ConcurrentIntSet never resizes.
+void bench_concurrent_intset(int members, size_t ops_per_thread)
+{
+   size_t most = thread::hardware_concurrency();
+   if (most < 4) most = 4;
+
+   for (size_t threads = 1; threads <= most; threads *= 2)
+   {
+      ConcurrentIntSet shared(2 * members);
+      locked_int_set locked(2 * members);
+      for (int k = 0; k < 2 * members; k += 2)
+      {
+         shared.add(k);
+         locked.set.add(k);
+      }
+
+      time_mix(shared, "concurrent set", "ConcurrentIntSet", members, 10, threads,
+               ops_per_thread);
+      time_mix(locked, "concurrent set", "mutex + IntSet", members, 10, threads,
+               ops_per_thread);
+   }
+}
+
+void bench_roaring(size_t items)
+{
+   const char* PATTERNS[] = { "dense", "sparse", "clustered" };
+   for (int pattern = 0; pattern < 3; ++pattern)
+   {
+      // a and b overlap in about half of their keys
+      unsigned long state = 59;
+      vector<int> a(items), b(items);
+      for (size_t i = 0; i < items; ++i)
+      {
+         if (pattern == 0)          // one block of consecutive ints
+         {
+            a[i] = int(i);
+            b[i] = int(i + items / 2);
+         }
+         else if (pattern == 1)     // spread over the whole int range
+         {
+            a[i] = int(next_random(state) * 2);
+            b[i] = (i % 2 == 0) ? a[i] : int(next_random(state) * 2 + 1);
+         }
+         else                       // runs of 1000 at random places
+         {
+            if (i % 1000 == 0)
+               a[i] = int(next_random(state) % 1000000000);
+            else
+               a[i] = a[i - 1] + 1;
+            b[i] = a[i] + 500;
+         }
+      }
+
+      string name;
+      string tag = string(" (") + PATTERNS[pattern] + ")";
+
+      IntSet ia, ib;
+      Stopwatch timer = start_timer();
+      for (size_t i = 0; i < items; ++i)
+         ia.add(a[i]);
+      name = "add" + tag;
+      print_result(stop_timer(timer, "IntSet", name.c_str(), items, items));
+      for (size_t i = 0; i < items; ++i)
+         ib.add(b[i]);
+
+      RoaringIntSet ra, rb;
+      timer = start_timer();
+      for (size_t i = 0; i < items; ++i)
+         ra.add(a[i]);
+      ra.run_optimize();
+      name = "add + run_optimize" + tag;
+      print_result(stop_timer(timer, "RoaringIntSet", name.c_str(), items, items));
+      for (size_t i = 0; i < items; ++i)
+         rb.add(b[i]);
+      rb.run_optimize();
+
+      timer = start_timer();
+      RoaringIntSet converted(ia);
+      name = "build from IntSet" + tag;
+      print_result(stop_timer(timer, "RoaringIntSet", name.c_str(), items, items));
+
+      size_t hits = 0;
+      timer = start_timer();
+      for (size_t i = 0; i < items; ++i)
+         hits += ia.contains(b[i]) ? 1 : 0;
+      name = "contains" + tag;
+      print_result(stop_timer(timer, "IntSet", name.c_str(), items, items));
+      timer = start_timer();
+      for (size_t i = 0; i < items; ++i)
+         hits -= ra.contains(b[i]) ? 1 : 0;
+      print_result(stop_timer(timer, "RoaringIntSet", name.c_str(), items, items));
+
+      timer = start_timer();
+      IntSet iu = ia.unionWith(ib);
+      name = "unionWith" + tag;
+      print_result(stop_timer(timer, "IntSet", name.c_str(), items, 1));
+      timer = start_timer();
+      RoaringIntSet ru = ra.unionWith(rb);
+      print_result(stop_timer(timer, "RoaringIntSet", name.c_str(), items, 1));
+
+      timer = start_timer();
+      IntSet ii = ia.intersect(ib);
+      name = "intersect" + tag;
+      print_result(stop_timer(timer, "IntSet", name.c_str(), items, 1));
+      timer = start_timer();
+      RoaringIntSet ri = ra.intersect(rb);
+      print_result(stop_timer(timer, "RoaringIntSet", name.c_str(), items, 1));
+
+      timer = start_timer();
+      IntSet is = ia.subtract(ib);
+      name = "subtract" + tag;
+      print_result(stop_timer(timer, "IntSet", name.c_str(), items, 1));
+      timer = start_timer();
+      RoaringIntSet rs = ra.subtract(rb);
+      print_result(stop_timer(timer, "RoaringIntSet", name.c_str(), items, 1));
+
+      cout << "  items=" << items << "  memory" << tag
+           << "  IntSet data " << ia.size() * sizeof(int) << " bytes (plus index)"
+           << "  RoaringIntSet " << ra.bytes_used() << " bytes" << endl;
+
+      if (hits != 0 || !(converted == ra) || iu.size() != ru.size() || ii.size() != ri.size() ||
+          is.size() != rs.size())
+         cout << "  RESULT MISMATCH" << endl;
+   }
+}
+
+void bench_p_queue(size_t items)
+{
+   unsigned long state = 23;
+
+   p_queue random_pq;
+   Stopwatch timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      random_pq.push(int(i), p_queue::size_type(next_random(state) % 1000000));
+   print_result(stop_timer(timer, "p_queue", "push (random priority)", items, items));
+
+   // each new entry outranks the rest, so it climbs all the way up
+   p_queue ascending;
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      ascending.push(int(i), p_queue::size_type(i));
+   print_result(stop_timer(timer, "p_queue", "push (ascending priority)", items, items));
+
+   p_queue equal;
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      equal.push(int(i), 1);
+   print_result(stop_timer(timer, "p_queue", "push (equal priority)", items, items));
+
+   long checksum = 0;
+   timer = start_timer();
+   while (!random_pq.empty())
+   {
+      checksum += random_pq.front();
+      random_pq.pop();
+   }
+   print_result(stop_timer(timer, "p_queue", "front + pop (random priority)", items, items));
+
+   if (checksum != long(items) * long(items - 1) / 2)
+      cout << "  RESULT MISMATCH" << endl;
+}
+
+void bench_cn_ptr_queue(size_t items)
+{
+   vector<CNode> nodes(items);
+   for (size_t i = 0; i < items; ++i)
+   {
+      nodes[i].data = int(i);
+      nodes[i].link = 0;
+   }
+
+   long checksum = 0;
+   {
+      cnPtrQueue q;
+      Stopwatch timer = start_timer();
+      for (size_t i = 0; i < items; ++i)
+         q.push(&nodes[i]);
+      while (!q.empty())
+      {
+         checksum += q.front()->data;
+         q.pop();
+      }
+      print_result(stop_timer(timer, "cnPtrQueue", "push all, pop all", items, 2 * items));
+   }
+
+   {
+      // the out stack is refilled from the in stack over and over
+      cnPtrQueue q;
+      size_t next = 0;
+      Stopwatch timer = start_timer();
+      while (next < items)
+      {
+         q.push(&nodes[next++]);
+         if (next < items)
+            q.push(&nodes[next++]);
+         checksum += q.front()->data;
+         q.pop();
+      }
+      while (!q.empty())
+      {
+         checksum += q.front()->data;
+         q.pop();
+      }
+      print_result(stop_timer(timer, "cnPtrQueue", "push, push, pop", items, 2 * items));
+   }
+
+   if (checksum != long(items) * long(items - 1))
+      cout << "  RESULT MISMATCH" << endl;
+}
+
+// bst_range callback: counts the keys it is given.
+static void count_key(int, void* count)
+{
+   ++*static_cast<long long*>(count);
+}
+
+void bench_bst(size_t items)
+{
+   vector<int> keys;
+   shuffled_keys(items, 31, keys);
+   vector<int> in_order(items);
+
+   btNode* root = 0;
+   Stopwatch timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      bst_insert(root, keys[i]);
+   print_result(stop_timer(timer, "bst", "insert (shuffled)", items, items));
+
+   timer = start_timer();
+   int size = bst_size(root);
+   print_result(stop_timer(timer, "bst", "bst_size", items, 1));
+
+   timer = start_timer();
+   portToArrayInOrder(root, &in_order[0]);
+   print_result(stop_timer(timer, "bst", "portToArrayInOrder", items, 1));
+
+   // the keys are 0 .. items - 1, so key k has rank k
+   long long rank_sum = 0, select_sum = 0, range_sum = 0;
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      rank_sum += bst_rank(root, keys[i]) - keys[i];
+   print_result(stop_timer(timer, "bst", "bst_rank", items, items));
+
+   int selected = 0;
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      if (bst_select(root, keys[i], selected))
+         select_sum += selected - keys[i];
+   print_result(stop_timer(timer, "bst", "bst_select", items, items));
+
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      range_sum += bst_count_range(root, keys[i] - 50, keys[i] + 49);
+   print_result(stop_timer(timer, "bst", "bst_count_range (100 wide)", items, items));
+   // each range is clipped at 0 and items - 1
+   long long range_expected = 0;
+   for (size_t i = 0; i < items; ++i)
+   {
+      int lo = (keys[i] < 50) ? 0 : keys[i] - 50;
+      int hi = (keys[i] + 49 > int(items) - 1) ? int(items) - 1 : keys[i] + 49;
+      range_expected += hi - lo + 1;
+   }
+
+   // the same ranges scanned with bst_range, and a few scanned the old
+   // way: export everything, then look for the range
+   long long scanned_sum = 0;
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      bst_range(root, keys[i] - 50, keys[i] + 49, count_key, &scanned_sum);
+   print_result(stop_timer(timer, "bst", "bst_range (100 wide)", items, items));
+
+   const size_t EXPORT_SCANS = 10;
+   long long exported_sum = 0;
+   timer = start_timer();
+   for (size_t i = 0; i < EXPORT_SCANS; ++i)
+   {
+      portToArrayInOrder(root, &in_order[0]);
+      for (size_t j = 0; j < items; ++j)
+         if (in_order[j] >= keys[i] - 50 && in_order[j] <= keys[i] + 49)
+            ++exported_sum;
+   }
+   print_result(stop_timer(timer, "bst", "range via portToArrayInOrder (100 wide)",
+                           items, EXPORT_SCANS));
+   long long exported_expected = 0;
+   for (size_t i = 0; i < EXPORT_SCANS; ++i)
+   {
+      int lo = (keys[i] < 50) ? 0 : keys[i] - 50;
+      int hi = (keys[i] + 49 > int(items) - 1) ? int(items) - 1 : keys[i] + 49;
+      exported_expected += hi - lo + 1;
+   }
+
+   timer = start_timer();
+   for (size_t i = 0; i < items / 2; ++i)
+      bst_remove(root, keys[i]);
+   print_result(stop_timer(timer, "bst", "bst_remove (shuffled)", items, items / 2));
+
+   timer = start_timer();
+   tree_clear(root);
+   print_result(stop_timer(timer, "bst", "tree_clear", items - items / 2, 1));
+
+   // sorted input was the worst case before balancing (a chain of
+   // right or left children); now it costs the same as shuffled
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      bst_insert(root, int(i));
+   print_result(stop_timer(timer, "bst", "insert (ascending)", items, items));
+
+   int largest = -1;
+   timer = start_timer();
+   for (size_t i = 0; i < items / 2; ++i)
+      bst_remove_max(root, largest);
+   print_result(stop_timer(timer, "bst", "bst_remove_max", items, items / 2));
+   tree_clear(root);
+
+   timer = start_timer();
+   for (size_t i = items; i > 0; --i)
+      bst_insert(root, int(i - 1));
+   print_result(stop_timer(timer, "bst", "insert (descending)", items, items));
+   int descending_size = bst_size(root);
+   tree_clear(root);
+
+   // bulk builds, from the portToArrayInOrder output and from keys
+   timer = start_timer();
+   root = bst_build_from_sorted(&in_order[0], int(items));
+   print_result(stop_timer(timer, "bst", "bst_build_from_sorted", items, items));
+   int built_size = bst_size(root);
+
+   vector<int> first_tenth(items / 10 + 1);
+   timer = start_timer();
+   int reported = portToArrayInOrder(root, &first_tenth[0], int(items / 10));
+   print_result(stop_timer(timer, "bst", "portToArrayInOrder (capacity n/10)",
+                           items, 1));
+   tree_clear(root);
+
+   {
+      node_pool<btNode> pool;
+      timer = start_timer();
+      root = bst_build_from_sorted(&in_order[0], int(items), pool);
+      print_result(stop_timer(timer, "bst", "bst_build_from_sorted (node_pool)",
+                              items, items));
+      tree_clear(root, pool);
+   }
+
+   // a batch of items / 10 new keys (items .. , shuffled) and the
+   // middle tenth of the keys: one call per key vs one batch call
+   size_t batch_size = items / 10;
+   vector<int> batch;
+   shuffled_keys(batch_size, 37, batch);
+   for (size_t i = 0; i < batch_size; ++i)
+      batch[i] += int(items);
+   int range_lo = int(items / 2), range_hi = int(items / 2 + batch_size) - 1;
+   btNode* one_by_one = bst_build_from_sorted(&in_order[0], int(items));
+   root = bst_build_from_sorted(&in_order[0], int(items));
+
+   timer = start_timer();
+   for (size_t i = 0; i < batch_size; ++i)
+      bst_insert(one_by_one, batch[i]);
+   print_result(stop_timer(timer, "bst", "insert batch (one bst_insert per key)",
+                           items, batch_size));
+   timer = start_timer();
+   int batch_added = bst_insert_many(root, &batch[0], int(batch_size));
+   print_result(stop_timer(timer, "bst", "bst_insert_many", items, batch_size));
+
+   timer = start_timer();
+   for (size_t i = 0; i < batch_size; ++i)
+      bst_remove(one_by_one, batch[i]);
+   print_result(stop_timer(timer, "bst", "remove batch (one bst_remove per key)",
+                           items, batch_size));
+   timer = start_timer();
+   int batch_removed = bst_remove_many(root, &batch[0], int(batch_size));
+   print_result(stop_timer(timer, "bst", "bst_remove_many", items, batch_size));
+
+   timer = start_timer();
+   for (int k = range_lo; k <= range_hi; ++k)
+      bst_remove(one_by_one, k);
+   print_result(stop_timer(timer, "bst", "remove range (one bst_remove per key)",
+                           items, batch_size));
+   timer = start_timer();
+   int range_removed = bst_remove_range(root, range_lo, range_hi);
+   print_result(stop_timer(timer, "bst", "bst_remove_range", items, batch_size));
+   int batch_size_after = bst_size(root), one_by_one_size = bst_size(one_by_one);
+   tree_clear(one_by_one);
+   tree_clear(root);
+
+   timer = start_timer();
+   root = bst_build_from_unsorted(&keys[0], int(items));
+   print_result(stop_timer(timer, "bst", "bst_build_from_unsorted", items, items));
+   int unsorted_size = bst_size(root);
+   tree_clear(root);
+
+   if (size != int(items) || in_order[items - 1] != int(items - 1) ||
+       rank_sum != 0 || select_sum != 0 || range_sum != range_expected ||
+       scanned_sum != range_expected || exported_sum != exported_expected ||
+       batch_added != int(batch_size) || batch_removed != int(batch_size) ||
+       range_removed != int(batch_size) || batch_size_after != one_by_one_size ||
+       batch_size_after != int(items - batch_size) ||
+       largest != int(items - items / 2) || descending_size != int(items) ||
+       built_size != int(items) || unsorted_size != int(items) ||
+       reported != int(items) || first_tenth[items / 10 - 1] != int(items / 10 - 1))
+      cout << "  RESULT MISMATCH" << endl;
+}
+
+// Links items hand-made nodes below one another: as right children
+// (a chain, 0 .. items - 1 from the top), or for zigzag alternately as
+// right and left children (0, items - 1, 1, items - 2, ...), which is
+// still a valid BST. Heights and sizes are filled in from the bottom.
+static btNode* build_degenerate(size_t items, bool zigzag)
+{
+   vector<btNode*> nodes(items);
+   for (size_t i = 0; i < items; ++i)
+   {
+      btNode* node = new btNode;
+      if (!zigzag)
+         node->data = int(i);
+      else
+         node->data = (i % 2 == 0) ? int(i / 2) : int(items - 1 - i / 2);
+      node->left = node->right = 0;
+      nodes[i] = node;
+   }
+   for (size_t i = items; i > 0; --i)
+   {
+      btNode* node = nodes[i - 1];
+      if (i < items)
+      {
+         if (!zigzag || (i - 1) % 2 == 0)
+            node->right = nodes[i];
+         else
+            node->left = nodes[i];
+      }
+      node->height = node->size = int(items - (i - 1));
+   }
+   return items == 0 ? 0 : nodes[0];
+}
+
+void bench_deep_bst(size_t items)
+{
+   const char* SHAPES[] = { "chain", "zigzag" };
+   for (int shape = 0; shape < 2; ++shape)
+   {
+      btNode* root = build_degenerate(items, shape == 1);
+      vector<int> in_order(items);
+      string label = string("portToArrayInOrder (") + SHAPES[shape] + ")";
+      Stopwatch timer = start_timer();
+      portToArrayInOrder(root, &in_order[0]);
+      print_result(stop_timer(timer, "deep bst", label.c_str(), items, items));
+
+      long long in_sum = 0, pre_sum = 0, post_sum = 0;
+      label = string("in-order iterator (") + SHAPES[shape] + ")";
+      timer = start_timer();
+      for (int key : bst_in_order(root))
+         in_sum += key;
+      print_result(stop_timer(timer, "deep bst", label.c_str(), items, items));
+
+      label = string("pre-order iterator (") + SHAPES[shape] + ")";
+      timer = start_timer();
+      for (int key : bst_pre_order(root))
+         pre_sum += key;
+      print_result(stop_timer(timer, "deep bst", label.c_str(), items, items));
+
+      label = string("post-order iterator (") + SHAPES[shape] + ")";
+      timer = start_timer();
+      for (int key : bst_post_order(root))
+         post_sum += key;
+      print_result(stop_timer(timer, "deep bst", label.c_str(), items, items));
+
+      label = string("tree_clear (") + SHAPES[shape] + ")";
+      timer = start_timer();
+      tree_clear(root);
+      print_result(stop_timer(timer, "deep bst", label.c_str(), items, items));
+
+      long long expected = (long long)(items) * (items - 1) / 2;
+      bool sorted = true;
+      for (size_t i = 1; i < items; ++i)
+         sorted = sorted && in_order[i - 1] < in_order[i];
+      if (!sorted || in_sum != expected || pre_sum != expected ||
+          post_sum != expected || root != 0)
+         cout << "  RESULT MISMATCH" << endl;
+   }
+}
+
+// Plain descent, the same search bst_insert and bst_remove make.
+static bool bst_lookup(const btNode* node, int key)
+{
+   while (node != 0)
+   {
+      if (key < node->data)
+         node = node->left;
+      else if (key > node->data)
+         node = node->right;
+      else
+         return true;
+   }
+   return false;
+}
+
+void bench_btree(size_t items)
+{
+   // members are even, so 2k + 1 is a miss between two members
+   vector<int> keys;
+   shuffled_keys(items, 37, keys);
+   for (size_t i = 0; i < items; ++i)
+      keys[i] *= 2;
+
+   const size_t PROBES = 1000000;
+   unsigned long state = 41;
+   vector<int> probes(PROBES);
+   for (size_t i = 0; i < PROBES; ++i)
+      probes[i] = 2 * int(next_random(state) % items) + int(i % 2);
+
+   btNode* root = 0;
+   Stopwatch timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      bst_insert(root, keys[i]);
+   BenchResult bst_build = stop_timer(timer, "IntBTree vs bst", "bst insert (shuffled)",
+                                      items, items);
+   print_result(bst_build);
+
+   IntBTree inserted;
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      inserted.insert(keys[i]);
+   print_result(stop_timer(timer, "IntBTree vs bst", "IntBTree insert (shuffled)",
+                           items, items));
+
+   vector<int> in_order(items);
+   portToArrayInOrder(root, &in_order[0]);
+   IntBTree packed;
+   timer = start_timer();
+   packed.build_from_sorted(&in_order[0], int(items));
+   print_result(stop_timer(timer, "IntBTree vs bst", "IntBTree build_from_sorted",
+                           items, items));
+
+   size_t bst_hits = 0;
+   MissCounters misses = start_miss_counters();
+   timer = start_timer();
+   for (size_t i = 0; i < PROBES; ++i)
+      bst_hits += bst_lookup(root, probes[i]) ? 1 : 0;
+   print_result(stop_timer(timer, "IntBTree vs bst", "bst lookup", items, PROBES));
+   print_misses(misses, PROBES);
+
+   size_t inserted_hits = 0;
+   misses = start_miss_counters();
+   timer = start_timer();
+   for (size_t i = 0; i < PROBES; ++i)
+      inserted_hits += inserted.contains(probes[i]) ? 1 : 0;
+   print_result(stop_timer(timer, "IntBTree vs bst", "IntBTree contains (inserted)",
+                           items, PROBES));
+   print_misses(misses, PROBES);
+
+   size_t packed_hits = 0;
+   misses = start_miss_counters();
+   timer = start_timer();
+   for (size_t i = 0; i < PROBES; ++i)
+      packed_hits += packed.contains(probes[i]) ? 1 : 0;
+   print_result(stop_timer(timer, "IntBTree vs bst", "IntBTree contains (packed)",
+                           items, PROBES));
+   print_misses(misses, PROBES);
+
+   // a hit is its own bound and a miss 2k + 1 is 1 short of its bound,
+   // except past the largest member, where there is none
+   long long expected_gap = 0;
+   for (size_t i = 0; i < PROBES; ++i)
+      if (probes[i] % 2 == 1 && probes[i] < 2 * int(items) - 1)
+         ++expected_gap;
+   long long bound_sum = 0;
+   int found = 0;
+   timer = start_timer();
+   for (size_t i = 0; i < PROBES; ++i)
+      if (packed.lower_bound(probes[i], found))
+         bound_sum += found - probes[i];
+   print_result(stop_timer(timer, "IntBTree vs bst", "IntBTree lower_bound",
+                           items, PROBES));
+
+   cout << "  items=" << items
+        << "  bytes/key: bst " << double(bst_build.bytes) / items
+        << "  IntBTree (inserted) " << double(inserted.bytes_used()) / items
+        << "  IntBTree (packed) " << double(packed.bytes_used()) / items
+        << "  height: IntBTree " << inserted.height() << " / " << packed.height()
+        << endl;
+
+   timer = start_timer();
+   for (size_t i = 0; i < items / 2; ++i)
+      bst_remove(root, keys[i]);
+   print_result(stop_timer(timer, "IntBTree vs bst", "bst_remove (shuffled)",
+                           items, items / 2));
+
+   timer = start_timer();
+   for (size_t i = 0; i < items / 2; ++i)
+      inserted.remove(keys[i]);
+   print_result(stop_timer(timer, "IntBTree vs bst", "IntBTree remove (shuffled)",
+                           items, items / 2));
+
+   int bst_left = bst_size(root);
+   tree_clear(root);
+
+   if (bst_hits != PROBES / 2 || inserted_hits != bst_hits || packed_hits != bst_hits ||
+       bound_sum != expected_gap ||
+       bst_left != int(items - items / 2) || inserted.size() != bst_left)
+      cout << "  RESULT MISMATCH" << endl;
+}
+
+// Inserts keys (in order) into a bt_tree<Key> and a std::set<Key>,
+// looks up every key and every miss, then removes the first half of
+// keys, timing each step in both. Returns false on a wrong result.
+template <class Key>
+static bool time_bt_tree(const char* kind, const vector<Key>& keys,
+                         const vector<Key>& misses)
+{
+   size_t items = keys.size();
+   // labels built here, so the timed steps make no allocations of their own
+   string tree_name = string(" (bt_tree<") + kind + ">)";
+   string set_name = string(" (std::set<") + kind + ">)";
+   string insert_tree = "insert" + tree_name, insert_set = "insert" + set_name;
+   string contains_tree = "contains, half hits" + tree_name;
+   string count_set = "count, half hits" + set_name;
+   string remove_tree = "remove" + tree_name, erase_set = "erase" + set_name;
+
+   bt_tree<Key> tree;
+   Stopwatch timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      tree.insert(keys[i]);
+   print_result(stop_timer(timer, "bt_tree", insert_tree.c_str(), items, items));
+
+   set<Key> reference;
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      reference.insert(keys[i]);
+   print_result(stop_timer(timer, "bt_tree", insert_set.c_str(), items, items));
+
+   size_t tree_hits = 0, set_hits = 0;
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      tree_hits += (tree.contains(keys[i]) ? 1 : 0) + (tree.contains(misses[i]) ? 1 : 0);
+   print_result(stop_timer(timer, "bt_tree", contains_tree.c_str(),
+                           items, 2 * items));
+
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      set_hits += reference.count(keys[i]) + reference.count(misses[i]);
+   print_result(stop_timer(timer, "bt_tree", count_set.c_str(),
+                           items, 2 * items));
+
+   timer = start_timer();
+   for (size_t i = 0; i < items / 2; ++i)
+      tree.remove(keys[i]);
+   print_result(stop_timer(timer, "bt_tree", remove_tree.c_str(), items, items / 2));
+
+   timer = start_timer();
+   for (size_t i = 0; i < items / 2; ++i)
+      reference.erase(keys[i]);
+   print_result(stop_timer(timer, "bt_tree", erase_set.c_str(), items, items / 2));
+
+   return tree_hits == items && set_hits == items && tree.size() == reference.size();
+}
+
+// The keys are the shuffled 0 .. items - 1, doubled for int (so odd
+// numbers miss), shifted into the high half for int64 and spelled out
+// for strings.
+void bench_bt_tree(size_t items)
+{
+   vector<int> keys;
+   shuffled_keys(items, 41, keys);
+   vector<int> int_keys(items), int_misses(items);
+   vector<long long> long_keys(items), long_misses(items);
+   vector<string> string_keys(items), string_misses(items);
+   for (size_t i = 0; i < items; ++i)
+   {
+      int_keys[i] = 2 * keys[i];
+      int_misses[i] = 2 * keys[i] + 1;
+      long_keys[i] = (long long)keys[i] << 32;
+      long_misses[i] = long_keys[i] + 1;
+      string_keys[i] = "key:" + to_string(keys[i]);
+      string_misses[i] = string_keys[i] + "+";
+   }
+
+   // the int tree against the btNode functions it generalizes (the
+   // btNode tree is kept until both are timed, so neither gets the
+   // other's freed nodes back from the heap)
+   btNode* root = 0;
+   Stopwatch timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      bst_insert(root, int_keys[i]);
+   print_result(stop_timer(timer, "bt_tree", "insert (btNode)", items, items));
+   size_t node_hits = 0;
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      node_hits += (bst_lookup(root, int_keys[i]) ? 1 : 0) +
+                   (bst_lookup(root, int_misses[i]) ? 1 : 0);
+   print_result(stop_timer(timer, "bt_tree", "lookup, half hits (btNode)", items, 2 * items));
+   timer = start_timer();
+   for (size_t i = 0; i < items / 2; ++i)
+      bst_remove(root, int_keys[i]);
+   print_result(stop_timer(timer, "bt_tree", "bst_remove (btNode)", items, items / 2));
+
+   bool ok = node_hits == items;
+   ok = time_bt_tree("int", int_keys, int_misses) && ok;
+   tree_clear(root);
+   ok = time_bt_tree("int64", long_keys, long_misses) && ok;
+   ok = time_bt_tree("string", string_keys, string_misses) && ok;
+
+   // heterogeneous lookup: C strings against string keys, converted to
+   // a string per call vs compared directly (bt_less)
+   vector<const char*> probes(items);
+   for (size_t i = 0; i < items; ++i)
+      probes[i] = string_keys[i].c_str();
+   bt_tree<string> plain;
+   bt_tree<string, bt_no_value, bt_less> transparent;
+   plain.insert_many(string_keys.begin(), string_keys.end());
+   transparent.insert_many(string_keys.begin(), string_keys.end());
+   size_t plain_hits = 0, transparent_hits = 0;
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      plain_hits += plain.contains(probes[i]) ? 1 : 0;
+   print_result(stop_timer(timer, "bt_tree", "contains(const char*) via string",
+                           items, items));
+   timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      transparent_hits += transparent.contains(probes[i]) ? 1 : 0;
+   print_result(stop_timer(timer, "bt_tree", "contains(const char*), bt_less",
+                           items, items));
+
+   if (!ok || plain_hits != items || transparent_hits != items)
+      cout << "  RESULT MISMATCH" << endl;
+}
+
+// A btNode tree shared the simple way: one lock around every call.
+struct locked_bst
+{
+   btNode* root;
+   mutex lock;
+
+   locked_bst() : root(0) {}
+   ~locked_bst() { tree_clear(root); }
+
+   bool add(int anInt)
+   {
+      lock_guard<mutex> hold(lock);
+      if (bst_lookup(root, anInt)) return false;
+      bst_insert(root, anInt);
+      return true;
+   }
+   bool remove(int anInt) { lock_guard<mutex> hold(lock); return bst_remove(root, anInt); }
+   bool contains(int anInt) { lock_guard<mutex> hold(lock); return bst_lookup(root, anInt); }
+};
+
+// Both start with the even keys below 2 * members.
+void bench_concurrent_skiplist(int members, size_t ops_per_thread)
+{
+   size_t most = thread::hardware_concurrency();
+   if (most < 4) most = 4;
+   const unsigned WRITE_PERCENTS[] = { 10, 50 };
+
+   for (size_t w = 0; w < sizeof(WRITE_PERCENTS) / sizeof(WRITE_PERCENTS[0]); ++w)
+      for (size_t threads = 1; threads <= most; threads *= 2)
+      {
+         ConcurrentSkipList shared;
+         locked_bst locked;
+         for (int k = 0; k < 2 * members; k += 2)
+         {
+            shared.add(k);
+            locked.add(k);
+         }
+
+         time_mix(shared, "concurrent ordered set", "ConcurrentSkipList", members,
+                  WRITE_PERCENTS[w], threads, ops_per_thread);
+         time_mix(locked, "concurrent ordered set", "mutex + btNode", members,
+                  WRITE_PERCENTS[w], threads, ops_per_thread);
+
+         // the skip list must still be ordered and agree with its size
+         vector<int> keys;
+         shared.snapshot(keys);
+         bool ordered = true;
+         for (size_t i = 1; i < keys.size(); ++i)
+            ordered = ordered && keys[i - 1] < keys[i];
+         if (!ordered || keys.size() != size_t(shared.size()))
+            cout << "  RESULT MISMATCH" << endl;
+      }
+}
+
+// Builds a list of lists: groups of 100 CNodes (the last may be
+// shorter), each under its own PNode, from new or from the pools.
+static PNode* build_list_of_lists(size_t items, node_pool<PNode>* p_pool,
+                                  node_pool<CNode>* c_pool)
+{
+   PNode* p_head = 0;
+   for (size_t i = 0; i < items; ++i)
+   {
+      if (i % 100 == 0)
+      {
+         PNode* p = (p_pool == 0) ? new PNode : p_pool->allocate();
+         p->data = 0;
+         p->link = p_head;
+         p_head = p;
+      }
+      CNode* c = (c_pool == 0) ? new CNode : c_pool->allocate();
+      c->data = int(i);
+      c->link = p_head->data;
+      p_head->data = c;
+   }
+   return p_head;
+}
+
+void bench_node_pool(size_t items)
+{
+   vector<int> keys;
+   shuffled_keys(items, 53, keys);
+   vector<int> in_order(items);
+   const char* SOURCES[] = { "new/delete", "node_pool" };
+
+   for (int source = 0; source < 2; ++source)
+   {
+      bool pooled = (source == 1);
+      node_pool<btNode> bt_pool;
+      node_pool<Node> list_pool;
+      node_pool<PNode> p_pool;
+      node_pool<CNode> c_pool;
+
+      btNode* root = 0;
+      string label = string("bst_insert (") + SOURCES[source] + ")";
+      Stopwatch timer = start_timer();
+      for (size_t i = 0; i < items; ++i)
+         if (pooled) bst_insert(root, keys[i], bt_pool);
+         else bst_insert(root, keys[i]);
+      print_result(stop_timer(timer, "node_pool", label.c_str(), items, items));
+
+      label = string("portToArrayInOrder (") + SOURCES[source] + ")";
+      timer = start_timer();
+      portToArrayInOrder(root, &in_order[0]);
+      print_result(stop_timer(timer, "node_pool", label.c_str(), items, items));
+
+      label = string("tree_clear (") + SOURCES[source] + ")";
+      timer = start_timer();
+      if (pooled) tree_clear(root, bt_pool);
+      else tree_clear(root);
+      print_result(stop_timer(timer, "node_pool", label.c_str(), items, items));
+
+      Node* head = 0;
+      label = string("InsertAsHead (") + SOURCES[source] + ")";
+      timer = start_timer();
+      for (size_t i = 0; i < items; ++i)
+         if (pooled) InsertAsHead(head, keys[i], list_pool);
+         else InsertAsHead(head, keys[i]);
+      print_result(stop_timer(timer, "node_pool", label.c_str(), items, items));
+
+      label = string("FindListLength (") + SOURCES[source] + ")";
+      timer = start_timer();
+      int length = FindListLength(head);
+      print_result(stop_timer(timer, "node_pool", label.c_str(), items, items));
+
+      label = string("ListClear (") + SOURCES[source] + ")";
+      timer = start_timer();
+      if (pooled) ListClear(head, list_pool, 1);
+      else ListClear(head, 1);
+      print_result(stop_timer(timer, "node_pool", label.c_str(), items, items));
+
+      label = string("build list of lists (") + SOURCES[source] + ")";
+      timer = start_timer();
+      PNode* p_head = pooled ? build_list_of_lists(items, &p_pool, &c_pool)
+                             : build_list_of_lists(items, 0, 0);
+      print_result(stop_timer(timer, "node_pool", label.c_str(), items, items));
+
+      // Destroy_* report every list they free; keep that off the
+      // results (a failed cout skips the formatting)
+      label = string("Destroy_pList (") + SOURCES[source] + ")";
+      cout.setstate(ios::badbit);
+      timer = start_timer();
+      if (pooled) CS3358_FA2023_A5P2::Destroy_pList(p_head, p_pool, c_pool);
+      else CS3358_FA2023_A5P2::Destroy_pList(p_head);
+      BenchResult destroyed = stop_timer(timer, "node_pool", label.c_str(), items, items);
+      cout.clear();
+      print_result(destroyed);
+
+      if (length != int(items) || in_order[items - 1] != int(items - 1) ||
+          root != 0 || head != 0 || p_head != 0)
+         cout << "  RESULT MISMATCH" << endl;
+   }
+}
+
+void bench_llcp(size_t items)
+{
+   unsigned long state = 47;
+   vector<int> values(items);
+   for (size_t i = 0; i < items; ++i)
+      values[i] = int(next_random(state) % 1000000);
+
+   Node* head = 0;
+   Stopwatch timer = start_timer();
+   for (size_t i = 0; i < items; ++i)
+      InsertAsHead(head, values[i]);
+   print_result(stop_timer(timer, "llcp", "InsertAsHead", items, items));
+
+   timer = start_timer();
+   int length = FindListLength(head);
+   print_result(stop_timer(timer, "llcp", "FindListLength", items, 1));
+
+   int lo = 0, hi = 0;
+   timer = start_timer();
+   FindMinMax(head, lo, hi);
+   print_result(stop_timer(timer, "llcp", "FindMinMax", items, 1));
+
+   // values[0] went in first, so it is found at the tail
+   timer = start_timer();
+   bool deleted = DelFirstTargetNode(head, values[0]);
+   print_result(stop_timer(timer, "llcp", "DelFirstTargetNode (tail)", items, 1));
+
+   timer = start_timer();
+   ListClear(head, 1);
+   print_result(stop_timer(timer, "llcp", "ListClear", items - 1, 1));
+
+   if (items <= QUADRATIC_MAX)
+   {
+      timer = start_timer();
+      for (size_t i = 0; i < items; ++i)
+         InsertAsTail(head, values[i]);
+      print_result(stop_timer(timer, "llcp", "InsertAsTail", items, items));
+      ListClear(head, 1);
+
+      timer = start_timer();
+      for (size_t i = 0; i < items; ++i)
+         InsertSortedUp(head, values[i]);
+      print_result(stop_timer(timer, "llcp", "InsertSortedUp (random)", items, items));
+      if (!IsSortedUp(head))
+         cout << "  RESULT MISMATCH" << endl;
+      ListClear(head, 1);
+   }
+
+   if (length != int(items) || !deleted)
+      cout << "  RESULT MISMATCH" << endl;
+}
@@ -0,0 +1,212 @@
+// FILE: dynSequence.h (See namespace CS3358_FA2023_A04_sequence)
+//
+// TEMP CLASS PROVIDED: dyn_sequence<Item, N>
+// CLASS PROVIDED: dyn_sequence<Item, N> (a container class for a list of
+//                 items, where each list may have a designated item
+//                 called the current item; same cursor interface as
+//                 sequence<Item> in sequence.h, but with no fixed
+//                 CAPACITY)
+//
+// STORAGE:
+//   The first N items are kept inside the object itself (no dynamic
+//   memory at all for small sequences); once more room is needed the
+//   items move to a dynamic array that doubles as it fills up. Copies
+//   and moves only ever touch the size() items actually in use, never
+//   the unused slots.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the dyn_sequence class:
+//   typedef ____ dyn_sequence<Item, N>::value_type
+//     dyn_sequence::value_type is the data type of the items in the
+//     sequence. It may be any of the C++ built-in types (int, char,
+//     etc.), or a class with a copy constructor and an assignment
+//     operator (a default constructor is NOT needed).
+//   typedef ____ dyn_sequence<Item, N>::size_type
+//     dyn_sequence::size_type is the data type of any variable that
+//     keeps track of how many items are in a sequence.
+//   static const size_type INLINE_CAPACITY = N
+//     dyn_sequence::INLINE_CAPACITY is the number of items a sequence
+//     can hold without allocating dynamic memory (N defaults to 10,
+//     the CAPACITY of sequence<Item>). N must be at least 1.
+//
+// CONSTRUCTOR for the dyn_sequence class:
+//   dyn_sequence()
+//     Pre:  (none)
+//     Post: The sequence has been initialized as an empty sequence.
+//
+// MODIFICATION MEMBER FUNCTIONS for the dyn_sequence class:
+//   void start()
+//     Pre:  (none)
+//     Post: The first item on the sequence becomes the current item
+//           (but if the sequence is empty, then there is no current item).
+//   void end()
+//     Pre:  (none)
+//     Post: The last item on the sequence becomes the current item
+//           (but if the sequence is empty, then there is no current item).
+//   void advance()
+//     Pre:  is_item() returns true.
+//     Post: If the current item was the last item in the sequence, then
+//           there is no longer any current item. Otherwise, the new current
+//           item is the item immediately after the original current item.
+//   void move_back()
+//     Pre:  is_item() returns true.
+//     Post: If the current item was the first item in the sequence, then
+//           there is no longer any current item. Otherwise, the new current
+//           item is the item immediately before the original current item.
+//   void add(const value_type& entry)
+//     Pre:  (none)
+//     Post: A new copy of entry has been inserted in the sequence after
+//           the current item. If there was no current item, then the new
+//           entry has been inserted as new first item of the sequence. In
+//           either case, the newly added item is now the current item of
+//           the sequence.
+//   void remove_current()
+//     Pre:  is_item() returns true.
+//     Post: The current item has been removed from the sequence, and
+//           the item after this (if there is one) is now the new current
+//           item. If the current item was already the last item in the
+//           sequence, then there is no longer any current item.
+//   void reserve(size_type new_capacity)
+//     Pre:  (none)
+//     Post: capacity() >= new_capacity; items and the current item are
+//           unchanged.
+//
+// CONSTANT MEMBER FUNCTIONS for the dyn_sequence class:
+//   size_type size() const
+//     Pre:  (none)
+//     Post: The return value is the number of items in the sequence.
+//   size_type capacity() const
+//     Pre:  (none)
+//     Post: The return value is the number of items the sequence can
+//           hold before it has to allocate (again).
+//   bool is_item() const
+//     Pre:  (none)
+//     Post: A true return value indicates that there is a valid
+//           "current" item that may be retrieved by activating the current
+//           member function (listed below). A false return value indicates
+//           that there is no valid current item.
+//   const value_type& current() const
+//   value_type& current()
+//     Pre:  is_item() returns true.
+//     Post: A reference to the current item in the sequence has been
+//           returned (no copy is made). The reference is invalidated by
+//           add, remove_current and reserve.
+//   item_range<iterator> items()
+//   item_range<const_iterator> items() const
+//     Pre:  (none)
+//     Post: The return value spans the items, first to last, as
+//           contiguous random-access iterators (see itemRange.h), for
+//           range-for and the standard algorithms. The cursor is not
+//           used or changed. The range is invalidated by add,
+//           remove_current and reserve.
+//   bool find(const value_type& target)
+//     Pre:  (none)
+//     Post: If target is in the sequence, its first occurrence has
+//           become the current item and true has been returned.
+//           Otherwise false has been returned and the cursor is
+//           unchanged.
+//   template <class Pred> size_type count_if(Pred pred) const
+//     Pre:  pred(item) can be called from several threads at once.
+//     Post: The number of items for which pred returns true has been
+//           returned.
+//   bool min_max(value_type& min_value, value_type& max_value) const
+//     Pre:  (none)
+//     Post: For an empty sequence false has been returned. Otherwise
+//           true has been returned and min_value/max_value hold the
+//           smallest and largest item.
+//   value_type sum() const
+//     Pre:  value_type supports + (and value_type() is its zero).
+//     Post: The sum of all items has been returned.
+//   (These four scan the items directly with the SIMD and multi-thread
+//   kernels in seqAlgo.h instead of walking the cursor.)
+//
+// VALUE SEMANTICS for the dyn_sequence class:
+//    Assignments and the copy constructor may be used with dyn_sequence
+//    objects. Move construction and move assignment take over the
+//    source's dynamic array (or move its inline items) and leave the
+//    source empty.
+//
+// DYNAMIC MEMORY USAGE by the dyn_sequence class:
+//   If there is insufficient dynamic memory, the following functions
+//   throw bad_alloc: the copy constructor, add, reserve, and the
+//   copy assignment operator.
+
+#ifndef DYN_SEQUENCE_H
+#define DYN_SEQUENCE_H
+
+#include <cstdlib>      // provides size_t
+#include <type_traits>  // provides aligned_storage
+#include "itemRange.h"
+#include "seqAlgo.h"
+
+namespace CS3358_FA2023_A04_sequence
+{
+   template <class Item, std::size_t N = 10>
+   class dyn_sequence
+   {
+      static_assert(N > 0, "dyn_sequence needs an inline capacity N of at least 1");
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef Item value_type;
+      typedef std::size_t size_type;
+      static const size_type INLINE_CAPACITY = N;
+      typedef Item* iterator;
+      typedef const Item* const_iterator;
+      // CONSTRUCTORS and DESTRUCTOR
+      dyn_sequence();
+      dyn_sequence(const dyn_sequence& source);
+      dyn_sequence(dyn_sequence&& source);
+      ~dyn_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void start();
+      void end();
+      void advance();
+      void move_back();
+      void add(const Item& entry);
+      void remove_current();
+      void reserve(size_type new_capacity);
+      dyn_sequence& operator=(const dyn_sequence& source);
+      dyn_sequence& operator=(dyn_sequence&& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      size_type capacity() const;
+      bool is_item() const;
+      const Item& current() const;
+      Item& current();
+      item_range<iterator> items()
+         { return item_range<iterator>(data, data + used); }
+      item_range<const_iterator> items() const
+         { return item_range<const_iterator>(data, data + used); }
+      bool find(const Item& target)
+      {
+         const Item* hit = CS3358_FA2023::seq_find<Item>(data, data + used, target);
+         if (hit == data + used) return false;
+         current_index = size_type(hit - data);
+         return true;
+      }
+      template <class Pred>
+      size_type count_if(Pred pred) const
+         { return CS3358_FA2023::seq_count_if<Item>(data, data + used, pred); }
+      bool min_max(Item& min_value, Item& max_value) const
+         { return CS3358_FA2023::seq_min_max<Item>(data, data + used, min_value, max_value); }
+      Item sum() const
+         { return CS3358_FA2023::seq_sum<Item>(data, data + used); }
+
+   private:
+      typedef typename std::aligned_storage<sizeof(Item), alignof(Item)>::type slot;
+
+      Item* data;               // local_items() or a dynamic array
+      size_type used;
+      size_type current_index;
+      size_type cap;
+      slot local[N];            // raw room for the first N items
+
+      Item* local_items();
+      bool is_local() const;
+      void destroy_items();
+      void release_array();
+      void take_items(dyn_sequence& source);
+   };
+}
+
+#include "dynSequence.template"
+#endif
@@ -0,0 +1,247 @@
+// FILE: epoch.cpp
+// IMPLEMENTS: epoch_guard, epoch_retire, epoch_collect and epoch_pending
+//             (see epoch.h for documentation)
+// INVARIANT for the epoch module:
+//   1. global_epoch only grows. It is moved from e to e + 1 only when
+//      every pinned participant's state records epoch e.
+//   2. A participant's state is 0 while its thread is not pinned and
+//      (e << 1) | 1 while it is pinned at epoch e.
+//   3. Every retired object sits, with the epoch read when it was
+//      retired, in exactly one limbo list (its thread's, or orphans
+//      once that thread has exited) until it is destroyed; pending
+//      counts them. An object retired at epoch r is destroyed only once
+//      global_epoch >= r + 2.
+//   4. The participant table is first_block followed by the blocks
+//      linked from it through next. Blocks are only ever appended (a
+//      new block is published with one compare-and-swap on the last
+//      next), never unlinked or freed, so a scan may walk the chain
+//      without a lock.
+
+#include "epoch.h"
+#include <atomic>     // provides atomic, atomic_thread_fence
+#include <cstdlib>    // provides malloc, free
+#include <memory>     // provides align
+#include <mutex>      // provides mutex, lock_guard
+#include <new>        // provides bad_alloc, placement new
+#include <vector>     // provides vector
+
+namespace CS3358_FA2023
+{
+   namespace
+   {
+      // A collection is tried after this many retirements on a thread.
+      const std::size_t RETIRE_BATCH = 64;
+
+      // Participant slots are added this many at a time.
+      const std::size_t BLOCK_SLOTS = 256;
+
+      // One per thread that has pinned; padded to its own cache line so
+      // that pinning doesn't slow down the other threads.
+      struct alignas(64) participant
+      {
+         std::atomic<unsigned long> state;
+         std::atomic<bool> taken;
+      };
+
+      struct retired_object
+      {
+         void* p;
+         void (*destroy)(void*);
+         unsigned long epoch;
+      };
+
+      struct participant_block
+      {
+         participant slots[BLOCK_SLOTS];
+         std::atomic<participant_block*> next;
+         void* memory;   // what new_block got from malloc (0 for first_block)
+      };
+
+      participant_block first_block;
+
+      // A block with every slot free, aligned for its participants (a
+      // plain new does not honor alignas(64) before C++17).
+      participant_block* new_block()
+      {
+         std::size_t room = sizeof(participant_block) + alignof(participant_block);
+         void* memory = std::malloc(room);
+         if (memory == 0) throw std::bad_alloc();
+         void* place = memory;
+         std::align(alignof(participant_block), sizeof(participant_block), place, room);
+         participant_block* block = new (place) participant_block();
+         block->memory = memory;
+         return block;
+      }
+
+      void delete_block(participant_block* block)
+      {
+         void* memory = block->memory;
+         block->~participant_block();
+         std::free(memory);
+      }
+      std::atomic<unsigned long> global_epoch(1);
+      std::atomic<std::size_t> pending(0);
+
+      // Frees whatever was retired at least two epochs before now.
+      void free_safe(std::vector<retired_object>& limbo, unsigned long now)
+      {
+         std::size_t kept = 0;
+         for (std::size_t i = 0; i < limbo.size(); ++i)
+         {
+            if (limbo[i].epoch + 2 <= now)
+            {
+               limbo[i].destroy(limbo[i].p);
+               pending.fetch_sub(1, std::memory_order_relaxed);
+            }
+            else
+               limbo[kept++] = limbo[i];
+         }
+         limbo.resize(kept);
+      }
+
+      // What exited threads left behind; freed at exit if still there.
+      struct orphan_list
+      {
+         std::mutex lock;
+         std::vector<retired_object> objects;
+
+         ~orphan_list()
+         {
+            free_safe(objects, ~0UL);
+         }
+      };
+
+      orphan_list& orphans()
+      {
+         static orphan_list list;
+         return list;
+      }
+
+      struct thread_record
+      {
+         participant* slot;
+         int depth;
+         std::size_t since_collect;
+         std::vector<retired_object> limbo;
+
+         thread_record() : slot(0), depth(0), since_collect(0) {}
+
+         ~thread_record()
+         {
+            if (!limbo.empty())
+            {
+               orphan_list& list = orphans();
+               std::lock_guard<std::mutex> hold(list.lock);
+               list.objects.insert(list.objects.end(), limbo.begin(), limbo.end());
+            }
+            if (slot != 0)
+            {
+               slot->state.store(0, std::memory_order_release);
+               slot->taken.store(false, std::memory_order_release);
+            }
+         }
+      };
+
+      thread_local thread_record me;
+
+      // Takes a free slot, appending a block to the table if there is
+      // none (the new block's first slot is taken before it is
+      // published). If another thread appends first, the walk goes on
+      // into its block and this one is thrown away.
+      participant* claim_slot()
+      {
+         participant_block* block = &first_block;
+         for (;;)
+         {
+            for (std::size_t i = 0; i < BLOCK_SLOTS; ++i)
+            {
+               participant& p = block->slots[i];
+               bool expected = false;
+               if (!p.taken.load(std::memory_order_relaxed) &&
+                   p.taken.compare_exchange_strong(expected, true))
+                  return &p;
+            }
+            participant_block* next = block->next.load(std::memory_order_acquire);
+            if (next == 0)
+            {
+               participant_block* fresh = new_block();
+               fresh->slots[0].taken.store(true, std::memory_order_relaxed);
+               if (block->next.compare_exchange_strong(next, fresh,
+                                                       std::memory_order_acq_rel))
+                  return &fresh->slots[0];
+               delete_block(fresh);
+            }
+            block = next;
+         }
+      }
+
+      // Moves the epoch on by one if every pinned thread has seen it.
+      bool try_advance()
+      {
+         std::atomic_thread_fence(std::memory_order_seq_cst);
+         unsigned long now = global_epoch.load(std::memory_order_seq_cst);
+         for (participant_block* block = &first_block; block != 0;
+              block = block->next.load(std::memory_order_acquire))
+            for (std::size_t i = 0; i < BLOCK_SLOTS; ++i)
+            {
+               unsigned long s = block->slots[i].state.load(std::memory_order_seq_cst);
+               if ((s & 1) != 0 && (s >> 1) != now)
+                  return false;
+            }
+         return global_epoch.compare_exchange_strong(now, now + 1);
+      }
+   }
+
+   epoch_guard::epoch_guard()
+   {
+      if (me.depth > 0)
+      {
+         ++me.depth;
+         return;
+      }
+      if (me.slot == 0) me.slot = claim_slot();
+      me.depth = 1;
+
+      unsigned long now = global_epoch.load(std::memory_order_seq_cst);
+      me.slot->state.store((now << 1) | 1, std::memory_order_relaxed);
+      // the pin must be visible before any pointer is read under it
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+   }
+
+   epoch_guard::~epoch_guard()
+   {
+      if (--me.depth > 0) return;
+      me.slot->state.store(0, std::memory_order_release);
+   }
+
+   void epoch_retire(void* p, void (*destroy)(void*))
+   {
+      // the unlink of p must be ordered before the epoch is read
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      retired_object r = { p, destroy, global_epoch.load(std::memory_order_seq_cst) };
+      me.limbo.push_back(r);
+      pending.fetch_add(1, std::memory_order_relaxed);
+
+      if (++me.since_collect >= RETIRE_BATCH)
+         epoch_collect();
+   }
+
+   // Two advances are what an object needs, so try for both.
+   void epoch_collect()
+   {
+      me.since_collect = 0;
+      if (try_advance()) try_advance();
+      unsigned long now = global_epoch.load(std::memory_order_seq_cst);
+
+      free_safe(me.limbo, now);
+
+      orphan_list& list = orphans();
+      std::lock_guard<std::mutex> hold(list.lock);
+      free_safe(list.objects, now);
+   }
+
+   std::size_t epoch_pending()
+   {
+      return pending.load(std::memory_order_relaxed);
+   }
+}
@@ -0,0 +1,105 @@
+// FILE: epoch.h
+// FUNCTIONS AND CLASS PROVIDED: epoch-based reclamation (EBR) for the
+//   lock-free containers in this directory (ConcurrentIntSet, and any
+//   other structure whose readers follow pointers without a lock).
+//
+// THE PROBLEM:
+//   A lock-free reader may still be looking at a node or table that a
+//   writer has just unlinked, so the writer can't delete it right away.
+//   EBR defers the delete until every reader that could have seen the
+//   object has finished.
+//
+// HOW IT WORKS:
+//   There is one global epoch number. A reader pins itself (with an
+//   epoch_guard) for the length of one operation, recording the epoch
+//   it saw. An unlinked object is retired with the epoch current at
+//   that time. The global epoch only moves on once every pinned thread
+//   has caught up with it, so when it is two past an object's retire
+//   epoch, no pinned thread can still hold a pointer to the object and
+//   it is deleted. Retired objects wait in a per-thread list, and
+//   collection is attempted every RETIRE_BATCH retirements, so the
+//   common paths take no lock.
+//
+//   Pinning is two atomic stores (no read-modify-write, no lock), so
+//   readers stay lock-free. A thread that stays pinned forever blocks
+//   all reclamation (memory grows, nothing breaks).
+//
+// CLASS PROVIDED: epoch_guard
+//   epoch_guard()
+//     Pre:  (none)
+//     Post: The calling thread is pinned until the guard is destroyed.
+//           Guards may nest; only the outermost one pins and unpins.
+//           The first guard on a thread throws bad_alloc if the
+//           participant table has to grow and there is no memory (the
+//           thread is then not pinned).
+//   ~epoch_guard()
+//     Post: If this was the outermost guard, the thread is unpinned.
+//   Guards can't be copied, and must be destroyed on the thread that
+//   made them.
+//
+// FUNCTIONS PROVIDED:
+//   void epoch_retire(void* p, void (*destroy)(void*))
+//     Pre:  p has been unlinked, so no thread that pins from now on can
+//           reach it; it has not been retired before.
+//     Post: destroy(p) will be called once no pinned thread can be
+//           using p (possibly right away, possibly on a later call).
+//   template <class T> void epoch_retire(T* p)
+//     Post: As above, with delete p as destroy.
+//   void epoch_collect()
+//     Pre:  (none)
+//     Post: The epoch has been advanced if possible, and everything
+//           this thread (or an exited thread) retired that is now safe
+//           has been destroyed. Structures that retire big objects
+//           rarely (a resized table) call this right after retiring
+//           rather than wait for the next RETIRE_BATCH.
+//   std::size_t epoch_pending()
+//     Post: The number of objects retired but not yet destroyed (on
+//           any thread) has been returned.
+//
+//   When a thread exits, whatever it retired is handed to a shared
+//   list that later epoch_collect() calls (from any thread) free;
+//   anything still left at program exit is freed then.
+//   Any number of threads may use epoch_guard. A thread takes a slot in
+//   the participant table the first time it pins and gives it back when
+//   it exits; the table grows a block of slots at a time when all are
+//   taken (never shrinking), so a scan for an epoch advance costs one
+//   check per slot ever needed at once.
+
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <cstdlib>   // provides size_t
+
+namespace CS3358_FA2023
+{
+   class epoch_guard
+   {
+   public:
+      epoch_guard();
+      ~epoch_guard();
+   private:
+      epoch_guard(const epoch_guard&) = delete;
+      epoch_guard& operator=(const epoch_guard&) = delete;
+   };
+
+   void epoch_retire(void* p, void (*destroy)(void*));
+   void epoch_collect();
+   std::size_t epoch_pending();
+
+   namespace epoch_detail
+   {
+      template <class T>
+      void delete_object(void* p)
+      {
+         delete static_cast<T*>(p);
+      }
+   }
+
+   template <class T>
+   void epoch_retire(T* p)
+   {
+      epoch_retire(static_cast<void*>(p), &epoch_detail::delete_object<T>);
+   }
+}
+
+#endif
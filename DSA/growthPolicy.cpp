@@ -0,0 +1,176 @@
+// FILE: growthPolicy.cpp
+// CLASSES IMPLEMENTED: growth_policy, geometric_growth, page_growth,
+//                      huge_page_arena (see growthPolicy.h)
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include "growthPolicy.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>   // provides mmap, munmap, madvise
+#define DSA_HAVE_MMAP 1
+#endif
+
+using namespace std;
+
+namespace CS3358_FA2023
+{
+   // Rounds n up to the next multiple of unit (unit > 0).
+   static size_t round_up(size_t n, size_t unit)
+   {
+      return ((n + unit - 1) / unit) * unit;
+   }
+
+   // === growth_policy ===
+
+   void* growth_policy::allocate(size_t bytes)
+   {
+      return ::operator new(bytes);
+   }
+
+   void growth_policy::deallocate(void* p, size_t)
+   {
+      ::operator delete(p);
+   }
+
+   // === geometric_growth ===
+
+   geometric_growth::geometric_growth(double factor, size_t extra)
+      : factor(factor), extra(extra)
+   {
+      assert(factor >= 1.0);
+   }
+
+   size_t geometric_growth::next_capacity(size_t capacity, size_t needed, size_t) const
+   {
+      size_t grown = size_t(factor * capacity) + extra;
+      return (grown < needed) ? needed : grown;
+   }
+
+   // === page_growth ===
+
+   page_growth::page_growth(double factor, size_t page_bytes)
+      : factor(factor), page_bytes(page_bytes)
+   {
+      assert(factor >= 1.0);
+      assert(page_bytes > 0);
+   }
+
+   // Geometric first, then fill out the last page.
+   size_t page_growth::next_capacity(size_t capacity, size_t needed, size_t item_size) const
+   {
+      size_t grown = size_t(factor * capacity) + 1;
+      if (grown < needed) grown = needed;
+      if (item_size == 0) return grown;
+      return round_up(grown * item_size, page_bytes) / item_size;
+   }
+
+   void* page_growth::allocate(size_t bytes)
+   {
+#ifdef DSA_HAVE_MMAP
+      void* p = 0;
+      if (posix_memalign(&p, page_bytes, round_up(bytes == 0 ? 1 : bytes, page_bytes)) != 0)
+         throw bad_alloc();
+      return p;
+#else
+      return ::operator new(bytes);
+#endif
+   }
+
+   void page_growth::deallocate(void* p, size_t)
+   {
+#ifdef DSA_HAVE_MMAP
+      free(p);
+#else
+      ::operator delete(p);
+#endif
+   }
+
+   // === huge_page_arena ===
+
+   huge_page_arena::huge_page_arena(size_t chunk_bytes)
+      : top(0), bump(0), limit(0), chunk_bytes(chunk_bytes), mapped(0)
+   {
+      assert(chunk_bytes > sizeof(chunk));
+   }
+
+   huge_page_arena::~huge_page_arena()
+   {
+      while (top != 0)
+      {
+         chunk* prev = top->prev;
+#ifdef DSA_HAVE_MMAP
+         munmap(top, top->length);
+#else
+         ::operator delete(top);
+#endif
+         top = prev;
+      }
+   }
+
+   // Double, and once an array is at least a chunk big, keep it a
+   // whole number of chunks so no huge page is left half used.
+   size_t huge_page_arena::next_capacity(size_t capacity, size_t needed, size_t item_size) const
+   {
+      size_t grown = 2 * capacity + 1;
+      if (grown < needed) grown = needed;
+      if (item_size == 0 || grown * item_size < chunk_bytes) return grown;
+      return round_up(grown * item_size, chunk_bytes) / item_size;
+   }
+
+   // Bump allocate from the newest chunk; map a new one when it's full.
+   void* huge_page_arena::allocate(size_t bytes)
+   {
+      const size_t ALIGN = 64;    // cache line; also enough for any item
+      bytes = round_up(bytes == 0 ? 1 : bytes, ALIGN);
+
+      if (top == 0 || size_t(limit - bump) < bytes)
+      {
+         size_t header = round_up(sizeof(chunk), ALIGN);
+         size_t length = round_up(header + bytes, chunk_bytes);
+#ifdef DSA_HAVE_MMAP
+         void* p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+         p = mmap(0, length, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+         if (p == MAP_FAILED)
+         {
+            // no reserved huge pages: regular pages, but ask for THP
+            p = mmap(0, length, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED)
+               throw bad_alloc();
+#ifdef MADV_HUGEPAGE
+            madvise(p, length, MADV_HUGEPAGE);
+#endif
+         }
+#else
+         void* p = ::operator new(length);
+#endif
+         chunk* c = static_cast<chunk*>(p);
+         c->prev = top;
+         c->length = length;
+         top = c;
+         bump = static_cast<char*>(p) + header;
+         limit = static_cast<char*>(p) + length;
+         mapped += length;
+      }
+
+      void* result = bump;
+      bump += bytes;
+      return result;
+   }
+
+   // Only the most recent array can be handed back (the arena rewinds);
+   // everything else stays mapped until the arena is destroyed.
+   void huge_page_arena::deallocate(void* p, size_t bytes)
+   {
+      const size_t ALIGN = 64;
+      if (p == 0) return;
+      bytes = round_up(bytes == 0 ? 1 : bytes, ALIGN);
+      if (static_cast<char*>(p) + bytes == bump)
+         bump = static_cast<char*>(p);
+   }
+}
@@ -0,0 +1,163 @@
+// FILE: growthPolicy.h
+// CLASSES PROVIDED: growth_policy (abstract), geometric_growth,
+//                   page_growth, huge_page_arena, growth_stats
+//
+// The array-based containers (sequence, IntSet, p_queue) used to hard-
+// code how much to grow by and always went to new[]/delete[]. A
+// growth_policy bundles both decisions so a caller can hand the same
+// policy to any of them:
+//   - how big the array becomes when it runs out of room, and
+//   - where the bytes for the array come from.
+// A container never owns its policy; the policy must outlive every
+// container (and every array) that uses it.
+//
+// MEMBER FUNCTIONS for the growth_policy class:
+//   virtual size_t next_capacity(size_t capacity, size_t needed,
+//                                size_t item_size) const = 0
+//     Pre:  needed > capacity.
+//     Post: The return value is the capacity (in items) a full array of
+//           capacity items of item_size bytes each should grow to; it
+//           is always >= needed.
+//   virtual void* allocate(size_t bytes)
+//     Post: The return value points to bytes (uninitialized) bytes
+//           suitably aligned for any item type. The default uses
+//           ::operator new (throws bad_alloc on failure).
+//   virtual void deallocate(void* p, size_t bytes)
+//     Pre:  p came from allocate(bytes) of this same policy (or is 0).
+//     Post: The memory has been returned to the policy.
+//
+// POLICIES PROVIDED:
+//   geometric_growth(double factor, size_t extra)
+//     new capacity = factor * capacity + extra. The containers' old
+//     hard-coded behaviour is geometric_growth(1.5, 1) for sequence and
+//     IntSet and geometric_growth(1.25, 1) for p_queue.
+//   page_growth(double factor = 1.5, size_t page_bytes = 4096)
+//     Grows geometrically, then rounds the array up to a whole number
+//     of pages and hands out page-aligned memory, so repeated growth
+//     reuses whole pages instead of leaving odd-sized holes.
+//   huge_page_arena(size_t chunk_bytes = 2 MiB)
+//     Doubles on growth and carves arrays out of large chunks mapped
+//     with huge pages where the OS allows it (falling back to regular
+//     pages). Memory is only given back when the arena is destroyed
+//     (except that freeing the most recent array rewinds the arena),
+//     so it suits containers that are built once and then read.
+//
+// growth_stats
+//   Per-container counters: reallocations (number of times the array
+//   was replaced after the initial allocation) and peak_capacity
+//   (largest capacity, in items, ever allocated).
+//
+// HELPER TEMPLATES:
+//   Item* allocate_items<Item>(growth_policy& policy, size_t n)
+//     Post: An array of n default-constructed Items obtained from
+//           policy has been returned (the new[] equivalent).
+//   void deallocate_items(growth_policy& policy, Item* items, size_t n)
+//     Pre:  items came from allocate_items(policy, n) (or is 0).
+//     Post: The Items have been destroyed and the memory returned to
+//           policy (the delete[] equivalent).
+
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+#include <cstdlib>  // provides size_t
+#include <new>      // provides placement new
+
+namespace CS3358_FA2023
+{
+   class growth_policy
+   {
+   public:
+      virtual ~growth_policy() {}
+      virtual size_t next_capacity(size_t capacity, size_t needed,
+                                   size_t item_size) const = 0;
+      virtual void* allocate(size_t bytes);
+      virtual void deallocate(void* p, size_t bytes);
+   };
+
+   class geometric_growth : public growth_policy
+   {
+   public:
+      geometric_growth(double factor = 1.5, size_t extra = 1);
+      size_t next_capacity(size_t capacity, size_t needed,
+                           size_t item_size) const;
+   private:
+      double factor;
+      size_t extra;
+   };
+
+   class page_growth : public growth_policy
+   {
+   public:
+      page_growth(double factor = 1.5, size_t page_bytes = 4096);
+      size_t next_capacity(size_t capacity, size_t needed,
+                           size_t item_size) const;
+      void* allocate(size_t bytes);
+      void deallocate(void* p, size_t bytes);
+   private:
+      double factor;
+      size_t page_bytes;
+   };
+
+   class huge_page_arena : public growth_policy
+   {
+   public:
+      static const size_t HUGE_PAGE_BYTES = 2 * 1024 * 1024;
+      huge_page_arena(size_t chunk_bytes = HUGE_PAGE_BYTES);
+      ~huge_page_arena();
+      size_t next_capacity(size_t capacity, size_t needed,
+                           size_t item_size) const;
+      void* allocate(size_t bytes);
+      void deallocate(void* p, size_t bytes);
+      size_t bytes_mapped() const { return mapped; }
+   private:
+      struct chunk
+      {
+         chunk* prev;
+         size_t length;
+      };
+      chunk* top;        // most recently mapped chunk (list via prev)
+      char* bump;        // next free byte in top
+      char* limit;       // one past the last byte of top
+      size_t chunk_bytes;
+      size_t mapped;
+      // not copyable: the arena owns its chunks
+      huge_page_arena(const huge_page_arena&);
+      huge_page_arena& operator=(const huge_page_arena&);
+   };
+
+   struct growth_stats
+   {
+      size_t reallocations;
+      size_t peak_capacity;
+      growth_stats() : reallocations(0), peak_capacity(0) {}
+      void record_allocation(size_t capacity)
+      {
+         if (capacity > peak_capacity) peak_capacity = capacity;
+      }
+      void record_reallocation(size_t capacity)
+      {
+         ++reallocations;
+         record_allocation(capacity);
+      }
+   };
+
+   template <class Item>
+   Item* allocate_items(growth_policy& policy, size_t n)
+   {
+      Item* items = static_cast<Item*>(policy.allocate(n * sizeof(Item)));
+      for (size_t i = 0; i < n; ++i)
+         new (items + i) Item;
+      return items;
+   }
+
+   template <class Item>
+   void deallocate_items(growth_policy& policy, Item* items, size_t n)
+   {
+      if (items == 0) return;
+      for (size_t i = 0; i < n; ++i)
+         items[i].~Item();
+      policy.deallocate(items, n * sizeof(Item));
+   }
+}
+
+#endif
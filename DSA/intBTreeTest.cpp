@@ -0,0 +1,214 @@
+// FILE: intBTreeTest.cpp
+// A non-interactive model check of IntBTree: random insert and remove
+// runs are applied both to a tree and to a std::set, and the tree must
+// answer size, contains, lower_bound and toArray exactly as the set
+// does. The runs grow trees to three and four levels and shrink them
+// again, so leaves and inner nodes split on insert and fall below
+// LEAF_MAX / 2 keys and INNER_MAX / 2 children on remove, borrowing
+// from or merging with a neighbour; trees made by build_from_sorted
+// (and by copying) are put through the same runs. The tree's height and
+// bytes_used must stay within what half-full nodes allow. It prints one
+// line per check and returns EXIT_FAILURE if any fails.
+
+#include <cstdlib>     // provides EXIT_SUCCESS, EXIT_FAILURE, rand, srand, size_t
+#include <iostream>    // provides cout
+#include <set>         // provides set
+#include <vector>      // provides vector
+#include "IntBTree.h"
+
+using namespace std;
+
+// PROTOTYPES for functions used by this test program:
+
+bool same_as_model(const IntBTree& tree, const set<int>& model, int range);
+// Pre:  Every key of model is in [0, range).
+// Post: true has been returned if tree has the size and keys (through
+//       toArray, contains and lower_bound over [-1, range]) of model,
+//       and its height and bytes_used are possible for a B+ tree of
+//       that many keys whose nodes (but the root) are at least half
+//       full.
+bool model_check();
+// Pre:  (none)
+// Post: Trees have been put through random insert and remove runs
+//       alongside a std::set, filled past 10^4 keys and emptied again;
+//       true has been returned if every result and every check with
+//       same_as_model passed.
+bool build_check();
+// Pre:  (none)
+// Post: Trees of 0 to 10^5 keys have been made by build_from_sorted
+//       (at sizes around a leaf and an inner node boundary), copied,
+//       assigned and then put through random insert and remove runs;
+//       true has been returned if every check with same_as_model
+//       passed.
+
+const int LEAF_MIN = IntBTree::LEAF_MAX / 2;
+const int INNER_MIN = IntBTree::INNER_MAX / 2;
+
+int main()
+{
+   bool ok = true;
+   bool passed;
+
+   passed = model_check();
+   cout << "model check against std::set: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   passed = build_check();
+   cout << "build_from_sorted and copies against std::set: "
+        << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// The fewest keys a tree of the given height can hold: a leaf root
+// holds 1, an inner root 2 children, every other inner node INNER_MIN
+// children and every other leaf LEAF_MIN keys.
+long least_keys(int height)
+{
+   if (height <= 1) return height;
+   long keys = 2L * LEAF_MIN;
+   for (int level = 2; level < height; ++level)
+      keys *= INNER_MIN;
+   return keys;
+}
+
+bool same_as_model(const IntBTree& tree, const set<int>& model, int range)
+{
+   int n = int(model.size());
+   if (tree.size() != n) return false;
+
+   vector<int> keys(n + 1);   // + 1 so &keys[0] is valid when n is 0
+   tree.toArray(&keys[0]);
+   int i = 0;
+   for (set<int>::const_iterator it = model.begin(); it != model.end(); ++it)
+      if (keys[i++] != *it) return false;
+
+   for (int key = -1; key <= range; ++key)
+   {
+      if (tree.contains(key) != (model.count(key) == 1)) return false;
+      set<int>::const_iterator it = model.lower_bound(key);
+      int found = -7;
+      if (tree.lower_bound(key, found) != (it != model.end())) return false;
+      if (it != model.end() && found != *it) return false;
+      if (it == model.end() && found != -7) return false;
+   }
+
+   // every non-root leaf holds at least LEAF_MIN keys and every inner
+   // node at least 2 children, so there are at most n / LEAF_MIN leaves
+   // and fewer inner nodes than leaves
+   size_t most_leaves = (n / LEAF_MIN > 1) ? size_t(n / LEAF_MIN) : 1;
+   size_t least_leaves = size_t(n + IntBTree::LEAF_MAX - 1) / IntBTree::LEAF_MAX;
+   size_t bytes = tree.bytes_used();
+   int height = tree.height();
+   return n >= least_keys(height) && (n == 0) == (height == 0) &&
+          bytes >= sizeof(IntBTree) + least_leaves * sizeof(IntBTree::leaf_node) &&
+          bytes <= sizeof(IntBTree) + most_leaves * (sizeof(IntBTree::leaf_node) +
+                                                     sizeof(IntBTree::inner_node));
+}
+
+// Applies ops random inserts and removes of keys in [0, range) to tree
+// and model, inserting with probability insert_percent / 100; false if
+// some result differs from the model's.
+bool random_run(IntBTree& tree, set<int>& model, int ops, int range, int insert_percent)
+{
+   for (int i = 0; i < ops; ++i)
+   {
+      int key = rand() % range;
+      if (rand() % 100 < insert_percent)
+      {
+         if (tree.insert(key) != model.insert(key).second) return false;
+      }
+      else if (tree.remove(key) != (model.erase(key) == 1))
+         return false;
+   }
+   return true;
+}
+
+bool model_check()
+{
+   srand(18);
+   for (int round = 0; round < 40; ++round)
+   {
+      IntBTree tree;
+      set<int> model;
+      // up to 5 * 10^4 keys: three levels, some rounds four
+      int range = (round % 4 == 0) ? 1 + rand() % 300 : 2000 + rand() % 50000;
+      int run = 1 + range / 8;
+
+      // fill, churn near the top, drain, churn near empty, refill, drain
+      int percents[] = { 90, 50, 10, 50, 80, 0 };
+      for (int phase = 0; phase < 6; ++phase)
+      {
+         int ops = (phase == 5) ? 4 * range : run;
+         for (int done = 0; done < ops; done += run)
+         {
+            if (!random_run(tree, model, run, range, percents[phase]) ||
+                !same_as_model(tree, model, range))
+               return false;
+         }
+      }
+
+      // then remove what is left in order, from the low end
+      while (!model.empty())
+      {
+         if (!tree.remove(*model.begin())) return false;
+         model.erase(model.begin());
+         if (model.size() % 997 == 0 && !same_as_model(tree, model, range))
+            return false;
+      }
+      if (!same_as_model(tree, model, range) || tree.remove(0)) return false;
+   }
+   return true;
+}
+
+bool build_check()
+{
+   srand(19);
+   const int LEAF_MAX = IntBTree::LEAF_MAX;
+   const int BRANCH = LEAF_MAX * IntBTree::INNER_MAX;
+   int sizes[] = { 0, 1, 2, LEAF_MIN, LEAF_MAX, LEAF_MAX + 1, 2 * LEAF_MAX + 1,
+                   BRANCH - 1, BRANCH, BRANCH + 1, 3 * BRANCH + 5,
+                   BRANCH * IntBTree::INNER_MAX + 1, 100000 };
+   for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+   {
+      int n = sizes[s];
+      // every other key, so inserts land between built keys
+      vector<int> keys(n + 1);
+      set<int> model;
+      for (int i = 0; i < n; ++i)
+      {
+         keys[i] = 2 * i;
+         model.insert(2 * i);
+      }
+      int range = 2 * n + 2;
+
+      IntBTree built;
+      built.insert(-5);   // build_from_sorted must drop it
+      built.build_from_sorted(&keys[0], n);
+      if (!same_as_model(built, model, range)) return false;
+
+      IntBTree copy(built);
+      IntBTree assigned;
+      assigned.insert(3);
+      assigned = built;
+      if (!same_as_model(copy, model, range) || !same_as_model(assigned, model, range))
+         return false;
+
+      // inserts into packed leaves split them; removes then merge
+      set<int> copy_model(model);
+      int run = 1 + range / 4;
+      if (!random_run(built, model, run, range, 70) ||
+          !same_as_model(built, model, range) ||
+          !random_run(built, model, 3 * run, range, 20) ||
+          !same_as_model(built, model, range) ||
+          !random_run(copy, copy_model, 2 * run, range, 15) ||
+          !same_as_model(copy, copy_model, range))
+         return false;
+
+      // the copies are independent
+      if (!same_as_model(assigned, set<int>(keys.begin(), keys.begin() + n), range))
+         return false;
+   }
+   return true;
+}
@@ -0,0 +1,333 @@
+// FILE: intSetIOTest.cpp
+// A non-interactive test for intset_save, intset_load and IntSetView.
+// Saved sets are checked against the IntSet they came from; damaged,
+// truncated and hostile files (a valid header that claims INT_MAX
+// members) must be rejected without touching the target set or
+// allocating for what the header claims. It prints one line per check
+// and returns EXIT_FAILURE if any fails.
+
+#include <climits>     // provides INT_MAX, INT_MIN
+#include <cstdio>      // provides remove
+#include <cstdlib>     // provides EXIT_SUCCESS, EXIT_FAILURE, rand, srand, malloc, free
+#include <fstream>     // provides ofstream
+#include <iostream>    // provides cout
+#include <new>         // provides bad_alloc
+#include <sstream>     // provides stringstream, istringstream
+#include <streambuf>   // provides streambuf
+#include <string>      // provides string
+#include "IntSetIO.h"
+
+using namespace std;
+
+// Largest single operator new request since it was last reset, so the
+// hostile-header check can see what intset_load tried to allocate.
+static size_t largest_alloc = 0;
+
+void* operator new(size_t bytes)
+{
+   if (bytes > largest_alloc) largest_alloc = bytes;
+   void* p = malloc(bytes == 0 ? 1 : bytes);
+   if (p == 0)
+      throw bad_alloc();
+   return p;
+}
+void* operator new[](size_t bytes) { return operator new(bytes); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+// A stream buffer over a string that can't seek, like a pipe.
+class pipe_buf : public streambuf
+{
+public:
+   explicit pipe_buf(const string& bytes) : bytes(bytes)
+   {
+      char* p = const_cast<char*>(this->bytes.data());
+      setg(p, p, p + this->bytes.size());
+   }
+private:
+   string bytes;
+};
+
+// PROTOTYPES for functions used by this test program:
+
+bool round_trips();
+// Pre:  (none)
+// Post: Sets of many shapes (empty, dense, sparse, near INT_MIN and
+//       INT_MAX, in and out of order) have been saved with and without
+//       their order, loaded back and opened with IntSetView; true has
+//       been returned if every loaded set equals the original (in the
+//       same order when it was kept) and every view agrees with it.
+bool damage_rejected();
+// Pre:  (none)
+// Post: Saved sets with one byte flipped after the header, or cut
+//       short, have been loaded; true has been returned if every load
+//       failed and left its target set unchanged.
+bool mismatched_sections_rejected();
+// Pre:  (none)
+// Post: Files whose order section holds a key missing from the sorted
+//       section, a repeated key, or the members of a different set,
+//       each with a checksum made to match, have been loaded and opened
+//       with IntSetView; true has been returned if each load and each
+//       verified open failed (leaving the target set unchanged), while
+//       the same edit that keeps the two sections in step loads.
+bool huge_count_rejected();
+// Pre:  (none)
+// Post: A 48-byte file whose header is valid but claims INT_MAX
+//       members (and so a payload of gigabytes) has been loaded from a
+//       seekable stream, a stream that can't seek and a file, and
+//       opened with IntSetView; true has been returned if each failed
+//       without throwing and without any allocation near the size the
+//       header claims.
+string save_to_string(const IntSet& s, bool keep_order);
+// Pre:  (none)
+// Post: The bytes intset_save wrote for s have been returned.
+bool write_file(const char* path, const string& bytes);
+// Pre:  (none)
+// Post: The file path holds bytes; false has been returned if it could
+//       not be written.
+
+const char* const SCRATCH_FILE = "intSetIOTest.tmp";
+
+int main()
+{
+   bool ok = true;
+   bool passed;
+
+   passed = round_trips();
+   cout << "round trips: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   passed = damage_rejected();
+   cout << "damaged files rejected: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   passed = mismatched_sections_rejected();
+   cout << "order and sorted sections must agree: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   passed = huge_count_rejected();
+   cout << "header claiming INT_MAX members rejected: "
+        << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   remove(SCRATCH_FILE);
+   return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Fills s with n members of the given shape (0 .. 3).
+void fill(IntSet& s, int n, int shape)
+{
+   for (int i = 0; i < n; ++i)
+   {
+      int x;
+      if (shape == 0)
+         x = i;
+      else if (shape == 1)
+         x = rand() - RAND_MAX / 2;
+      else if (shape == 2)
+         x = (rand() % 2 != 0) ? INT_MIN + rand() % 10 : INT_MAX - rand() % 10;
+      else
+         x = rand() % 3000;
+      s.add(x);
+   }
+}
+
+// The members of s as DumpData writes them.
+string dump(const IntSet& s)
+{
+   ostringstream out;
+   s.DumpData(out);
+   return out.str();
+}
+
+bool round_trips()
+{
+   srand(9);
+   for (int round = 0; round < 200; ++round)
+   {
+      IntSet s;
+      fill(s, (round < 5) ? round : rand() % 5000, rand() % 4);
+      bool keep_order = (round % 2 == 0);
+      string bytes = save_to_string(s, keep_order);
+
+      IntSet loaded;
+      loaded.add(42);
+      istringstream in(bytes);
+      if (!intset_load(in, loaded) || !(loaded == s) || loaded.size() != s.size())
+         return false;
+      bool ascending = true;
+      for (int i = 1; i < s.size(); ++i)
+         if (s.members()[i] < s.members()[i - 1]) ascending = false;
+      if ((keep_order || ascending) && dump(loaded) != dump(s))
+         return false;
+
+      IntSetView view;
+      if (!write_file(SCRATCH_FILE, bytes) || !view.open(SCRATCH_FILE, round % 3 != 0) ||
+          view.size() != s.size())
+         return false;
+      for (int i = 0; i < s.size(); ++i)
+         if (!view.contains(s.members()[i])) return false;
+      for (int k = 0; k < 1000; ++k)
+      {
+         int x = (k % 2 == 0) ? rand() - RAND_MAX / 2 : rand() % 3000;
+         if (view.contains(x) != s.contains(x)) return false;
+      }
+   }
+   return true;
+}
+
+bool damage_rejected()
+{
+   srand(17);
+   for (int round = 0; round < 200; ++round)
+   {
+      IntSet s;
+      fill(s, 1 + rand() % 3000, rand() % 4);
+      string bytes = save_to_string(s, true);
+
+      string flipped = bytes;
+      flipped[48 + rand() % (flipped.size() - 48)] ^= 0x5a;
+      string cut = bytes.substr(0, bytes.size() / 2);
+
+      IntSet target;
+      target.add(7);
+      istringstream flipped_in(flipped), cut_in(cut);
+      if (intset_load(flipped_in, target) || intset_load(cut_in, target) ||
+          target.size() != 1 || !target.contains(7))
+         return false;
+
+      IntSetView view;
+      if (!write_file(SCRATCH_FILE, flipped) || view.open(SCRATCH_FILE, true))
+         return false;
+   }
+   return true;
+}
+
+// Rewrites the header's checksum (64-bit FNV-1a of everything after the
+// 48-byte header) to match the payload of bytes.
+void fix_checksum(string& bytes)
+{
+   unsigned long long h = 14695981039346656037ULL;
+   for (size_t i = 48; i < bytes.size(); ++i)
+   {
+      h ^= (unsigned char)bytes[i];
+      h *= 1099511628211ULL;
+   }
+   for (int i = 0; i < 8; ++i)
+      bytes[40 + i] = char((h >> (8 * i)) & 0xFF);
+}
+
+bool mismatched_sections_rejected()
+{
+   // {1, 2, 3} added as 3, 1, 2: a 1-block index (8 bytes), the sorted
+   // gaps 0 0, then the order section as zigzag varints 6 3 2
+   IntSet s;
+   s.add(3);
+   s.add(1);
+   s.add(2);
+   string bytes = save_to_string(s, true);
+   size_t order = 48 + 8 + 2;
+   if (bytes.size() != order + 3 || bytes[order] != 6 || bytes[order + 2] != 2)
+      return false;
+
+   // the order sections (3 2 1 | 3 1 5 | 3 1 3 | 3 1 2) and last sorted
+   // gaps (the last makes the sorted section {1, 2, 4}); only the
+   // first pair agrees
+   const char orders[4][3] = { { 6, 1, 1 }, { 6, 3, 8 }, { 6, 3, 4 }, { 6, 3, 2 } };
+   const char last_gaps[4] = { 0, 0, 0, 1 };
+   bool ok = true;
+   for (int edit = 0; edit < 4; ++edit)
+   {
+      string changed = bytes;
+      changed[order - 1] = last_gaps[edit];
+      for (int k = 0; k < 3; ++k)
+         changed[order + k] = orders[edit][k];
+      fix_checksum(changed);
+
+      IntSet target;
+      target.add(7);
+      istringstream in(changed);
+      IntSetView view;
+      bool written = write_file(SCRATCH_FILE, changed);
+      if (edit == 0)
+         ok = ok && intset_load(in, target) && dump(target) == "3  2  1" &&
+              written && view.open(SCRATCH_FILE, true);
+      else
+         ok = ok && !intset_load(in, target) && target.size() == 1 &&
+              target.contains(7) && written && !view.open(SCRATCH_FILE, true) &&
+              view.open(SCRATCH_FILE, false);   // the O(1) open checks no keys
+   }
+   return ok;
+}
+
+// Appends value to bytes as n little-endian bytes.
+void put_le(string& bytes, unsigned long long value, int n)
+{
+   for (int i = 0; i < n; ++i)
+      bytes += char((value >> (8 * i)) & 0xFF);
+}
+
+bool huge_count_rejected()
+{
+   // the smallest sizes check_layout accepts for INT_MAX members
+   unsigned long long count = INT_MAX;
+   unsigned long long blocks = (count + IntSetView::BLOCK_KEYS - 1) / IntSetView::BLOCK_KEYS;
+   string header("DSAISET1");
+   put_le(header, count, 4);
+   put_le(header, blocks, 4);
+   put_le(header, 0, 4);              // flags: no order section
+   put_le(header, 0, 4);              // reserved
+   put_le(header, count - blocks, 8); // sorted_bytes: one byte per gap
+   put_le(header, 0, 8);              // order_bytes
+   put_le(header, 0, 8);              // checksum
+
+   const size_t LIMIT = size_t(1) << 24;   // far below the gigabytes claimed
+   bool ok = true;
+   IntSet target;
+   target.add(7);
+   try
+   {
+      largest_alloc = 0;
+      istringstream seekable(header);
+      ok = ok && !intset_load(seekable, target);
+
+      pipe_buf buffer(header);
+      istream pipe(&buffer);
+      ok = ok && !intset_load(pipe, target);
+
+      ok = ok && write_file(SCRATCH_FILE, header);
+      ok = ok && !intset_load(SCRATCH_FILE, target);
+      IntSetView view;
+      ok = ok && !view.open(SCRATCH_FILE, true) && !view.open(SCRATCH_FILE, false);
+      ok = ok && largest_alloc < LIMIT;
+   }
+   catch (const bad_alloc&)
+   {
+      ok = false;
+   }
+   return ok && target.size() == 1 && target.contains(7);
+}
+
+string save_to_string(const IntSet& s, bool keep_order)
+{
+   ostringstream out;
+   intset_save(s, out, keep_order);
+   return out.str();
+}
+
+bool write_file(const char* path, const string& bytes)
+{
+   ofstream out(path, ios::binary | ios::trunc);
+   out.write(bytes.data(), streamsize(bytes.size()));
+   out.close();
+   return !out.fail();
+}
@@ -0,0 +1,218 @@
+// FILE: intSetTest.cpp
+// A non-interactive model check of IntSet: random add, remove,
+// contains, bulk_add and in-place set algebra calls are applied both
+// to an IntSet and to a std::set plus a vector holding the membership
+// order. The sets grow past INDEX_MIN_ITEMS (32), where the Robin Hood
+// index is built, and shrink back below it; removes from an indexed set
+// go through the index's backward-shift delete and leave holes in data.
+// DumpData must print exactly the model's membership order. It prints
+// one line per check and returns EXIT_FAILURE if any fails.
+
+#include <algorithm>   // provides find
+#include <cstdlib>     // provides EXIT_SUCCESS, EXIT_FAILURE, rand, srand
+#include <iostream>    // provides cout
+#include <set>         // provides set
+#include <sstream>     // provides ostringstream
+#include <string>      // provides string
+#include <vector>      // provides vector
+#include "IntSet.h"
+
+using namespace std;
+
+// An IntSet's expected contents: the members and their membership order.
+struct model_set
+{
+   set<int> members;
+   vector<int> order;
+};
+
+// PROTOTYPES for functions used by this test program:
+
+bool same_as_model(const IntSet& s, const model_set& model);
+// Pre:  (none)
+// Post: true has been returned if s has the model's size and members,
+//       and DumpData and members() give them in the model's order.
+bool model_check();
+// Pre:  (none)
+// Post: IntSets have been put through random add, remove, contains,
+//       bulk_add, unionInPlace, intersectInPlace and subtractInPlace
+//       calls (plus copies and assignments) alongside a model_set,
+//       crossing 32 members up and down many times; true has been
+//       returned if every result and every check with same_as_model
+//       passed.
+bool churn_reuses_holes();
+// Pre:  (none)
+// Post: A set of 10000 members has had 10^6 of its oldest members
+//       removed, each followed by an add of a new key; true has been
+//       returned if the result matches the model and its array never
+//       grew past 4 times the members it holds.
+
+int main()
+{
+   bool ok = true;
+   bool passed;
+
+   passed = model_check();
+   cout << "model check against std::set: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   passed = churn_reuses_holes();
+   cout << "add/remove churn reuses holes: " << (passed ? "passed" : "FAILED") << endl;
+   ok = ok && passed;
+
+   return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Adds key to the model; false if it was already a member.
+bool model_add(model_set& model, int key)
+{
+   if (!model.members.insert(key).second) return false;
+   model.order.push_back(key);
+   return true;
+}
+
+// Removes key from the model; false if it was not a member.
+bool model_remove(model_set& model, int key)
+{
+   if (model.members.erase(key) == 0) return false;
+   model.order.erase(find(model.order.begin(), model.order.end(), key));
+   return true;
+}
+
+// Keeps the members of model that are (keep_common) or are not
+// (!keep_common) in other, in their order.
+void model_filter(model_set& model, const model_set& other, bool keep_common)
+{
+   vector<int> kept;
+   for (size_t i = 0; i < model.order.size(); ++i)
+   {
+      int key = model.order[i];
+      if ((other.members.count(key) == 1) == keep_common)
+         kept.push_back(key);
+      else
+         model.members.erase(key);
+   }
+   model.order = kept;
+}
+
+bool same_as_model(const IntSet& s, const model_set& model)
+{
+   if (s.size() != int(model.order.size()) || s.isEmpty() != model.order.empty())
+      return false;
+
+   ostringstream expected, dumped;
+   for (size_t i = 0; i < model.order.size(); ++i)
+      expected << ((i == 0) ? "" : "  ") << model.order[i];
+   s.DumpData(dumped);
+   if (dumped.str() != expected.str()) return false;
+
+   const int* members = s.members();
+   for (size_t i = 0; i < model.order.size(); ++i)
+      if (members[i] != model.order[i]) return false;
+   return true;
+}
+
+// A random set of up to 60 keys in [0, range) for the set algebra.
+void random_other(IntSet& other, model_set& model, int range)
+{
+   int n = rand() % 60;
+   for (int i = 0; i < n; ++i)
+   {
+      int key = rand() % range;
+      other.add(key);
+      model_add(model, key);
+   }
+}
+
+bool model_check()
+{
+   srand(11);
+   for (int round = 0; round < 300; ++round)
+   {
+      IntSet s;
+      model_set model;
+      // small ranges keep the set near 32 members; big ones let it grow
+      int range = (round % 3 == 0) ? 40 + rand() % 60 : 100 + rand() % 5000;
+      int ops = rand() % 4000;
+      for (int i = 0; i < ops; ++i)
+      {
+         int key = rand() % range;
+         int op = rand() % 40;
+         bool ok = true;
+         if (op < 14)
+            ok = s.add(key) == model_add(model, key);
+         else if (op < 30)
+            ok = s.remove(key) == model_remove(model, key);
+         else if (op < 36)
+            ok = s.contains(key) == (model.members.count(key) == 1);
+         else if (op == 36)
+         {
+            vector<int> batch(1 + rand() % 80);
+            int expected = 0;
+            for (size_t j = 0; j < batch.size(); ++j)
+            {
+               batch[j] = rand() % range;
+               expected += int(model_add(model, batch[j]));
+            }
+            ok = s.bulk_add(&batch[0], int(batch.size())) == expected;
+         }
+         else if (op == 37)
+         {
+            IntSet other;
+            model_set other_model;
+            random_other(other, other_model, range);
+            s.unionInPlace(other);
+            for (size_t j = 0; j < other_model.order.size(); ++j)
+               model_add(model, other_model.order[j]);
+         }
+         else if (op == 38)
+         {
+            IntSet other;
+            model_set other_model;
+            random_other(other, other_model, range);
+            bool intersect = (rand() % 2 == 0);
+            if (intersect)
+               s.intersectInPlace(other);
+            else
+               s.subtractInPlace(other);
+            model_filter(model, other_model, intersect);
+         }
+         else
+         {
+            // copies and assignments of a set that may have holes
+            IntSet copy(s);
+            IntSet assigned;
+            assigned.add(-1);
+            assigned = s;
+            ok = same_as_model(copy, model) && same_as_model(assigned, model);
+         }
+         if (!ok || s.size() != int(model.order.size())) return false;
+         if (i % 97 == 0 && !same_as_model(s, model)) return false;
+      }
+      if (!same_as_model(s, model)) return false;
+      for (int key = -1; key <= range; ++key)
+         if (s.contains(key) != (model.members.count(key) == 1)) return false;
+   }
+   return true;
+}
+
+bool churn_reuses_holes()
+{
+   const int MEMBERS = 10000;
+   IntSet s;
+   model_set model;
+   for (int key = 0; key < MEMBERS; ++key)
+   {
+      s.add(key);
+      model_add(model, key);
+   }
+   for (int key = MEMBERS; key < MEMBERS + 1000000; ++key)
+   {
+      if (!s.remove(key - MEMBERS) || !s.add(key)) return false;
+   }
+   model.members.clear();
+   model.order.clear();
+   for (int key = 1000000; key < MEMBERS + 1000000; ++key)
+      model_add(model, key);
+   return same_as_model(s, model) && s.growth().peak_capacity <= 4 * size_t(MEMBERS);
+}
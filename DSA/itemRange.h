@@ -0,0 +1,49 @@
+// FILE: itemRange.h (See namespace CS3358_FA2023_A04_sequence)
+//
+// TEMP CLASS PROVIDED: item_range<Iterator>
+//   A [first, last) pair of iterators that range-for and the standard
+//   algorithms can use. The template sequences hand one out from their
+//   items() member: their end() member already means "make the last
+//   item current", so they can't also provide the begin()/end() pair
+//   that range-for looks for.
+//
+//   Example:
+//      sequence<double> s;
+//      ...
+//      for (double x : s.items()) ...
+//      std::sort(s.items().begin(), s.items().end());
+//
+// MEMBER FUNCTIONS for the item_range class:
+//   item_range(Iterator first, Iterator last)
+//     Pre:  [first, last) is a valid range.
+//     Post: The range refers to [first, last) (nothing is copied).
+//   Iterator begin() const / Iterator end() const
+//     Post: first / last has been returned.
+//   size_t size() const
+//     Post: The number of items in the range has been returned.
+//
+// NOTE: An item_range is a view. It becomes invalid as soon as the
+//       sequence it came from adds or removes an item.
+
+#ifndef ITEM_RANGE_H
+#define ITEM_RANGE_H
+
+#include <cstdlib>  // provides size_t
+
+namespace CS3358_FA2023_A04_sequence
+{
+   template <class Iterator>
+   class item_range
+   {
+   public:
+      item_range(Iterator first, Iterator last) : first(first), last(last) {}
+      Iterator begin() const { return first; }
+      Iterator end() const { return last; }
+      std::size_t size() const { return std::size_t(last - first); }
+   private:
+      Iterator first;
+      Iterator last;
+   };
+}
+
+#endif
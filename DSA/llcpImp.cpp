@@ -1,11 +1,25 @@
 #include <iostream>
 #include <cstdlib>
 #include "llcpInt.h"
+#include "nodePool.h"
 using namespace std;
+using CS3358_FA2023::node_pool;
+
+// Where nodes come from: new/delete when pool is NULL.
+static Node* new_node(node_pool<Node>* pool)
+{
+   return (pool == 0) ? new Node : pool->allocate();
+}
+
+static void free_node(Node* node, node_pool<Node>* pool)
+{
+   if (pool == 0) delete node;
+   else pool->deallocate(node);
+}
 
 // definition of PropTarget
 // (put at near top to facilitate printing and grading)
-void PropTarget(Node*& headPtr, int target) {
+static void prop_target(Node*& headPtr, int target, node_pool<Node>* pool) {
     // Check if target exists in list
    Node* cursor = headPtr;
    bool targetFound = false;
@@ -19,7 +33,7 @@ void PropTarget(Node*& headPtr, int target) {
 
    // If target DNE, append to the end of list
    if (!targetFound) {
-      Node* newNode = new Node;
+      Node* newNode = new_node(pool);
       newNode->data = target;
       newNode->link = nullptr;
       if (!headPtr) {
@@ -69,6 +83,14 @@ void PropTarget(Node*& headPtr, int target) {
    headPtr = targetHead; // Update  headPtr to point to new head of list
 }
 
+void PropTarget(Node*& headPtr, int target) {
+   prop_target(headPtr, target, 0);
+}
+
+void PropTarget(Node*& headPtr, int target, node_pool<Node>& pool) {
+   prop_target(headPtr, target, &pool);
+}
+
 
 int FindListLength(Node* headPtr)
 {
@@ -96,17 +118,27 @@ bool IsSortedUp(Node* headPtr)
    return true;
 }
 
-void InsertAsHead(Node*& headPtr, int value)
+static void insert_as_head(Node*& headPtr, int value, node_pool<Node>* pool)
 {
-   Node *newNodePtr = new Node;
+   Node *newNodePtr = new_node(pool);
    newNodePtr->data = value;
    newNodePtr->link = headPtr;
    headPtr = newNodePtr;
 }
 
-void InsertAsTail(Node*& headPtr, int value)
+void InsertAsHead(Node*& headPtr, int value)
 {
-   Node *newNodePtr = new Node;
+   insert_as_head(headPtr, value, 0);
+}
+
+void InsertAsHead(Node*& headPtr, int value, node_pool<Node>& pool)
+{
+   insert_as_head(headPtr, value, &pool);
+}
+
+static void insert_as_tail(Node*& headPtr, int value, node_pool<Node>* pool)
+{
+   Node *newNodePtr = new_node(pool);
    newNodePtr->data = value;
    newNodePtr->link = 0;
    if (headPtr == 0)
@@ -121,7 +153,17 @@ void InsertAsTail(Node*& headPtr, int value)
    }
 }
 
-void InsertSortedUp(Node*& headPtr, int value)
+void InsertAsTail(Node*& headPtr, int value)
+{
+   insert_as_tail(headPtr, value, 0);
+}
+
+void InsertAsTail(Node*& headPtr, int value, node_pool<Node>& pool)
+{
+   insert_as_tail(headPtr, value, &pool);
+}
+
+static void insert_sorted_up(Node*& headPtr, int value, node_pool<Node>* pool)
 {
    Node *precursor = 0,
         *cursor = headPtr;
@@ -132,7 +174,7 @@ void InsertSortedUp(Node*& headPtr, int value)
       cursor = cursor->link;
    }
 
-   Node *newNodePtr = new Node;
+   Node *newNodePtr = new_node(pool);
    newNodePtr->data = value;
    newNodePtr->link = cursor;
    if (cursor == headPtr)
@@ -191,7 +233,17 @@ void InsertSortedUp(Node*& headPtr, int value)
    ///////////////////////////////////////////////////////////
 }
 
-bool DelFirstTargetNode(Node*& headPtr, int target)
+void InsertSortedUp(Node*& headPtr, int value)
+{
+   insert_sorted_up(headPtr, value, 0);
+}
+
+void InsertSortedUp(Node*& headPtr, int value, node_pool<Node>& pool)
+{
+   insert_sorted_up(headPtr, value, &pool);
+}
+
+static bool del_first_target_node(Node*& headPtr, int target, node_pool<Node>* pool)
 {
    Node *precursor = 0,
         *cursor = headPtr;
@@ -210,11 +262,21 @@ bool DelFirstTargetNode(Node*& headPtr, int target)
       headPtr = headPtr->link;
    else
       precursor->link = cursor->link;
-   delete cursor;
+   free_node(cursor, pool);
    return true;
 }
 
-bool DelNodeBefore1stMatch(Node*& headPtr, int target)
+bool DelFirstTargetNode(Node*& headPtr, int target)
+{
+   return del_first_target_node(headPtr, target, 0);
+}
+
+bool DelFirstTargetNode(Node*& headPtr, int target, node_pool<Node>& pool)
+{
+   return del_first_target_node(headPtr, target, &pool);
+}
+
+static bool del_node_before_1st_match(Node*& headPtr, int target, node_pool<Node>* pool)
 {
    if (headPtr == 0 || headPtr->link == 0 || headPtr->data == target) return false;
    Node *cur = headPtr->link, *pre = headPtr, *prepre = 0;
@@ -228,16 +290,26 @@ bool DelNodeBefore1stMatch(Node*& headPtr, int target)
    if (cur == headPtr->link)
    {
       headPtr = cur;
-      delete pre;
+      free_node(pre, pool);
    }
    else
    {
       prepre->link = cur;
-      delete pre;
+      free_node(pre, pool);
    }
    return true;
 }
 
+bool DelNodeBefore1stMatch(Node*& headPtr, int target)
+{
+   return del_node_before_1st_match(headPtr, target, 0);
+}
+
+bool DelNodeBefore1stMatch(Node*& headPtr, int target, node_pool<Node>& pool)
+{
+   return del_node_before_1st_match(headPtr, target, &pool);
+}
+
 void ShowAll(ostream& outs, Node* headPtr)
 {
    while (headPtr != 0)
@@ -309,3 +381,13 @@ void ListClear(Node*& headPtr, int noMsg)
    clog << "Dynamic memory for " << count << " nodes freed"
         << endl;
 }
+
+void ListClear(Node*& headPtr, node_pool<Node>& pool, int noMsg)
+{
+   size_t count = pool.live();
+   pool.release_all();
+   headPtr = 0;
+   if (noMsg) return;
+   clog << "Dynamic memory for " << count << " nodes freed"
+        << endl;
+}
@@ -0,0 +1,96 @@
+// FILE: llcpInt.h
+// PROVIDES: Node (a node of a singly linked list of ints) and functions
+//           that work on a list through a pointer to its head node
+//           (NULL for an empty list)
+//
+// FUNCTIONS for a list of Nodes:
+//   int FindListLength(Node* headPtr)
+//     Post: The number of nodes in the list has been returned.
+//   bool IsSortedUp(Node* headPtr)
+//     Post: true has been returned if the values are in non-decreasing
+//           order (an empty or 1-node list is).
+//   void InsertAsHead(Node*& headPtr, int value)
+//     Post: A node holding value has been added at the front.
+//   void InsertAsTail(Node*& headPtr, int value)
+//     Post: A node holding value has been added at the back.
+//   void InsertSortedUp(Node*& headPtr, int value)
+//     Pre:  IsSortedUp(headPtr) returns true.
+//     Post: A node holding value has been added before the first node
+//           whose value is not less than value, so the list is still
+//           sorted.
+//   bool DelFirstTargetNode(Node*& headPtr, int target)
+//     Post: If some node holds target, the first such node has been
+//           removed and true has been returned; otherwise false has
+//           been returned and the list is unchanged.
+//   bool DelNodeBefore1stMatch(Node*& headPtr, int target)
+//     Post: If a node other than the first holds target, the node just
+//           before the first such node has been removed and true has
+//           been returned; otherwise false has been returned and the
+//           list is unchanged.
+//   void ShowAll(std::ostream& outs, Node* headPtr)
+//     Post: The values have been written to outs, front to back, each
+//           followed by two spaces, then a newline.
+//   void FindMinMax(Node* headPtr, int& minValue, int& maxValue)
+//     Post: For a non-empty list, minValue and maxValue hold the
+//           smallest and largest value; for an empty list an error
+//           message has been written to cerr and both are unchanged.
+//   double FindAverage(Node* headPtr)
+//     Post: The average of the values has been returned (0.0, with an
+//           error message written to cerr, for an empty list).
+//   void ListClear(Node*& headPtr, int noMsg = 0)
+//     Post: Every node has been deleted and headPtr is NULL. Unless
+//           noMsg, the number of nodes freed has been written to clog.
+//   void PropTarget(Node*& headPtr, int target)
+//     Post: If some node holds target, every node holding target has
+//           been moved to the front (keeping their order and the order
+//           of the others); otherwise a node holding target has been
+//           added at the back.
+//
+// NODE POOL OVERLOADS (see nodePool.h):
+//   PropTarget, InsertAsHead, InsertAsTail, InsertSortedUp,
+//   DelFirstTargetNode and DelNodeBefore1stMatch also take a
+//   node_pool<Node>& pool as the last argument
+//     Post: As without pool, but nodes come from and go back to pool.
+//   void ListClear(Node*& headPtr, node_pool<Node>& pool, int noMsg = 0)
+//     Pre:  pool holds no nodes but headPtr's list.
+//     Post: Every node has been released at once (pool.release_all(),
+//           O(1)), headPtr is NULL and, unless noMsg, the count freed
+//           has been logged as by ListClear.
+//   A list built with the pool overloads must only be changed and
+//   cleared through them, with the same pool.
+
+#ifndef LLCP_INT_H
+#define LLCP_INT_H
+
+#include <iostream>   // provides ostream
+#include "nodePool.h"
+
+struct Node
+{
+   int data;
+   Node* link;
+};
+
+int    FindListLength(Node* headPtr);
+bool   IsSortedUp(Node* headPtr);
+void   InsertAsHead(Node*& headPtr, int value);
+void   InsertAsTail(Node*& headPtr, int value);
+void   InsertSortedUp(Node*& headPtr, int value);
+bool   DelFirstTargetNode(Node*& headPtr, int target);
+bool   DelNodeBefore1stMatch(Node*& headPtr, int target);
+void   ShowAll(std::ostream& outs, Node* headPtr);
+void   FindMinMax(Node* headPtr, int& minValue, int& maxValue);
+double FindAverage(Node* headPtr);
+void   ListClear(Node*& headPtr, int noMsg = 0);
+void   PropTarget(Node*& headPtr, int target);
+
+void   PropTarget(Node*& headPtr, int target, CS3358_FA2023::node_pool<Node>& pool);
+void   InsertAsHead(Node*& headPtr, int value, CS3358_FA2023::node_pool<Node>& pool);
+void   InsertAsTail(Node*& headPtr, int value, CS3358_FA2023::node_pool<Node>& pool);
+void   InsertSortedUp(Node*& headPtr, int value, CS3358_FA2023::node_pool<Node>& pool);
+bool   DelFirstTargetNode(Node*& headPtr, int target, CS3358_FA2023::node_pool<Node>& pool);
+bool   DelNodeBefore1stMatch(Node*& headPtr, int target,
+                             CS3358_FA2023::node_pool<Node>& pool);
+void   ListClear(Node*& headPtr, CS3358_FA2023::node_pool<Node>& pool, int noMsg = 0);
+
+#endif
@@ -0,0 +1,126 @@
+// FILE: nodePool.h (part of the namespace CS3358_FA2023)
+// TEMPLATE CLASS PROVIDED: node_pool<Node> (a slab allocator for the
+//                          nodes of linked structures)
+//
+// A linked structure built with one new per node spends most of its
+// build and teardown time in malloc/free, and its nodes end up wherever
+// the heap has room, so walking it misses the cache at almost every
+// link. A node_pool hands out nodes from slabs of many nodes each:
+//   - allocate() pops a freed node or takes the next slot of the
+//     current slab (a new slab every nodes_per_slab allocations),
+//   - deallocate() pushes the node on a free list for reuse,
+//   - release_all() gives back every node at once in O(1), keeping the
+//     slabs to be refilled.
+// Nodes allocated one after another sit next to each other, so a list
+// or tree built in one pass is walked mostly within a few pages.
+//
+// The btNode, Node and CNode/PNode functions take a pool as an extra
+// argument (see btNode.cpp, llcpImp.cpp and nodes_LLoLL.cpp): a
+// structure built from a pool must be changed and freed only through
+// the pool overloads, and a pool should serve one structure if its
+// clear is to use release_all.
+//
+// CONSTRUCTOR for the node_pool<Node> template class:
+//   node_pool(size_t nodes_per_slab = 0)
+//     Post: The pool is empty. Slabs will hold nodes_per_slab nodes (0
+//           picks as many as fit in DEFAULT_SLAB_BYTES, at least 16).
+//
+// MODIFICATION MEMBER FUNCTIONS for the node_pool<Node> template class:
+//   Node* allocate()
+//     Post: A default-initialized Node has been returned (like new
+//           Node: the fields of a plain struct are uninitialized).
+//   void reserve(size_t n)
+//     Post: The next n calls of allocate() that don't reuse a freed
+//           node will take adjacent slots of one slab (a slab of
+//           max(n, nodes_per_slab) nodes is made if the current one
+//           hasn't n slots left; its unused slots wait for
+//           release_all), so a structure of n nodes can be laid out in
+//           one block.
+//   void deallocate(Node* p)
+//     Pre:  p came from allocate() of this pool and has not been
+//           deallocated or released since (or p is NULL).
+//     Post: *p has been destroyed and its slot will be reused.
+//   void release_all()
+//     Post: Every node allocated from the pool has been released
+//           (destructors are not run, so Node should be a plain struct
+//           or have nothing to clean up); every pointer into the pool
+//           is now invalid. The slabs are kept and refilled from the
+//           first. O(1).
+//   void free_slabs()
+//     Post: Every node has been released as by release_all and the
+//           slabs have been returned to the heap.
+//
+// CONSTANT MEMBER FUNCTIONS for the node_pool<Node> template class:
+//   size_t live() const
+//     Post: The number of nodes allocated and not yet deallocated or
+//           released has been returned.
+//   size_t slab_count() const
+//   size_t bytes_reserved() const
+//     Post: The number of slabs / the bytes they hold has been returned.
+//
+// VALUE SEMANTICS for the node_pool<Node> template class:
+//   A node_pool can't be copied or assigned: it owns its slabs.
+//
+// DYNAMIC MEMORY USAGE by the node_pool<Node> template class:
+//   allocate() throws bad_alloc if a new slab is needed and there is
+//   insufficient dynamic memory. The destructor frees every slab.
+
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstdlib>      // provides size_t
+#include <type_traits>  // provides aligned_storage, alignment_of
+
+namespace CS3358_FA2023
+{
+   template <class Node>
+   class node_pool
+   {
+   public:
+      static const std::size_t DEFAULT_SLAB_BYTES = 64 * 1024;
+
+      node_pool(std::size_t nodes_per_slab = 0);
+      ~node_pool();
+      Node* allocate();
+      void reserve(std::size_t n);
+      void deallocate(Node* p);
+      void release_all();
+      void free_slabs();
+      std::size_t live() const { return live_nodes; }
+      std::size_t slab_count() const { return slabs; }
+      std::size_t bytes_reserved() const;
+
+   private:
+      // A free slot holds the link to the next free slot; a used one
+      // holds a Node.
+      union slot
+      {
+         slot* next_free;
+         typename std::aligned_storage<sizeof(Node),
+                                       std::alignment_of<Node>::value>::type node;
+      };
+      // Slabs form a list; the slots follow the header.
+      struct slab
+      {
+         slab* next;
+         std::size_t capacity;   // slots (per_slab unless reserved)
+      };
+
+      std::size_t per_slab;
+      slab* first;          // oldest slab (NULL if none)
+      slab* current;        // slab being carved (NULL before the first)
+      std::size_t carved;   // slots of current handed out so far
+      slot* free_list;
+      std::size_t live_nodes;
+      std::size_t slabs;
+
+      static std::size_t header_bytes();
+      static slot* slots_of(slab* s);
+      slab* new_slab(std::size_t capacity, slab* after);
+      node_pool(const node_pool&);
+      node_pool& operator=(const node_pool&);
+   };
+}
+
+#include "nodePool.template"
+#endif
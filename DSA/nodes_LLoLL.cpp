@@ -1,7 +1,9 @@
 #include "nodes_LLoLL.h"
 #include "cnPtrQueue.h"
+#include "nodePool.h"
 #include <iostream>
 using namespace std;
+using CS3358_FA2023::node_pool;
 
 namespace CS3358_FA2023_A5P2
 {
@@ -71,6 +73,27 @@ namespace CS3358_FA2023_A5P2
            << endl;
    }
 
+   void Destroy_cList(CNode*& cListHead, node_pool<CNode>& cPool)
+   {
+      size_t count = cPool.live();
+      cPool.release_all();
+      cListHead = 0;
+      cout << "Dynamic memory for " << count << " CNodes freed"
+           << endl;
+   }
+
+   void Destroy_pList(PNode*& pListHead, node_pool<PNode>& pPool,
+                      node_pool<CNode>& cPool)
+   {
+      size_t count = pPool.live();
+      CNode* cListHead = 0;
+      Destroy_cList(cListHead, cPool);
+      pPool.release_all();
+      pListHead = 0;
+      cout << "Dynamic memory for " << count << " PNodes freed"
+           << endl;
+   }
+
    // do depth-first traversal and print data
    void ShowAll_DF(PNode* pListHead, ostream& outs)
    {
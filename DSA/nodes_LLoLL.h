@@ -0,0 +1,65 @@
+// FILE: nodes_LLoLL.h (part of the namespace CS3358_FA2023_A5P2)
+// PROVIDES: CNode and PNode, the nodes of a linked list of linked lists
+//           (each PNode points at the head of a list of CNodes), and
+//           functions that work on such a list through its head PNode
+//
+// FUNCTIONS for a list of lists:
+//   void ShowAll_DF(PNode* pListHead, std::ostream& outs)
+//     Post: The CNode values have been written to outs depth first:
+//           all of the first CNode list, then all of the second, ...
+//   void ShowAll_BF(PNode* pListHead, std::ostream& outs)
+//     Post: The CNode values have been written to outs breadth first:
+//           the first value of every CNode list, then the second, ...
+//   void Destroy_cList(CNode*& cListHead)
+//     Post: Every CNode of the list has been deleted, cListHead is
+//           NULL and the count freed has been written to cout.
+//   void Destroy_pList(PNode*& pListHead)
+//     Post: Every PNode and every CNode of their lists has been
+//           deleted, pListHead is NULL and the counts freed have been
+//           written to cout.
+//
+// NODE POOL OVERLOADS (see nodePool.h), for lists whose nodes all came
+// from the pools:
+//   void Destroy_cList(CNode*& cListHead, node_pool<CNode>& cPool)
+//     Pre:  cPool holds no CNodes but cListHead's list.
+//     Post: Every CNode has been released at once (O(1)), cListHead
+//           is NULL and the count freed has been reported as by
+//           Destroy_cList.
+//   void Destroy_pList(PNode*& pListHead, node_pool<PNode>& pPool,
+//                      node_pool<CNode>& cPool)
+//     Pre:  pPool holds no PNodes but pListHead's list, and cPool no
+//           CNodes but those of its CNode lists.
+//     Post: Every PNode and CNode has been released at once (O(1)),
+//           pListHead is NULL and the counts freed have been reported.
+
+#ifndef NODES_LLOLL_H
+#define NODES_LLOLL_H
+
+#include <iostream>   // provides ostream
+#include "nodePool.h"
+
+namespace CS3358_FA2023_A5P2
+{
+   struct CNode
+   {
+      int data;
+      CNode* link;
+   };
+
+   struct PNode
+   {
+      CNode* data;
+      PNode* link;
+   };
+
+   void ShowAll_DF(PNode* pListHead, std::ostream& outs);
+   void ShowAll_BF(PNode* pListHead, std::ostream& outs);
+   void Destroy_cList(CNode*& cListHead);
+   void Destroy_pList(PNode*& pListHead);
+
+   void Destroy_cList(CNode*& cListHead, CS3358_FA2023::node_pool<CNode>& cPool);
+   void Destroy_pList(PNode*& pListHead, CS3358_FA2023::node_pool<PNode>& pPool,
+                      CS3358_FA2023::node_pool<CNode>& cPool);
+}
+
+#endif
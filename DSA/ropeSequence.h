@@ -0,0 +1,165 @@
+// FILE: ropeSequence.h (See namespace CS3358_FA2023)
+//
+// TEMP CLASS PROVIDED: rope_sequence<Item>
+// CLASS PROVIDED: rope_sequence<Item> (a container class for a list of
+//                 items, where each list may have a designated item
+//                 called the current item; same cursor interface as
+//                 sequence (see Sequence.cpp), meant for sequences of
+//                 tens of millions of items that are edited anywhere)
+//
+// STORAGE:
+//   The items are kept in small chunks (leaves of at most LEAF_MAX
+//   items) hung off a balanced tree whose nodes know how many items lie
+//   below them, so the i-th item is found, inserted or removed in
+//   O(log n) and no operation ever moves more than one chunk's worth of
+//   items. There is never one big array to grow, so peak memory during
+//   growth is the items plus one spare chunk per tree level.
+//
+//   Nodes are shared between copies (reference counted) and copied only
+//   when one of the sharing sequences changes them ("copy on write"),
+//   so copying a rope_sequence -- e.g. to take a snapshot of a huge
+//   sequence before a batch of edits -- is O(1), and an edit after
+//   that copies only the O(log n) nodes on the path it changes.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the rope_sequence class:
+//   typedef ____ rope_sequence<Item>::value_type
+//     rope_sequence::value_type is the data type of the items in the
+//     sequence. It may be any of the C++ built-in types (int, char,
+//     etc.), or a class with a copy constructor and an assignment
+//     operator.
+//   typedef ____ rope_sequence<Item>::size_type
+//     rope_sequence::size_type is the data type of any variable that
+//     keeps track of how many items are in a sequence.
+//   static const size_type LEAF_MAX, INNER_MAX
+//     The most items in one leaf chunk / children of one inner node.
+//
+// CONSTRUCTOR for the rope_sequence class:
+//   rope_sequence()
+//     Pre:  (none)
+//     Post: The sequence has been initialized as an empty sequence.
+//
+// MODIFICATION MEMBER FUNCTIONS for the rope_sequence class:
+//   void start()
+//     Pre:  (none)
+//     Post: The first item on the sequence becomes the current item
+//           (but if the sequence is empty, then there is no current item).
+//   void advance()
+//     Pre:  is_item() returns true.
+//     Post: If the current item was the last item in the sequence, then
+//           there is no longer any current item. Otherwise, the new current
+//           item is the item immediately after the original current item.
+//           (O(1); walking the whole sequence with current() costs O(n).)
+//   void insert(const value_type& entry)
+//     Pre:  (none)
+//     Post: A new copy of entry has been inserted in the sequence
+//           before the current item. If there was no current item, then
+//           the new entry has been inserted at the front of the sequence.
+//           In either case, the newly inserted item is now the
+//           current item of the sequence. O(log n).
+//   void attach(const value_type& entry)
+//     Pre:  (none)
+//     Post: A new copy of entry has been inserted in the sequence after
+//           the current item. If there was no current item, then the new
+//           entry has been attached to the end of the sequence. In either
+//           case, the newly inserted item is now the current item of the
+//           sequence. O(log n).
+//   void remove_current()
+//     Pre:  is_item() returns true.
+//     Post: The current item has been removed from the sequence, and
+//           the item after this (if there is one) is now the new current
+//           item. O(log n).
+//
+// CONSTANT MEMBER FUNCTIONS for the rope_sequence class:
+//   size_type size() const
+//     Pre:  (none)
+//     Post: The return value is the number of items in the sequence.
+//   bool is_item() const
+//     Pre:  (none)
+//     Post: A true return value indicates that there is a valid
+//           "current" item that may be retrieved by activating the current
+//           member function (listed below). A false return value indicates
+//           that there is no valid current item.
+//   const value_type& current() const
+//     Pre:  is_item() returns true.
+//     Post: A reference to the current item has been returned. It stays
+//           valid until the invoking sequence is next changed.
+//   rope_sequence snapshot() const
+//     Pre:  (none)
+//     Post: An O(1) copy of the sequence (items and current item) has
+//           been returned; later edits to either one don't affect the
+//           other. (The same as the copy constructor; spelled out for
+//           readability.)
+//
+// VALUE SEMANTICS for the rope_sequence class:
+//    Assignments and the copy constructor may be used with rope_sequence
+//    objects; both are O(1) (see STORAGE).
+//    NOTE: Copies share nodes, so two copies must not be used from
+//          different threads without outside locking.
+//
+// DYNAMIC MEMORY USAGE by the rope_sequence class:
+//   If there is insufficient dynamic memory, insert, attach and
+//   remove_current throw bad_alloc.
+
+#ifndef ROPE_SEQUENCE_H
+#define ROPE_SEQUENCE_H
+
+#include <cstdlib>   // provides size_t
+#include <memory>    // provides shared_ptr
+#include <vector>    // provides vector
+
+namespace CS3358_FA2023
+{
+   template <class Item>
+   class rope_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef Item value_type;
+      typedef std::size_t size_type;
+      static const size_type LEAF_MAX = 256;
+      static const size_type INNER_MAX = 32;
+      // CONSTRUCTOR
+      rope_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void start();
+      void advance();
+      void insert(const Item& entry);
+      void attach(const Item& entry);
+      void remove_current();
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      const Item& current() const;
+      rope_sequence snapshot() const;
+
+   private:
+      struct node;
+      typedef std::shared_ptr<node> node_ptr;
+      struct node
+      {
+         bool leaf;
+         size_type count;               // items in this subtree
+         std::vector<Item> items;       // leaf: the chunk itself
+         std::vector<node_ptr> kids;    // inner node: the children
+      };
+
+      node_ptr root;
+      size_type current_index;
+      // where the current item was last found (see current())
+      mutable const node* cache_leaf;
+      mutable size_type cache_first;
+
+      static size_type width(const node& n);
+      static node_ptr new_leaf();
+      static void make_unique(node_ptr& p);
+      static size_type child_for(const node& n, size_type& i);
+      static node_ptr split(node& n);
+      static node_ptr insert_at(node_ptr& p, size_type i, const Item& entry);
+      static void erase_at(node_ptr& p, size_type i);
+      static void fix_child(node& parent, size_type k);
+      void insert_item(size_type i, const Item& entry);
+   };
+}
+
+#include "ropeSequence.template"
+#endif
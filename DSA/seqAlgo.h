@@ -0,0 +1,356 @@
+// FILE: seqAlgo.h
+// FUNCTIONS PROVIDED: bulk scans over the contiguous items of a sequence
+//   (sequence, sequence<Item>, dyn_sequence<Item, N>, or any array).
+//   The sequences' find/count_if/min_max/sum members forward here.
+//
+//   template <class T>
+//   const T* seq_find(const T* first, const T* last, const T& target)
+//     Pre:  [first, last) is a valid range.
+//     Post: A pointer to the first item equal to target has been
+//           returned, or last if there is none.
+//   template <class T, class Pred>
+//   size_t seq_count_if(const T* first, const T* last, Pred pred)
+//     Pre:  [first, last) is a valid range; pred can be called from
+//           several threads at once, and does not throw.
+//     Post: The number of items x with pred(x) true has been returned.
+//   template <class T>
+//   bool seq_min_max(const T* first, const T* last, T& min_value, T& max_value)
+//     Pre:  [first, last) is a valid range.
+//     Post: If the range is empty, false has been returned and
+//           min_value/max_value are unchanged. Otherwise true has been
+//           returned and they hold the smallest and largest item.
+//           (For floating-point items containing NaN the result is
+//           unspecified.)
+//   template <class T>
+//   T seq_sum(const T* first, const T* last)
+//     Pre:  [first, last) is a valid range.
+//     Post: The sum of the items (T() for an empty range) has been
+//           returned. For floating-point items the additions are not
+//           done strictly left to right, so the last bits may differ
+//           from a cursor-walk sum.
+//
+// HOW:
+//   - Arithmetic items are scanned several at a time with independent
+//     accumulators, which the compiler turns into SIMD code; double has
+//     hand-written SSE2 kernels (AVX when compiled with -mavx), since
+//     compilers won't reorder floating-point sums on their own.
+//   - Ranges of at least PARALLEL_THRESHOLD items are cut into one
+//     chunk per hardware thread and scanned concurrently; the partial
+//     results are then combined. There is no thread pool: every such
+//     call starts and joins up to hardware_concurrency() - 1 threads,
+//     some tens of microseconds each, which is why the threshold is
+//     high enough (2^18 items) for the scan itself to dominate.
+
+#ifndef SEQ_ALGO_H
+#define SEQ_ALGO_H
+
+#include <cstdlib>   // provides size_t
+#include <system_error>   // provides system_error
+#include <thread>    // provides thread, hardware_concurrency
+#include <vector>    // provides vector
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DSA_SEQ_SSE2 1
+#endif
+#if defined(__AVX__)
+#include <immintrin.h>
+#define DSA_SEQ_AVX 1
+#endif
+
+namespace CS3358_FA2023
+{
+   const size_t PARALLEL_THRESHOLD = size_t(1) << 18;
+
+   namespace seq_algo_detail
+   {
+      // --- single-thread kernels, generic versions ---
+
+      template <class T>
+      const T* find_kernel(const T* first, const T* last, const T& target)
+      {
+         for (; last - first >= 4; first += 4)
+         {
+            if ((first[0] == target) | (first[1] == target) |
+                (first[2] == target) | (first[3] == target))
+               break;
+         }
+         for (; first != last; ++first)
+            if (*first == target) return first;
+         return last;
+      }
+
+      template <class T, class Pred>
+      size_t count_kernel(const T* first, const T* last, Pred& pred)
+      {
+         size_t count = 0;
+         for (; first != last; ++first)
+            count += pred(*first) ? 1 : 0;
+         return count;
+      }
+
+      template <class T>
+      void min_max_kernel(const T* first, const T* last, T& lo, T& hi)
+      {
+         lo = hi = *first;
+         for (++first; first != last; ++first)
+         {
+            if (*first < lo) lo = *first;
+            if (hi < *first) hi = *first;
+         }
+      }
+
+      template <class T>
+      T sum_kernel(const T* first, const T* last)
+      {
+         T s0 = T(), s1 = T(), s2 = T(), s3 = T();
+         for (; last - first >= 4; first += 4)
+         {
+            s0 += first[0];
+            s1 += first[1];
+            s2 += first[2];
+            s3 += first[3];
+         }
+         for (; first != last; ++first)
+            s0 += *first;
+         return (s0 + s1) + (s2 + s3);
+      }
+
+      // --- double kernels (the workload in sequenceTest) ---
+#ifdef DSA_SEQ_SSE2
+      inline const double* find_kernel(const double* first, const double* last,
+                                       const double& target)
+      {
+         __m128d t = _mm_set1_pd(target);
+         for (; last - first >= 4; first += 4)
+         {
+            __m128d eq = _mm_or_pd(_mm_cmpeq_pd(_mm_loadu_pd(first), t),
+                                   _mm_cmpeq_pd(_mm_loadu_pd(first + 2), t));
+            if (_mm_movemask_pd(eq) != 0)
+               break;
+         }
+         for (; first != last; ++first)
+            if (*first == target) return first;
+         return last;
+      }
+
+      inline void min_max_kernel(const double* first, const double* last,
+                                 double& lo, double& hi)
+      {
+         if (last - first < 4)
+         {
+            lo = hi = *first;
+            for (++first; first != last; ++first)
+            {
+               if (*first < lo) lo = *first;
+               if (hi < *first) hi = *first;
+            }
+            return;
+         }
+         __m128d lo0 = _mm_loadu_pd(first), lo1 = _mm_loadu_pd(first + 2);
+         __m128d hi0 = lo0, hi1 = lo1;
+         for (first += 4; last - first >= 4; first += 4)
+         {
+            __m128d a = _mm_loadu_pd(first), b = _mm_loadu_pd(first + 2);
+            lo0 = _mm_min_pd(lo0, a); lo1 = _mm_min_pd(lo1, b);
+            hi0 = _mm_max_pd(hi0, a); hi1 = _mm_max_pd(hi1, b);
+         }
+         double l[2], h[2];
+         _mm_storeu_pd(l, _mm_min_pd(lo0, lo1));
+         _mm_storeu_pd(h, _mm_max_pd(hi0, hi1));
+         lo = (l[0] < l[1]) ? l[0] : l[1];
+         hi = (h[0] < h[1]) ? h[1] : h[0];
+         for (; first != last; ++first)
+         {
+            if (*first < lo) lo = *first;
+            if (hi < *first) hi = *first;
+         }
+      }
+
+      inline double sum_kernel(const double* first, const double* last)
+      {
+#ifdef DSA_SEQ_AVX
+         __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+         for (; last - first >= 8; first += 8)
+         {
+            a0 = _mm256_add_pd(a0, _mm256_loadu_pd(first));
+            a1 = _mm256_add_pd(a1, _mm256_loadu_pd(first + 4));
+         }
+         __m256d a = _mm256_add_pd(a0, a1);
+         __m128d s = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+#else
+         __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+         __m128d a2 = _mm_setzero_pd(), a3 = _mm_setzero_pd();
+         for (; last - first >= 8; first += 8)
+         {
+            a0 = _mm_add_pd(a0, _mm_loadu_pd(first));
+            a1 = _mm_add_pd(a1, _mm_loadu_pd(first + 2));
+            a2 = _mm_add_pd(a2, _mm_loadu_pd(first + 4));
+            a3 = _mm_add_pd(a3, _mm_loadu_pd(first + 6));
+         }
+         __m128d s = _mm_add_pd(_mm_add_pd(a0, a1), _mm_add_pd(a2, a3));
+#endif
+         double lanes[2];
+         _mm_storeu_pd(lanes, s);
+         double total = lanes[0] + lanes[1];
+         for (; first != last; ++first)
+            total += *first;
+         return total;
+      }
+#endif
+
+      // --- splitting a range across threads ---
+
+      // Pre:  n >= PARALLEL_THRESHOLD.
+      // Post: The number of chunks to use (>= 1) has been returned.
+      inline size_t chunk_count(size_t n)
+      {
+         size_t threads = std::thread::hardware_concurrency();
+         if (threads < 2) return 1;
+         size_t most = n / (PARALLEL_THRESHOLD / 4);
+         return (threads < most) ? threads : most;
+      }
+
+      // Joins every joinable thread of workers when it goes out of
+      // scope, so an exception on the calling thread never destroys a
+      // joinable std::thread (which would call std::terminate).
+      class join_guard
+      {
+      public:
+         explicit join_guard(std::vector<std::thread>& workers) : workers(workers) {}
+         ~join_guard()
+         {
+            for (size_t i = 0; i < workers.size(); ++i)
+               if (workers[i].joinable()) workers[i].join();
+         }
+      private:
+         std::vector<std::thread>& workers;
+         join_guard(const join_guard&);
+         void operator=(const join_guard&);
+      };
+
+      // Runs work(i, chunk_first, chunk_last) for every chunk i, chunk 0
+      // on the calling thread and the rest on their own threads. If a
+      // thread cannot be started (std::system_error), that chunk and the
+      // ones after it run on the calling thread instead. If work throws
+      // on the calling thread, the started threads are joined before the
+      // exception propagates.
+      template <class T, class Work>
+      void for_each_chunk(const T* first, const T* last, size_t chunks, Work work)
+      {
+         size_t n = size_t(last - first);
+         std::vector<std::thread> workers;
+         workers.reserve(chunks - 1);
+         join_guard guard(workers);
+         size_t i = 1;
+         try
+         {
+            for (; i < chunks; ++i)
+               workers.push_back(std::thread(work, i, first + n * i / chunks,
+                                             first + n * (i + 1) / chunks));
+         }
+         catch (const std::system_error&)
+         {
+            for (; i < chunks; ++i)
+               work(i, first + n * i / chunks, first + n * (i + 1) / chunks);
+         }
+         work(size_t(0), first, first + n / chunks);
+      }
+   }
+
+   template <class T>
+   const T* seq_find(const T* first, const T* last, const T& target)
+   {
+      using namespace seq_algo_detail;
+      size_t n = size_t(last - first);
+      size_t chunks = (n >= PARALLEL_THRESHOLD) ? chunk_count(n) : 1;
+      if (chunks == 1)
+         return find_kernel(first, last, target);
+
+      std::vector<const T*> found(chunks);
+      for_each_chunk(first, last, chunks,
+         [&found, &target](size_t i, const T* f, const T* l)
+         {
+            const T* hit = find_kernel(f, l, target);
+            found[i] = (hit == l) ? 0 : hit;
+         });
+      for (size_t i = 0; i < chunks; ++i)
+         if (found[i] != 0) return found[i];
+      return last;
+   }
+
+   template <class T, class Pred>
+   size_t seq_count_if(const T* first, const T* last, Pred pred)
+   {
+      using namespace seq_algo_detail;
+      size_t n = size_t(last - first);
+      size_t chunks = (n >= PARALLEL_THRESHOLD) ? chunk_count(n) : 1;
+      if (chunks == 1)
+         return count_kernel(first, last, pred);
+
+      std::vector<size_t> counts(chunks);
+      for_each_chunk(first, last, chunks,
+         [&counts, pred](size_t i, const T* f, const T* l)
+         {
+            Pred local = pred;
+            counts[i] = count_kernel(f, l, local);
+         });
+      size_t total = 0;
+      for (size_t i = 0; i < chunks; ++i)
+         total += counts[i];
+      return total;
+   }
+
+   template <class T>
+   bool seq_min_max(const T* first, const T* last, T& min_value, T& max_value)
+   {
+      using namespace seq_algo_detail;
+      if (first == last) return false;
+
+      size_t n = size_t(last - first);
+      size_t chunks = (n >= PARALLEL_THRESHOLD) ? chunk_count(n) : 1;
+      if (chunks == 1)
+      {
+         min_max_kernel(first, last, min_value, max_value);
+         return true;
+      }
+
+      std::vector<T> lows(chunks), highs(chunks);
+      for_each_chunk(first, last, chunks,
+         [&lows, &highs](size_t i, const T* f, const T* l)
+         {
+            min_max_kernel(f, l, lows[i], highs[i]);
+         });
+      min_value = lows[0];
+      max_value = highs[0];
+      for (size_t i = 1; i < chunks; ++i)
+      {
+         if (lows[i] < min_value) min_value = lows[i];
+         if (max_value < highs[i]) max_value = highs[i];
+      }
+      return true;
+   }
+
+   template <class T>
+   T seq_sum(const T* first, const T* last)
+   {
+      using namespace seq_algo_detail;
+      size_t n = size_t(last - first);
+      size_t chunks = (n >= PARALLEL_THRESHOLD) ? chunk_count(n) : 1;
+      if (chunks == 1)
+         return sum_kernel(first, last);
+
+      std::vector<T> sums(chunks);
+      for_each_chunk(first, last, chunks,
+         [&sums](size_t i, const T* f, const T* l)
+         {
+            sums[i] = sum_kernel(f, l);
+         });
+      T total = T();
+      for (size_t i = 0; i < chunks; ++i)
+         total += sums[i];
+      return total;
+   }
+}
+
+#endif
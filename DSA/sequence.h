@@ -69,6 +69,33 @@
 //   value_type current() const
 //     Pre:  is_item() returns true.
 //     Post: The item returned is the current item in the sequence.
+//   item_range<iterator> items()
+//   item_range<const_iterator> items() const
+//     Pre:  (none)
+//     Post: The return value spans the items, first to last, as
+//           contiguous random-access iterators (see itemRange.h), for
+//           range-for and the standard algorithms. The cursor is not
+//           used or changed. The range is invalidated by add and
+//           remove_current.
+//   bool find(const value_type& target)
+//     Pre:  (none)
+//     Post: If target is in the sequence, its first occurrence has
+//           become the current item and true has been returned.
+//           Otherwise false has been returned and the cursor is
+//           unchanged.
+//   template <class Pred> size_type count_if(Pred pred) const
+//     Pre:  pred(item) can be called from several threads at once.
+//     Post: The number of items for which pred returns true has been
+//           returned.
+//   bool min_max(value_type& min_value, value_type& max_value) const
+//     Pre:  (none)
+//     Post: For an empty sequence false has been returned. Otherwise
+//           true has been returned and min_value/max_value hold the
+//           smallest and largest item.
+//   value_type sum() const
+//     Pre:  value_type supports + (and value_type() is its zero).
+//     Post: The sum of all items has been returned.
+//   (find, count_if, min_max and sum forward to seqAlgo.h.)
 // VALUE SEMANTICS for the sequence class:
 //    Assignments and the copy constructor may be used with sequence
 //    objects.
@@ -77,6 +104,8 @@
 #define SEQUENCE_H
 
 #include <cstdlib>  // provides size_t
+#include "itemRange.h"
+#include "seqAlgo.h"
 
 namespace CS3358_FA2023_A04_sequence
 {
@@ -87,6 +116,8 @@ namespace CS3358_FA2023_A04_sequence
       // TYPEDEFS and MEMBER SP2020
       typedef size_t size_type;
       static const size_type CAPACITY = 10;
+      typedef Item* iterator;
+      typedef const Item* const_iterator;
       // CONSTRUCTOR
       sequence();
       // MODIFICATION MEMBER FUNCTIONS
@@ -100,6 +131,24 @@ namespace CS3358_FA2023_A04_sequence
       size_type size() const;
       bool is_item() const;
       Item current() const;
+      item_range<iterator> items()
+         { return item_range<iterator>(data, data + used); }
+      item_range<const_iterator> items() const
+         { return item_range<const_iterator>(data, data + used); }
+      bool find(const Item& target)
+      {
+         const Item* hit = CS3358_FA2023::seq_find<Item>(data, data + used, target);
+         if (hit == data + used) return false;
+         current_index = size_type(hit - data);
+         return true;
+      }
+      template <class Pred>
+      size_type count_if(Pred pred) const
+         { return CS3358_FA2023::seq_count_if<Item>(data, data + used, pred); }
+      bool min_max(Item& min_value, Item& max_value) const
+         { return CS3358_FA2023::seq_min_max<Item>(data, data + used, min_value, max_value); }
+      Item sum() const
+         { return CS3358_FA2023::seq_sum<Item>(data, data + used); }
 
    private:
       Item data[CAPACITY];
@@ -20,9 +20,11 @@ char get_user_command();
 //       The next character is read (skipping blanks and newline
 //       characters), and this character is returned.
 template <class Item>
-void show_list(Item src);
+void show_list(const Item& src);
 // Pre: (none)
 // Post: The items of src are printed to cout (one per line).
+//       (src is walked with its items() range, so neither a copy of
+//       the sequence nor its cursor is needed.)
 int get_object_num();
 // Pre:  (none)
 // Post: The user is prompted to enter either 1 or 2. The
@@ -292,10 +294,10 @@ char get_user_command()
 }
 
 template <class Item>
-void show_list(Item src)
+void show_list(const Item& src)
 {
-   for ( src.start(); src.is_item(); src.advance() )
-      cout << src.current() << "  ";
+   for (const auto& item : src.items())
+      cout << item << "  ";
 }
 
 int get_object_num()